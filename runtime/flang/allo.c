@@ -20,6 +20,8 @@
 #include "llcrit.h"
 #include "mpalloc.h"
 #include "f90alloc.h"
+#include "allocache.h"
+#include "allomap.h"
 
 MP_SEMAPHORE(static, sem);
 
@@ -90,6 +92,37 @@ struct ALLO_HDR {
 static ALLO_HDR *allo_list;
 static long num_hdrs = NUM_HDRS;
 
+/* Get a block for an allocation.  Large blocks from the default heap may
+ * be mapped with the page policy of allomap.c, and the rest go through the
+ * per-thread cache in allocache.c; either owns the first word of the
+ * block.  For any other block the word is cleared so that allo_free() can
+ * tell them apart.
+ */
+static ALLO_HDR *
+allo_malloc(size_t size, void *(*mallocfn)(size_t))
+{
+  ALLO_HDR *p;
+
+  if (mallocfn == __fort_malloc_without_abort ||
+      mallocfn == __fort_gmalloc_without_abort) {
+    p = (ALLO_HDR *)__fort_map_malloc(size);
+    if (p != NULL)
+      return p;
+    return (ALLO_HDR *)__fort_cache_malloc(size);
+  }
+  p = (ALLO_HDR *)mallocfn(size);
+  if (p != NULL)
+    p->next = NULL;
+  return p;
+}
+
+static void
+allo_free(void *p, void (*freefn)(void *))
+{
+  if (!__fort_map_free(p) && !__fort_cache_free(p))
+    freefn(p);
+}
+
 /* these are used with -ta=tesla:managed and -ta=tesla:pin */
 #define __man_malloc malloc
 #define __man_callocx calloc
@@ -253,7 +286,7 @@ I8(__fort_alloc)(__INT_T nelem, dtype kind, size_t len, __STAT_T *stat,
   size_t ALN_MAXADJ = 4096;
 
 #define ALN_THRESH (ALN_MAXADJ / ALN_UNIT)
-  static int aln_n = 0;
+  static unsigned int aln_n = 0;
   static int env_checked = 0;
   int myaln;
 
@@ -297,17 +330,13 @@ I8(__fort_alloc)(__INT_T nelem, dtype kind, size_t len, __STAT_T *stat,
   if (nelem > 1 || need > 2 * sizeof_hdr)
     slop = (offset && len > (ASZ - 8)) ? len : (ASZ - 8);
   size = (sizeof_hdr + slop + need + ASZ - 1) & ~(ASZ - 1);
-  MP_P(sem);
   if (size > ALN_MINSZ) {
-    myaln = aln_n;
+    /* stagger large blocks over 0..ALN_THRESH units, as a shared
+     * rotating counter so that concurrent ALLOCATEs need no lock */
+    myaln = __sync_fetch_and_add(&aln_n, 1) % (ALN_THRESH + 1);
     size += ALN_UNIT * myaln;
-    if (aln_n < ALN_THRESH)
-      aln_n++;
-    else
-      aln_n = 0;
   }
-  p = (size < need) ? NULL : (ALLO_HDR *)mallocfn(size);
-  MP_V(sem);
+  p = (size < need) ? NULL : allo_malloc(size, mallocfn);
   if (p == NULL) {
     if (pointer)
       *pointer = NULL;
@@ -413,7 +442,7 @@ I8(__alloc04)(__NELEM_T nelem, dtype kind, size_t len,
   size_t ALN_MAXADJ = 4096;
 
 #define ALN_THRESH (ALN_MAXADJ / ALN_UNIT)
-  static int aln_n = 0;
+  static unsigned int aln_n = 0;
   static int env_checked = 0;
   int myaln;
 
@@ -453,14 +482,10 @@ I8(__alloc04)(__NELEM_T nelem, dtype kind, size_t len,
     slop = (offset && len > (ASZ - 8)) ? len : (ASZ - 8);
   size = (sizeof_hdr + slop + need + ASZ - 1) & ~(ASZ - 1);
   if (size > ALN_MINSZ) {
-    myaln = aln_n;
+    myaln = __sync_fetch_and_add(&aln_n, 1) % (ALN_THRESH + 1);
     size += ALN_UNIT * myaln;
-    if (aln_n < ALN_THRESH)
-      aln_n++;
-    else
-      aln_n = 0;
   }
-  p = (size < need) ? NULL : (ALLO_HDR *)mallocfn(size);
+  p = (size < need) ? NULL : allo_malloc(size, mallocfn);
   if (p == NULL) {
     if (pointer)
       *pointer = NULL;
@@ -553,9 +578,7 @@ I8(__fort_kalloc)(__INT8_T nelem, dtype kind, size_t len, __STAT_T *stat,
   if (nelem > 1 || need > 2 * sizeof_hdr)
     slop = (offset && len > (ASZ / 2)) ? len : (ASZ / 2);
   size = (sizeof_hdr + slop + need + ASZ - 1) & ~(ASZ - 1);
-  MP_P(sem);
-  p = (size < need) ? NULL : (ALLO_HDR *)mallocfn(size);
-  MP_V(sem);
+  p = (size < need) ? NULL : allo_malloc(size, mallocfn);
   if (p == NULL) {
     if (pointer)
       *pointer = NULL;
@@ -736,6 +759,7 @@ static SAL savedalloc = {0, -99, (char *)0};
 void
 __f90_allo_term(void)
 {
+  __fort_cache_term();
   if (savedalloc.valid != -99) {
     MP_P_ALLO;
     if (savedalloc.valid == -1) {
@@ -747,7 +771,7 @@ __f90_allo_term(void)
       savedalloc.len = 0;
       memaligned = 0;
       if (!memaligned)
-        __fort_free(XYZZY(area));
+        allo_free(XYZZY(area), __fort_free);
     }
     MP_V_ALLO;
   }
@@ -1529,7 +1553,7 @@ I8(__fort_dealloc)(char *area, __STAT_T *stat, void (*freefn)(void *))
     if (__fort_test & DEBUG_ALLO)
       printf("%d dealloc p %p area %p\n", GET_DIST_LCPU, p, area);
 #endif
-    freefn(XYZZY(area));
+    allo_free(XYZZY(area), freefn);
     if (stat)
       *stat = 0;
     return area;
@@ -1565,7 +1589,7 @@ I8(__fort_dealloc03)(char *area, __STAT_T *stat, void (*freefn)(void *),
     if (__fort_test & DEBUG_ALLO)
       printf("%d dealloc p %p area %p\n", GET_DIST_LCPU, p, area);
 #endif
-    freefn(XYZZY(area));
+    allo_free(XYZZY(area), freefn);
     return area;
   }
   if (stat) {
@@ -1706,6 +1730,10 @@ static size_t AUTO_ALN_MINSZ = 128000;
 static size_t AUTO_ALN_UNIT = 64;
 static size_t AUTO_ALN_MAXADJ = 4096;
 
+/* Automatic arrays are allocated and freed on every call of the routine
+ * declaring them, so like ALLOCATE they reuse blocks from the per-thread
+ * cache rather than going back to malloc each time.
+ */
 static void *
 I8(__auto_alloc)(__NELEM_T nelem, __INT_T sz,
                  void *(*mallocroutine)(size_t))
@@ -1715,7 +1743,7 @@ I8(__auto_alloc)(__NELEM_T nelem, __INT_T sz,
   char msg[80];
 
 #define AUTO_ALN_THRESH (AUTO_ALN_MAXADJ / AUTO_ALN_UNIT)
-  static int aln_n = 0;
+  static unsigned int aln_n = 0;
   int myaln;
 
   if (nelem > 0)
@@ -1726,15 +1754,11 @@ I8(__auto_alloc)(__NELEM_T nelem, __INT_T sz,
   size = ((need + (ASZ - 1)) & ~(ASZ - 1)) + AUTOASZ; /* quad-alignment */
 
   if (size > AUTO_ALN_MINSZ) {
-    myaln = aln_n;
+    myaln = __sync_fetch_and_add(&aln_n, 1) % (AUTO_ALN_THRESH + 1);
     size += AUTO_ALN_UNIT * myaln;
-    if (aln_n < AUTO_ALN_THRESH)
-      aln_n++;
-    else
-      aln_n = 0;
   }
 
-  p = (char *)(mallocroutine)(size);
+  p = (char *)allo_malloc(size, mallocroutine);
   if (p == NULL) {
     MP_P_STDIO;
     sprintf(msg, "ALLOCATE: %lu bytes requested; not enough memory", need);
@@ -1760,7 +1784,7 @@ void *
 ENTF90(AUTO_ALLOCV, auto_allocv)(__NELEM_T nelem, int sz)
 {
   void *p;
-  p = I8(__auto_alloc)(nelem, sz, malloc);
+  p = I8(__auto_alloc)(nelem, sz, __fort_malloc_without_abort);
   return p;
 }
 #endif
@@ -1770,7 +1794,7 @@ ENTF90(AUTO_ALLOC, auto_alloc)(__INT_T *nelem, __INT_T *sz)
 {
   void *p;
 
-  p = I8(__auto_alloc)(*nelem, *sz, malloc);
+  p = I8(__auto_alloc)(*nelem, *sz, __fort_malloc_without_abort);
   return p;
 }
 
@@ -1779,7 +1803,7 @@ ENTF90(AUTO_ALLOC04, auto_alloc04)(__NELEM_T *nelem, __INT_T *sz)
 {
   void *p;
 
-  p = I8(__auto_alloc)(*nelem, *sz, malloc);
+  p = I8(__auto_alloc)(*nelem, *sz, __fort_malloc_without_abort);
   return p;
 }
 
@@ -1789,7 +1813,7 @@ ENTF90(AUTO_CALLOC, auto_calloc)(__INT_T *nelem, __INT_T *sz)
   size_t size;
   void *p;
 
-  p = I8(__auto_alloc)(*nelem, *sz, malloc);
+  p = I8(__auto_alloc)(*nelem, *sz, __fort_malloc_without_abort);
   if (p && *nelem > 0) {
     size = *nelem * *sz;
     memset(p, 0, size);
@@ -1804,7 +1828,7 @@ ENTF90(AUTO_CALLOC04, auto_calloc04)(__NELEM_T *nelem, __INT_T *sz)
   size_t size;
   void *p;
 
-  p = I8(__auto_alloc)(*nelem, *sz, malloc);
+  p = I8(__auto_alloc)(*nelem, *sz, __fort_malloc_without_abort);
   if (p && *nelem > 0) {
     size = *nelem * *sz;
     memset(p, 0, size);
@@ -1814,7 +1838,10 @@ ENTF90(AUTO_CALLOC04, auto_calloc04)(__NELEM_T *nelem, __INT_T *sz)
 }
 
 void
-ENTF90(AUTO_DEALLOC, auto_dealloc)(void *area) { free(XYZZY(area)); }
+ENTF90(AUTO_DEALLOC, auto_dealloc)(void *area)
+{
+  allo_free(XYZZY(area), free);
+}
 
 #if defined(DEBUG)
 void
@@ -0,0 +1,299 @@
+/*
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+ * See https://llvm.org/LICENSE.txt for license information.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+/* clang-format off */
+
+/** \file
+ * \brief Per-thread cache of ALLOCATE blocks
+ *
+ * ALLOCATE/DEALLOCATE of temporaries inside OpenMP loops used to go through
+ * one global semaphore, and blocks above the malloc mmap threshold cost an
+ * mmap/munmap pair (and the page faults after it) every time.  Here each
+ * thread keeps a few recently freed blocks per size class and hands them
+ * out again without taking any lock.  Array temporaries made by the
+ * compiler and automatic arrays both come from here, so a time-step loop
+ * that makes the same temporaries on every iteration stops calling malloc
+ * after the first.
+ *
+ * Sizes above 512 bytes are rounded to one of four classes per power of two.
+ * A block records its class, and the thread that allocated it, in its first
+ * word.  A block freed by a different thread simply goes into that
+ * thread's cache; blocks are plain malloc() blocks, so whichever thread
+ * ends up releasing one can free() it.  The total cached per thread is
+ * bounded by F90_ALLOC_CACHE (bytes, with an optional k/m/g suffix; 0
+ * turns the cache off), and a thread's blocks are released when it exits.
+ *
+ * Setting F90_ALLOC_STATS prints the allocation counters, with the
+ * fraction of cacheable allocations that the cache served, at program end.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "stdioInterf.h"
+#include "fioMacros.h"
+#include "allocache.h"
+
+#include "fort_vars.h"
+
+#define CACHE_MIN_LG 9   /* smallest classes start above 512 bytes */
+#define CACHE_MAX_LG 26  /* largest class holds 128MB */
+#define CACHE_NCLASS ((CACHE_MAX_LG - CACHE_MIN_LG + 1) * 4)
+#define CACHE_DEPTH 4    /* blocks kept per class */
+#define CACHE_DEFAULT (32L * 1024 * 1024)
+
+/* first word of a cached block: magic, owner thread, class */
+#define TAG_MAGIC 0xA11UL
+#define TAG_SHIFT 20
+#define TAG(owner, cls)                                                        \
+  ((TAG_MAGIC << TAG_SHIFT) | (((owner) & 0xfff) << 8) | (cls))
+#define TAG_OK(w) (((w) >> TAG_SHIFT) == TAG_MAGIC)
+#define TAG_OWNER(w) (((w) >> 8) & 0xfff)
+#define TAG_CLASS(w) ((w) & 0xff)
+
+typedef struct {
+  unsigned long allocs;     /* blocks handed out */
+  unsigned long long bytes; /* bytes requested */
+  unsigned long sized;      /* allocations in a cached size class */
+  unsigned long hits;       /* ... served from the cache */
+  unsigned long frees;      /* blocks taken back */
+  unsigned long remote;     /* ... that another thread allocated */
+  unsigned long released;   /* ... passed on to free() */
+} CACHE_STATS;
+
+typedef struct CACHE CACHE;
+struct CACHE {
+  void *blk[CACHE_NCLASS][CACHE_DEPTH];
+  unsigned char cnt[CACHE_NCLASS];
+  size_t bytes; /* bytes held in blk[][] */
+  int id;       /* owner number written into block tags */
+  CACHE_STATS st;
+  CACHE *next;  /* list of live caches, for the counters */
+};
+
+static FIO_TLS CACHE *my_cache;
+static FIO_TLS int my_cache_gone; /* thread is exiting */
+
+static pthread_once_t cache_once = PTHREAD_ONCE_INIT;
+static pthread_key_t cache_key;
+static pthread_mutex_t cache_lock = PTHREAD_MUTEX_INITIALIZER;
+static CACHE *cache_list;      /* under cache_lock */
+static CACHE_STATS cache_done; /* counters of exited threads */
+static int cache_threads;
+static unsigned long cache_locks, cache_contended;
+
+static size_t cache_limit; /* bytes per thread; 0 = no caching */
+static size_t cache_max;   /* largest block worth caching */
+static int cache_stats;
+
+static void
+lock_cache_list(void)
+{
+  if (pthread_mutex_trylock(&cache_lock) != 0) {
+    pthread_mutex_lock(&cache_lock);
+    ++cache_contended;
+  }
+  ++cache_locks;
+}
+
+static void
+add_stats(CACHE_STATS *to, const CACHE_STATS *from)
+{
+  to->allocs += from->allocs;
+  to->bytes += from->bytes;
+  to->sized += from->sized;
+  to->hits += from->hits;
+  to->frees += from->frees;
+  to->remote += from->remote;
+  to->released += from->released;
+}
+
+/* thread exit: give the blocks back and keep the counters */
+static void
+cache_exit(void *arg)
+{
+  CACHE *c = (CACHE *)arg;
+  CACHE **pc;
+  int i, j;
+
+  my_cache = NULL;
+  my_cache_gone = 1;
+  for (i = 0; i < CACHE_NCLASS; ++i)
+    for (j = 0; j < c->cnt[i]; ++j)
+      free(c->blk[i][j]);
+  lock_cache_list();
+  add_stats(&cache_done, &c->st);
+  for (pc = &cache_list; *pc; pc = &(*pc)->next) {
+    if (*pc == c) {
+      *pc = c->next;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&cache_lock);
+  free(c);
+}
+
+static void
+cache_init(void)
+{
+  char *p, *q;
+  long n;
+
+  cache_limit = CACHE_DEFAULT;
+  p = getenv("F90_ALLOC_CACHE");
+  if (p != NULL) {
+    n = strtol(p, &q, 0);
+    if ((*q == 'k') || (*q == 'K'))
+      n *= 1024;
+    else if ((*q == 'm') || (*q == 'M'))
+      n *= 1024 * 1024;
+    else if ((*q == 'g') || (*q == 'G'))
+      n *= 1024 * 1024 * 1024;
+    cache_limit = n > 0 ? n : 0;
+  }
+  cache_max = (size_t)1 << (CACHE_MAX_LG + 1);
+  if (cache_max > cache_limit / 2)
+    cache_max = cache_limit / 2;
+  cache_stats = getenv("F90_ALLOC_STATS") != NULL;
+  if (pthread_key_create(&cache_key, cache_exit) != 0)
+    cache_limit = 0;
+}
+
+static CACHE *
+get_cache(void)
+{
+  CACHE *c;
+
+  if (my_cache != NULL)
+    return my_cache;
+  if (my_cache_gone)
+    return NULL;
+  pthread_once(&cache_once, cache_init);
+  if (cache_limit == 0 && !cache_stats)
+    return NULL;
+  c = (CACHE *)calloc(1, sizeof(CACHE));
+  if (c == NULL)
+    return NULL;
+  lock_cache_list();
+  c->id = cache_threads++;
+  c->next = cache_list;
+  cache_list = c;
+  pthread_mutex_unlock(&cache_lock);
+  pthread_setspecific(cache_key, c);
+  my_cache = c;
+  return c;
+}
+
+/* size class of \p size, with the block size for the class in *csize;
+ * -1 if the size is not cached */
+static int
+size_class(size_t size, size_t *csize)
+{
+  int lg;
+  size_t step, r;
+
+  if (size <= ((size_t)1 << CACHE_MIN_LG) || size > cache_max)
+    return -1;
+  lg = 63 - __builtin_clzll((unsigned long long)(size - 1));
+  step = (size_t)1 << (lg - 2);
+  r = (size + step - 1) & ~(step - 1);
+  *csize = r;
+  return (lg - CACHE_MIN_LG) * 4 + (int)(r >> (lg - 2)) - 5;
+}
+
+void *
+__fort_cache_malloc(size_t size)
+{
+  CACHE *c = get_cache();
+  size_t csize;
+  size_t *p;
+  int cls;
+
+  if (c != NULL) {
+    c->st.allocs++;
+    c->st.bytes += size;
+  }
+  if (c == NULL || (cls = size_class(size, &csize)) < 0) {
+    p = (size_t *)__fort_malloc_without_abort(size);
+    if (p != NULL)
+      *p = 0;
+    return p;
+  }
+  c->st.sized++;
+  if (c->cnt[cls]) {
+    p = (size_t *)c->blk[cls][--c->cnt[cls]];
+    c->bytes -= csize;
+    c->st.hits++;
+    if (__fort_zmem)
+      memset(p + 1, 0, csize - sizeof(size_t));
+  } else {
+    p = (size_t *)__fort_malloc_without_abort(csize);
+    if (p == NULL)
+      return NULL;
+  }
+  *p = TAG(c->id, cls);
+  return p;
+}
+
+int
+__fort_cache_free(void *blk)
+{
+  size_t *p = (size_t *)blk;
+  size_t w, csize;
+  CACHE *c;
+  int cls, lg;
+
+  if (p == NULL || !TAG_OK(*p)) {
+    if (my_cache != NULL)
+      my_cache->st.frees++;
+    return 0;
+  }
+  w = *p;
+  cls = TAG_CLASS(w);
+  c = get_cache();
+  if (c == NULL) {
+    free(p);
+    return 1;
+  }
+  c->st.frees++;
+  if ((int)TAG_OWNER(w) != (c->id & 0xfff))
+    c->st.remote++;
+  lg = cls / 4 + CACHE_MIN_LG;
+  csize = (size_t)(cls % 4 + 5) << (lg - 2);
+  if (c->cnt[cls] < CACHE_DEPTH && c->bytes + csize <= cache_limit) {
+    c->blk[cls][c->cnt[cls]++] = p;
+    c->bytes += csize;
+  } else {
+    c->st.released++;
+    free(p);
+  }
+  return 1;
+}
+
+void
+__fort_cache_term(void)
+{
+  CACHE_STATS st;
+  CACHE *c;
+
+  if (!cache_stats)
+    return;
+  pthread_mutex_lock(&cache_lock);
+  st = cache_done;
+  for (c = cache_list; c; c = c->next)
+    add_stats(&st, &c->st);
+  fprintf(__io_stderr(),
+          "F90_ALLOC_STATS: %d threads, %lu allocations, %llu bytes, "
+          "%lu cache hits of %lu cacheable (%.1f%%), "
+          "%lu frees (%lu cross-thread, %lu released), "
+          "%lu lock acquisitions (%lu contended)\n",
+          cache_threads, st.allocs, st.bytes, st.hits, st.sized,
+          st.sized ? 100.0 * st.hits / st.sized : 0.0, st.frees, st.remote,
+          st.released, cache_locks, cache_contended);
+  cache_stats = 0; /* report once */
+  pthread_mutex_unlock(&cache_lock);
+}
@@ -0,0 +1,37 @@
+/*
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+ * See https://llvm.org/LICENSE.txt for license information.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+#ifndef _ALLOCACHE_H
+#define _ALLOCACHE_H
+
+/** \file
+ * Per-thread cache of ALLOCATE blocks (from allocache.c)
+ */
+
+#include <stddef.h>
+
+/** \brief
+ * Return a block of at least \p size bytes for ALLOCATE, taking it from the
+ * calling thread's cache when one of the right size class is there.  The
+ * first pointer-sized word of the block is owned by the cache; callers
+ * must not use it.  Returns NULL when out of memory.
+ */
+void *__fort_cache_malloc(size_t size);
+
+/** \brief
+ * Take back a block from __fort_cache_malloc(), keeping it in the calling
+ * thread's cache if there is room.  Returns 0, without touching the block,
+ * if \p p did not come from __fort_cache_malloc(); the caller frees it.
+ */
+int __fort_cache_free(void *p);
+
+/** \brief
+ * Print the allocation counters to stderr if F90_ALLOC_STATS is set.
+ */
+void __fort_cache_term(void);
+
+#endif
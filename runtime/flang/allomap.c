@@ -0,0 +1,204 @@
+/*
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+ * See https://llvm.org/LICENSE.txt for license information.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+/* clang-format off */
+
+/** \file
+ * \brief Page placement policy for large ALLOCATE blocks
+ *
+ * Large arrays from malloc() are faulted in 4K pages, each on the NUMA node
+ * of the thread that first touches it.  When F90_ALLOC_LARGE is set to a
+ * size (bytes, with an optional k/m/g suffix), ALLOCATE blocks of at least
+ * that size are mapped directly instead, aligned to 2MB, and
+ *
+ * + advised with MADV_HUGEPAGE so that transparent huge pages back them,
+ *   unless F90_ALLOC_HUGE is "no" or 0;
+ *
+ * + if F90_ALLOC_NUMA is "interleave", spread page by page over the nodes
+ *   the process may use, or if it is "local", placed on the node of the
+ *   thread that first touches each page whatever policy the process was
+ *   started with.  Otherwise the process policy applies.
+ *
+ * Only system calls are used; libnuma is not needed.  A policy that the
+ * kernel refuses is skipped and the block is used anyway.  With
+ * F90_ALLOC_STATS set, a line for each mapped block says what was applied.
+ *
+ * The first word of a mapped block holds a tag with the length of the
+ * mapping, so that __fort_map_free() can recognize and unmap it.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#if defined(TARGET_LINUX)
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+#include "stdioInterf.h"
+#include "allomap.h"
+
+#if defined(TARGET_LINUX) && defined(MADV_HUGEPAGE)
+
+#define MAP_ALIGN ((size_t)2 << 20) /* x86-64 and aarch64 huge page */
+
+/* first word of a mapped block: magic and the mapping length in pages */
+#define MAP_MAGIC 0xB16UL
+#define MAP_SHIFT 52
+#define MAP_TAG(len) ((MAP_MAGIC << MAP_SHIFT) | ((len) >> 12))
+#define MAP_TAG_OK(w) (((w) >> MAP_SHIFT) == MAP_MAGIC)
+#define MAP_TAG_LEN(w) (((w) & (((size_t)1 << MAP_SHIFT) - 1)) << 12)
+
+/* from <numaif.h> */
+#define MPOL_INTERLEAVE 3
+#define MPOL_LOCAL 4
+#define MPOL_F_MEMS_ALLOWED (1 << 2)
+#define NODE_BITS 1024
+
+enum { NUMA_DEFAULT, NUMA_INTERLEAVE, NUMA_LOCAL };
+
+static pthread_once_t map_once = PTHREAD_ONCE_INIT;
+static size_t map_min;  /* smallest block mapped; 0 = never */
+static int map_huge;    /* advise MADV_HUGEPAGE */
+static int map_numa;    /* NUMA_... */
+static int map_report;
+static unsigned long map_nodes[NODE_BITS / (8 * sizeof(unsigned long))];
+static int map_nnodes;  /* nodes in map_nodes */
+
+static void
+map_setup(void)
+{
+  char *p, *q;
+  long n;
+  int i;
+
+  p = getenv("F90_ALLOC_LARGE");
+  if (p != NULL) {
+    n = strtol(p, &q, 0);
+    if ((*q == 'k') || (*q == 'K'))
+      n *= 1024;
+    else if ((*q == 'm') || (*q == 'M'))
+      n *= 1024 * 1024;
+    else if ((*q == 'g') || (*q == 'G'))
+      n *= 1024 * 1024 * 1024;
+    map_min = n > 0 ? n : 0;
+  }
+  p = getenv("F90_ALLOC_HUGE");
+  map_huge = p == NULL || !(*p == 'n' || *p == 'N' || strcmp(p, "0") == 0);
+  p = getenv("F90_ALLOC_NUMA");
+  if (p != NULL && strcmp(p, "interleave") == 0)
+    map_numa = NUMA_INTERLEAVE;
+  else if (p != NULL && strcmp(p, "local") == 0)
+    map_numa = NUMA_LOCAL;
+  if (map_numa == NUMA_INTERLEAVE) {
+#if defined(SYS_get_mempolicy)
+    if (syscall(SYS_get_mempolicy, NULL, map_nodes, NODE_BITS, NULL,
+                MPOL_F_MEMS_ALLOWED) == 0) {
+      for (i = 0; i < NODE_BITS; ++i)
+        if (map_nodes[i / (8 * sizeof(unsigned long))] >>
+                (i % (8 * sizeof(unsigned long))) & 1)
+          ++map_nnodes;
+    }
+#endif
+  }
+  map_report = getenv("F90_ALLOC_STATS") != NULL;
+}
+
+/* set the NUMA policy of a fresh mapping; returns 0 if the kernel refused */
+static int
+map_place(void *p, size_t len)
+{
+#if defined(SYS_mbind)
+  switch (map_numa) {
+  case NUMA_INTERLEAVE:
+    return map_nnodes > 0 && syscall(SYS_mbind, p, len, MPOL_INTERLEAVE,
+                                     map_nodes, NODE_BITS + 1, 0) == 0;
+  case NUMA_LOCAL:
+    return syscall(SYS_mbind, p, len, MPOL_LOCAL, NULL, 0, 0) == 0;
+  }
+  return 1;
+#else
+  return map_numa == NUMA_DEFAULT;
+#endif
+}
+
+void *
+__fort_map_malloc(size_t size)
+{
+  char *p, *q;
+  size_t len, head;
+  int huge, numa;
+
+  pthread_once(&map_once, map_setup);
+  if (map_min == 0 || size < map_min)
+    return NULL;
+  len = (size + MAP_ALIGN - 1) & ~(MAP_ALIGN - 1);
+  if (len < size)
+    return NULL;
+  /* map a huge page more than needed and trim it to a 2MB boundary */
+  p = (char *)mmap(NULL, len + MAP_ALIGN, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == (char *)MAP_FAILED)
+    return NULL;
+  q = (char *)(((size_t)p + MAP_ALIGN - 1) & ~(MAP_ALIGN - 1));
+  head = q - p;
+  if (head)
+    munmap(p, head);
+  munmap(q + len, MAP_ALIGN - head);
+
+  huge = map_huge && madvise(q, len, MADV_HUGEPAGE) == 0;
+  numa = map_place(q, len);
+  if (map_report) {
+    char where[40];
+    if (map_numa == NUMA_DEFAULT)
+      strcpy(where, "");
+    else if (!numa)
+      strcpy(where, ", NUMA policy refused");
+    else if (map_numa == NUMA_LOCAL)
+      strcpy(where, ", first-touch node");
+    else
+      sprintf(where, ", interleaved over %d node%s", map_nnodes,
+              map_nnodes > 1 ? "s" : "");
+    fprintf(__io_stderr(), "F90_ALLOC_STATS: %lu bytes mapped at %p, %s%s\n",
+            (unsigned long)size, q,
+            huge ? "huge pages" : map_huge ? "huge pages refused"
+                                           : "small pages",
+            where);
+  }
+  *(size_t *)q = MAP_TAG(len);
+  return q;
+}
+
+int
+__fort_map_free(void *p)
+{
+  size_t w;
+
+  if (p == NULL)
+    return 0;
+  w = *(size_t *)p;
+  if (!MAP_TAG_OK(w))
+    return 0;
+  munmap(p, MAP_TAG_LEN(w));
+  return 1;
+}
+
+#else
+
+void *
+__fort_map_malloc(size_t size)
+{
+  return NULL;
+}
+
+int
+__fort_map_free(void *p)
+{
+  return 0;
+}
+
+#endif
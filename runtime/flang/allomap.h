@@ -0,0 +1,32 @@
+/*
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+ * See https://llvm.org/LICENSE.txt for license information.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+#ifndef _ALLOMAP_H
+#define _ALLOMAP_H
+
+/** \file
+ * Page placement policy for large ALLOCATE blocks (from allomap.c)
+ */
+
+#include <stddef.h>
+
+/** \brief
+ * Map a block of at least \p size bytes with the huge page and NUMA policy
+ * chosen by the environment.  Returns NULL, and the caller allocates the
+ * block as usual, if \p size is below the F90_ALLOC_LARGE threshold or the
+ * mapping fails.  The first pointer-sized word of the block is owned by
+ * this module; callers must not use it.
+ */
+void *__fort_map_malloc(size_t size);
+
+/** \brief
+ * Unmap a block from __fort_map_malloc().  Returns 0, without touching the
+ * block, if \p p did not come from __fort_map_malloc().
+ */
+int __fort_map_free(void *p);
+
+#endif
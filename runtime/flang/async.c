@@ -15,6 +15,18 @@
  * Fio_asy_start - for vectored i/o, start reads or writes
  * Fio_asy_disable - disable async i/o, enable stdio
  * Fio_asy_close - called from close
+ *
+ * On POSIX systems each file has a queue of up to F90_ASYNC_DEPTH
+ * (default 64) transfers in flight.  A transfer is started as soon as it
+ * is queued; when the queue is full the oldest transfer is waited for.
+ * On Linux the transfers go through an io_uring when the kernel allows
+ * it (set F90_ASYNC_URING=0 to disable), otherwise through POSIX aio.
+ *
+ * Writes of at most ASY_COPY_SIZE bytes are copied when they are queued,
+ * so the caller may reuse its buffer at once; the record length words
+ * and the small record buffer of unf.c go through here.  Larger writes
+ * and all reads use the caller's memory until they complete, as the
+ * Fortran rules for pending asynchronous transfers allow.
  */
 
 #if !defined(TARGET_WIN_X8664)
@@ -24,6 +36,17 @@
 #include <string.h>
 #include <aio.h>
 #include <signal.h>
+#if defined(TARGET_LINUX) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define ASY_URING
+#endif
+#endif
+#endif
 #else
 #include <windows.h>
 #include <errno.h>
@@ -32,6 +55,7 @@
 #include "stdioInterf.h"
 #include "async.h"
 
+#if defined(TARGET_WIN_X8664)
 
 #define FIO_MAX_ASYNC_TRANSACTIONS 16
 
@@ -39,15 +63,14 @@
 
 struct asy_transaction_data {
   long len;
-  seekoffx_t off;
 };
 
-#if defined(TARGET_WIN_X8664)
 struct asy {
   FILE *fp;
   int fd;
   HANDLE handle;
   int flags;
+  seekoffx_t off; /* file offset of the next transfer */
   int outstanding_transactions;
   struct asy_transaction_data atd[FIO_MAX_ASYNC_TRANSACTIONS];
   OVERLAPPED overlap[FIO_MAX_ASYNC_TRANSACTIONS];
@@ -63,13 +86,58 @@ union Converter {
 
 #else
 
+#define ASY_DEFAULT_DEPTH 64
+#define ASY_MAX_DEPTH 4096
+#define ASY_COPY_SIZE 16384
+
+/* one transfer */
+
+struct asy_slot {
+  char *adr;      /* data, either the caller's or copy */
+  long len;
+  seekoffx_t off;
+  int write;
+  char *copy;     /* ASY_COPY_SIZE bytes for small writes, or NULL */
+#if defined(ASY_URING)
+  int done;       /* completion seen */
+  long res;       /* result of the transfer */
+  struct iovec iov;
+#endif
+  struct aiocb aiocb;
+};
+
+#if defined(ASY_URING)
+struct asy_ring {
+  int fd;
+  unsigned *sq_tail;
+  unsigned *sq_mask;
+  unsigned *cq_head;
+  unsigned *cq_tail;
+  unsigned *cq_mask;
+  struct io_uring_sqe *sqes;
+  struct io_uring_cqe *cqes;
+  void *sq_map;
+  void *cq_map;
+  size_t sq_size;
+  size_t cq_size;
+  size_t sqes_size;
+};
+#endif
+
+/* one struct per file */
+
 struct asy {
   FILE *fp;
   int fd;
   int flags;
+  seekoffx_t off; /* file offset of the next transfer */
+  int depth;      /* number of slots */
+  int head;       /* oldest transfer in flight */
   int outstanding_transactions;
-  struct asy_transaction_data atd[FIO_MAX_ASYNC_TRANSACTIONS];
-  struct aiocb aiocb[FIO_MAX_ASYNC_TRANSACTIONS];
+  struct asy_slot *slot;
+#if defined(ASY_URING)
+  struct asy_ring *ring; /* NULL if using aio */
+#endif
 };
 #endif
 
@@ -111,54 +179,340 @@ asy_wait(struct asy *asy)
       return (-1);
     }
   }
-  asy->atd[0].off = asy->atd[asy->outstanding_transactions].off;
   asy->outstanding_transactions = 0;
   return (0);
 }
 #else
+
+static int asy_depth = -1;
+#if defined(ASY_URING)
+static int asy_uring = -1;
+#endif
+
 static int
-asy_wait(struct asy *asy)
+get_depth(void)
+{
+  char *p;
+  int n;
+
+  if (asy_depth < 0) {
+    p = getenv("F90_ASYNC_DEPTH");
+    n = p ? atoi(p) : ASY_DEFAULT_DEPTH;
+    if (n < 1)
+      n = 1;
+    if (n > ASY_MAX_DEPTH)
+      n = ASY_MAX_DEPTH;
+    asy_depth = n;
+  }
+  return asy_depth;
+}
+
+#if defined(ASY_URING)
+static void
+ring_close(struct asy_ring *r)
+{
+  if (r->sqes)
+    munmap(r->sqes, r->sqes_size);
+  if (r->cq_map && r->cq_map != r->sq_map)
+    munmap(r->cq_map, r->cq_size);
+  if (r->sq_map)
+    munmap(r->sq_map, r->sq_size);
+  close(r->fd);
+  free(r);
+}
+
+/* Set up an io_uring with room for \p entries transfers; NULL if the
+ * kernel does not have io_uring or does not let us use it.
+ */
+static struct asy_ring *
+ring_open(int entries)
 {
+  struct io_uring_params p;
+  struct asy_ring *r;
+  unsigned *array;
+  unsigned i;
+  char *sq, *cq;
+
+  if (asy_uring < 0) {
+    char *e = getenv("F90_ASYNC_URING");
+    asy_uring = e ? atoi(e) != 0 : 1;
+  }
+  if (!asy_uring)
+    return NULL;
+  r = (struct asy_ring *)calloc(1, sizeof(struct asy_ring));
+  if (r == NULL)
+    return NULL;
+  memset(&p, 0, sizeof(p));
+  r->fd = syscall(__NR_io_uring_setup, entries, &p);
+  if (r->fd < 0) {
+    free(r);
+    return NULL;
+  }
+  r->sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+  r->cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+  if (p.features & IORING_FEAT_SINGLE_MMAP) {
+    if (r->cq_size > r->sq_size)
+      r->sq_size = r->cq_size;
+    r->cq_size = r->sq_size;
+  }
+  sq = mmap(NULL, r->sq_size, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQ_RING);
+  if (sq == MAP_FAILED) {
+    ring_close(r);
+    return NULL;
+  }
+  r->sq_map = sq;
+  if (p.features & IORING_FEAT_SINGLE_MMAP) {
+    cq = sq;
+  } else {
+    cq = mmap(NULL, r->cq_size, PROT_READ | PROT_WRITE,
+              MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_CQ_RING);
+    if (cq == MAP_FAILED) {
+      ring_close(r);
+      return NULL;
+    }
+  }
+  r->cq_map = cq;
+  r->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+  r->sqes = mmap(NULL, r->sqes_size, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQES);
+  if (r->sqes == MAP_FAILED) {
+    r->sqes = NULL;
+    ring_close(r);
+    return NULL;
+  }
+  r->sq_tail = (unsigned *)(sq + p.sq_off.tail);
+  r->sq_mask = (unsigned *)(sq + p.sq_off.ring_mask);
+  r->cq_head = (unsigned *)(cq + p.cq_off.head);
+  r->cq_tail = (unsigned *)(cq + p.cq_off.tail);
+  r->cq_mask = (unsigned *)(cq + p.cq_off.ring_mask);
+  r->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+  /* submission queue entry i always lives in sqes[i] */
+  array = (unsigned *)(sq + p.sq_off.array);
+  for (i = 0; i < p.sq_entries; ++i)
+    array[i] = i;
+  return r;
+}
+
+static int
+ring_start(struct asy *asy, int tn)
+{
+  struct asy_ring *r = asy->ring;
+  struct asy_slot *s = &asy->slot[tn];
+  struct io_uring_sqe *sqe;
+  unsigned tail;
+  long n;
+
+  s->iov.iov_base = s->adr;
+  s->iov.iov_len = s->len;
+  s->done = 0;
+  tail = *r->sq_tail;
+  sqe = &r->sqes[tail & *r->sq_mask];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = s->write ? IORING_OP_WRITEV : IORING_OP_READV;
+  sqe->fd = asy->fd;
+  sqe->off = s->off;
+  sqe->addr = (unsigned long)&s->iov;
+  sqe->len = 1;
+  sqe->user_data = tn;
+  __atomic_store_n(r->sq_tail, tail + 1, __ATOMIC_RELEASE);
+  do {
+    n = syscall(__NR_io_uring_enter, r->fd, 1, 0, 0, NULL, 0);
+  } while (n == -1 && __io_errno() == EINTR);
+  if (n != 1) {
+    /* not taken by the kernel; withdraw it */
+    __atomic_store_n(r->sq_tail, tail, __ATOMIC_RELEASE);
+    if (n == 0)
+      __io_set_errno(EAGAIN);
+    return (-1);
+  }
+  return (0);
+}
+
+/* Collect completions until the transfer in slot \p tn is done. */
+static long
+ring_reap(struct asy *asy, int tn)
+{
+  struct asy_ring *r = asy->ring;
+  struct io_uring_cqe *cqe;
+  unsigned head;
+  long n;
+
+  while (!asy->slot[tn].done) {
+    head = *r->cq_head;
+    if (head == __atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE)) {
+      n = syscall(__NR_io_uring_enter, r->fd, 0, 1, IORING_ENTER_GETEVENTS,
+                  NULL, 0);
+      if (n == -1 && __io_errno() != EINTR)
+        return -1;
+      continue;
+    }
+    cqe = &r->cqes[head & *r->cq_mask];
+    asy->slot[cqe->user_data].res = cqe->res;
+    asy->slot[cqe->user_data].done = 1;
+    __atomic_store_n(r->cq_head, head + 1, __ATOMIC_RELEASE);
+  }
+  if (asy->slot[tn].res < 0) {
+    __io_set_errno(-asy->slot[tn].res);
+    return -1;
+  }
+  return asy->slot[tn].res;
+}
+#endif
+
+static int
+aio_start(struct asy *asy, int tn)
+{
+  struct aiocb *cb = &asy->slot[tn].aiocb;
+
+  memset(cb, 0, sizeof(struct aiocb));
+  cb->aio_fildes = asy->fd;
+  cb->aio_reqprio = 0;
+  cb->aio_buf = asy->slot[tn].adr;
+  cb->aio_nbytes = asy->slot[tn].len;
+  cb->aio_offset = asy->slot[tn].off;
+  if (asy->slot[tn].write)
+    return aio_write(cb);
+  return aio_read(cb);
+}
+
+static long
+aio_reap(struct asy *asy, int tn)
+{
+  struct aiocb *p[1];
   long len;
   int s;
+
+  p[0] = &asy->slot[tn].aiocb;
+  do {
+    s = aio_suspend((const struct aiocb * const *)p, 1,
+                    (const struct timespec *)0);
+  } while ((s == -1) && (__io_errno() == EINTR));
+  if (s == -1) {
+    return (-1);
+  }
+  len = aio_return(p[0]);
+  if (len == -1) {
+    s = aio_error(p[0]);
+    __io_set_errno(s);
+  }
+  return len;
+}
+
+/* Wait for the oldest transfer and check how it went.  A transfer cut
+ * short by the system (e.g. writes of 2GB or more) is finished here.
+ */
+static int
+asy_retire(struct asy *asy)
+{
+  struct asy_slot *s;
+  long len, n;
   int tn;
-  int offset;
-  int n;
 
-  struct aiocb *p[1];
+  tn = asy->head;
+  s = &asy->slot[tn];
+  asy->head = (tn + 1) % asy->depth;
+  asy->outstanding_transactions -= 1;
+#if defined(ASY_URING)
+  if (asy->ring)
+    len = ring_reap(asy, tn);
+  else
+#endif
+    len = aio_reap(asy, tn);
+  if (slime)
+    printf("---Fio_asy_wait %d\n", asy->fd);
+  if (len == -1)
+    return (-1);
+  while (len < s->len) {
+    if (s->write)
+      n = pwrite(asy->fd, s->adr + len, s->len - len, s->off + len);
+    else
+      n = pread(asy->fd, s->adr + len, s->len - len, s->off + len);
+    if (n == -1 && __io_errno() == EINTR)
+      continue;
+    if (n == -1)
+      return (-1);
+    if (n == 0)
+      break;
+    len += n;
+  }
+  if (len != s->len) {          /* incomplete transfer? */
+    __io_set_errno(FIO_EEOF); /* ..yes */
+    return (-1);
+  }
+  return (0);
+}
+
+static int
+asy_wait(struct asy *asy)
+{
+  int err = 0;
 
   if (!(asy->flags & ASY_IOACT)) { /* i/o active? */
     return (0);
   }
   asy->flags &= ~ASY_IOACT;
 
-  for (tn = 0; tn < asy->outstanding_transactions; tn++) {
-    p[0] = &(asy->aiocb[tn]);
-    do {
-      s = aio_suspend((const struct aiocb * const *)p, 1,
-                      (const struct timespec *)0);
-    } while ((s == -1) && (__io_errno() == EINTR));
-    if (s == -1) {
-      return (-1);
-    }
-    if (slime)
-      printf("---Fio_asy_wait %d\n", asy->fd);
-    len = aio_return(&(asy->aiocb[tn]));
-    if (len == -1) {
-      s = aio_error(&(asy->aiocb[tn]));
-      __io_set_errno(s);
+  /* everything has to finish before the buffers may be touched, so keep
+   * going after an error and report the first one */
+  while (asy->outstanding_transactions > 0) {
+    if (asy_retire(asy) == -1 && err == 0)
+      err = __io_errno();
+  }
+  if (err) {
+    __io_set_errno(err);
+    return (-1);
+  }
+  return (0);
+}
+
+/* queue a transfer and start it */
+
+static int
+asy_start(struct asy *asy, void *adr, long len, int write)
+{
+  struct asy_slot *s;
+  int tn;
+  int n;
+
+  if (asy->outstanding_transactions == asy->depth) { /* queue full? */
+    if (asy_retire(asy) == -1) {
+      n = __io_errno();
+      (void)asy_wait(asy);
+      __io_set_errno(n);
       return (-1);
     }
-    if (asy->atd[tn].len != len) { /* incomplete transfer? */
-      __io_set_errno(FIO_EEOF);  /* ..yes */
-      return (-1);
+  }
+  tn = (asy->head + asy->outstanding_transactions) % asy->depth;
+  s = &asy->slot[tn];
+  s->adr = adr;
+  if (write && len <= ASY_COPY_SIZE) {
+    if (s->copy == NULL)
+      s->copy = (char *)malloc(ASY_COPY_SIZE);
+    if (s->copy != NULL) {
+      memcpy(s->copy, adr, len);
+      s->adr = s->copy;
     }
   }
-  /* Reset the number of outstanding transactions back to 0,
-   * and set the offset to the end of the last transaction list
-   */
-  asy->atd[0].off = asy->atd[asy->outstanding_transactions].off;
-  asy->outstanding_transactions = 0;
+  s->len = len;
+  s->off = asy->off;
+  s->write = write;
+#if defined(ASY_URING)
+  if (asy->ring)
+    n = ring_start(asy, tn);
+  else
+#endif
+    n = aio_start(asy, tn);
+  if (n == -1) {
+    return (-1);
+  }
+  asy->off += len;
+  asy->outstanding_transactions += 1;
+  asy->flags |= ASY_IOACT; /* i/o now active */
+  if (write && len <= ASY_COPY_SIZE && s->adr == adr) {
+    /* no memory for a copy; the caller will reuse its buffer */
+    return asy_wait(asy);
+  }
   return (0);
 }
 #endif
@@ -170,9 +524,9 @@ Fio_asy_fseek(struct asy *asy, long offset, int whence)
     printf("--Fio_asy_seek %d %ld\n", asy->fd, offset);
 
   if (whence == SEEK_CUR) {
-    asy->atd[asy->outstanding_transactions].off += offset;
+    asy->off += offset;
   } else {
-    asy->atd[asy->outstanding_transactions].off = offset;
+    asy->off = offset;
   }
   return (0);
 }
@@ -186,18 +540,19 @@ Fio_asy_enable(struct asy *asy)
 
   if (slime)
     printf("--Fio_asy_enable %d\n", asy->fd);
+#if defined(TARGET_WIN_X8664)
   if (asy->flags & ASY_IOACT) { /* i/o active? */
     if (asy_wait(asy) == -1) {
       return (-1);
     }
   }
+#endif
   if (asy->flags & ASY_FDACT) { /* fd already active? */
     return (0);
   }
 
-  asy->atd[0].off = __io_ftellx(asy->fp);
-  asy->outstanding_transactions = 0;
-  if (asy->atd[0].off == -1) {
+  asy->off = __io_ftellx(asy->fp);
+  if (asy->off == -1) {
     return (-1);
   }
   n = __io_fflush(asy->fp);
@@ -214,7 +569,6 @@ int
 Fio_asy_disable(struct asy *asy)
 {
   int n;
-  int offset;
 
   if (slime)
     printf("--Fio_asy_disable %d\n", asy->fd);
@@ -227,8 +581,7 @@ Fio_asy_disable(struct asy *asy)
     return (0);
   }
   /* Seek to the end of the the list. */
-  offset = asy->atd[asy->outstanding_transactions].off;
-  n = __io_fseekx(asy->fp, offset, 0);
+  n = __io_fseekx(asy->fp, asy->off, 0);
   if (n == -1) {
     return (-1);
   }
@@ -242,7 +595,6 @@ int
 Fio_asy_open(FILE *fp, struct asy **pasy)
 {
   struct asy *asy;
-  char *p;
 #if defined(TARGET_WIN_X8664)
   HANDLE temp_handle;
 #endif
@@ -262,6 +614,17 @@ Fio_asy_open(FILE *fp, struct asy **pasy)
     __io_set_errno(EBADF);
     return (-1);
   }
+#else
+  asy->depth = get_depth();
+  asy->slot = (struct asy_slot *)calloc(sizeof(struct asy_slot), asy->depth);
+  if (asy->slot == (struct asy_slot *)0) {
+    free(asy);
+    __io_set_errno(ENOMEM);
+    return (-1);
+  }
+#if defined(ASY_URING)
+  asy->ring = ring_open(asy->depth);
+#endif
 #endif
   if (slime)
     printf("--Fio_asy_open %d\n", asy->fd);
@@ -274,10 +637,9 @@ Fio_asy_open(FILE *fp, struct asy **pasy)
 int
 Fio_asy_read(struct asy *asy, void *adr, long len)
 {
+#if defined(TARGET_WIN_X8664)
   int n;
   int tn;
-
-#if defined(TARGET_WIN_X8664)
   union Converter converter;
 #endif
   if (slime)
@@ -294,7 +656,7 @@ Fio_asy_read(struct asy *asy, void *adr, long len)
   asy->overlap[tn].InternalHigh = 0;
   asy->overlap[tn].Pointer = 0;
   /* Load asy->off into OffsetHigh/Offset */
-  converter.offset = asy->atd[tn].off;
+  converter.offset = asy->off;
   asy->overlap[tn].Offset = converter.wOffset;
   asy->overlap[tn].OffsetHigh = converter.wOffsetHigh;
   asy->overlap[tn].hEvent = 0;
@@ -302,25 +664,18 @@ Fio_asy_read(struct asy *asy, void *adr, long len)
       GetLastError() != ERROR_IO_PENDING) {
     n = -1;
   }
-#else
-  tn = asy->outstanding_transactions;
-  asy->aiocb[tn].aio_fildes = asy->fd;
-  asy->aiocb[tn].aio_reqprio = 0;
-  asy->aiocb[tn].aio_buf = adr;
-  asy->aiocb[tn].aio_nbytes = len;
-  memset(&(asy->aiocb[tn].aio_sigevent), 0, sizeof(struct sigevent));
-  asy->aiocb[tn].aio_offset = asy->atd[tn].off;
-  n = aio_read(&(asy->aiocb[tn]));
-#endif
 
   if (n == -1) {
     return (-1);
   }
   asy->atd[tn].len = len;
-  asy->atd[tn + 1].off = asy->atd[tn].off + len;
+  asy->off += len;
   asy->flags |= ASY_IOACT; /* i/o now active */
   asy->outstanding_transactions += 1;
   return (0);
+#else
+  return asy_start(asy, adr, len, 0);
+#endif
 }
 
 /* start an asynch write */
@@ -328,9 +683,9 @@ Fio_asy_read(struct asy *asy, void *adr, long len)
 int
 Fio_asy_write(struct asy *asy, void *adr, long len)
 {
+#if defined(TARGET_WIN_X8664)
   int n;
   int tn;
-#if defined(TARGET_WIN_X8664)
   union Converter converter;
 #endif
 
@@ -348,7 +703,7 @@ Fio_asy_write(struct asy *asy, void *adr, long len)
   asy->overlap[tn].InternalHigh = 0;
   asy->overlap[tn].Pointer = 0;
   /* Load asy->off into OffsetHigh/Offset. */
-  converter.offset = asy->atd[0].off;
+  converter.offset = asy->off;
   asy->overlap[tn].Offset = converter.wOffset;
   asy->overlap[tn].OffsetHigh = converter.wOffsetHigh;
   asy->overlap[tn].hEvent = 0;
@@ -356,25 +711,18 @@ Fio_asy_write(struct asy *asy, void *adr, long len)
       GetLastError() != ERROR_IO_PENDING) {
     n = -1;
   }
-#else
-  tn = asy->outstanding_transactions;
-  asy->aiocb[tn].aio_fildes = asy->fd;
-  asy->aiocb[tn].aio_reqprio = 0;
-  asy->aiocb[tn].aio_buf = adr;
-  asy->aiocb[tn].aio_nbytes = len;
-  memset(&(asy->aiocb[tn].aio_sigevent), 0, sizeof(struct sigevent));
-  asy->aiocb[tn].aio_offset = asy->atd[tn].off;
-  n = aio_write(&(asy->aiocb[tn]));
-#endif
 
   if (n == -1) {
     return (-1);
   }
   asy->atd[tn].len = len;
-  asy->atd[tn + 1].off = asy->atd[tn].off + len;
+  asy->off += len;
   asy->outstanding_transactions += 1;
   asy->flags |= ASY_IOACT; /* i/o now active */
   return (0);
+#else
+  return asy_start(asy, adr, len, 1);
+#endif
 }
 
 int
@@ -391,6 +739,9 @@ int
 Fio_asy_close(struct asy *asy)
 {
   int n;
+#if !defined(TARGET_WIN_X8664)
+  int tn;
+#endif
 
   if (slime)
     printf("--Fio_asy_close %d\n", asy->fd);
@@ -401,8 +752,15 @@ Fio_asy_close(struct asy *asy)
 #if defined(TARGET_WIN_X8664)
   /* Close the Re-opened handle that we created. */
   CloseHandle(asy->handle);
+#else
+#if defined(ASY_URING)
+  if (asy->ring)
+    ring_close(asy->ring);
+#endif
+  for (tn = 0; tn < asy->depth; tn++)
+    free(asy->slot[tn].copy);
+  free(asy->slot);
 #endif
   free(asy);
   return (n);
 }
-
@@ -22,12 +22,13 @@ struct asy;
 int Fio_asy_fseek(struct asy *asy, long offset, int whence);
 
 /** \brief
- * Enable asynchronous IO, disable stdio
+ * Enable asynchronous IO, disable stdio.  Transfers already queued by an
+ * earlier statement keep running.
  */
 int Fio_asy_enable(struct asy *asy);
 
 /** \brief
- * Disable asynchronous IO, enable stdio
+ * Wait for all queued transfers, disable asynchronous IO, enable stdio
  */
 int Fio_asy_disable(struct asy *asy);
 
@@ -37,12 +38,13 @@ int Fio_asy_disable(struct asy *asy);
 int Fio_asy_open(FILE *fp, struct asy **pasy);
 
 /** \brief 
- *  Start an asynch read
+ *  Start an asynch read; \p adr must stay valid until the next wait
  */
 int Fio_asy_read(struct asy *asy, void *adr, long len);
 
 /** \brief
- * Start an asynch write 
+ * Start an asynch write.  Small writes are copied, larger ones use \p adr
+ * until the next wait.
  */
 int Fio_asy_write(struct asy *asy, void *adr, long len);
 
@@ -5,6 +5,7 @@
  *
  */
 
+#include <string.h>
 #include "stdioInterf.h"
 #include "fioMacros.h"
 
@@ -178,3 +179,81 @@ __fort_bcopysl(char *to, char *fr, size_t cnt, size_t tostr, size_t frstr,
     }
   }
 }
+
+/* Copy nvec strided vectors at once: vector j has cnt items starting at
+   to + j * todel and fr + j * frdel (bytes), with item strides tostr and
+   frstr as for __fort_bcopysl.  The source and destination must not
+   overlap.
+
+   Contiguous vectors are block copies.  When one side steps through its
+   vectors with a large stride but the vectors start next to each other,
+   as in a transpose, going vector by vector touches a new cache line and
+   often a new page for every item; so the copy goes in square tiles
+   whose lines stay in cache from one vector to the next.  Anything else
+   is copied vector by vector. */
+
+#define TILE 32       /* items per side of a tile */
+#define TILE_STR 512  /* smallest stride (bytes) worth tiling */
+
+#define COPY_TILES(sz)                                                         \
+  for (j0 = 0; j0 < nv; j0 += TILE) {                                          \
+    j1 = j0 + TILE < nv ? j0 + TILE : nv;                                      \
+    for (i0 = 0; i0 < n; i0 += TILE) {                                        \
+      i1 = i0 + TILE < n ? i0 + TILE : n;                                      \
+      for (j = j0; j < j1; ++j) {                                              \
+        t = to + j * todel + i0 * ts;                                          \
+        f = fr + j * frdel + i0 * fs;                                          \
+        for (i = i0; i < i1; ++i, t += ts, f += fs)                            \
+          memcpy(t, f, sz);                                                    \
+      }                                                                        \
+    }                                                                          \
+  }
+
+void
+__fort_bcopys2d(char *to, char *fr, size_t cnt, size_t tostr, size_t frstr,
+                size_t nvec, long todel, long frdel, size_t len)
+{
+  long n = cnt, nv = nvec, l = len;
+  long ts, fs, i, i0, i1, j, j0, j1;
+  char *t, *f;
+
+  if (tostr == 1 && frstr == 1) {
+    if (todel == n * l && frdel == todel) {
+      __fort_bcopy(to, fr, nv * n * l);
+      return;
+    }
+    for (j = 0; j < nv; ++j)
+      __fort_bcopy(to + j * todel, fr + j * frdel, n * l);
+    return;
+  }
+
+  ts = (long)tostr * l;
+  fs = (long)frstr * l;
+  if (!(todel == l && (ts >= TILE_STR || ts <= -TILE_STR)) &&
+      !(frdel == l && (fs >= TILE_STR || fs <= -TILE_STR))) {
+    for (j = 0; j < nv; ++j)
+      __fort_bcopysl(to + j * todel, fr + j * frdel, cnt, tostr, frstr, len);
+    return;
+  }
+
+  switch (len) {
+  case 1:
+    COPY_TILES(1);
+    break;
+  case 2:
+    COPY_TILES(2);
+    break;
+  case 4:
+    COPY_TILES(4);
+    break;
+  case 8:
+    COPY_TILES(8);
+    break;
+  case 16:
+    COPY_TILES(16);
+    break;
+  default:
+    COPY_TILES(len);
+    break;
+  }
+}
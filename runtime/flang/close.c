@@ -17,6 +17,8 @@
 #include <unistd.h>
 #endif
 #include "stdioInterf.h"
+#include "async.h"
+#include "dirmap.h"
 
 #if defined(WIN32) || defined(WIN64)
 #define unlink _unlink
@@ -47,6 +49,25 @@ __fortio_close(FIO_FCB *f, int flag)
       return __io_errno();
   }
 
+  /* finish any async i/o before the file goes away */
+
+  if (f->asyptr) {
+    f->asy_rw = 0;
+    if (Fio_asy_close(f->asyptr) == -1) {
+      f->asyptr = (void *)0;
+      return __fortio_error(__io_errno());
+    }
+    f->asyptr = (void *)0;
+  }
+
+  if (f->mapptr) {
+    if (Fio_map_close(f->mapptr) == -1) {
+      f->mapptr = NULL;
+      return __fortio_error(__io_errno());
+    }
+    f->mapptr = NULL;
+  }
+
   if (!f->stdunit) {
     if (__io_fclose(f->fp) != 0) {
       return __fortio_error(__io_errno());
@@ -186,10 +207,10 @@ __fortio_cleanup(void)
     __fort_barrier();
   }
   if ((LOCAL_MODE || (GET_DIST_LCPU == GET_DIST_IOPROC))) {
-    for (f = fioFcbTbls.fcbs; f != (FIO_FCB *)0; f = f_next) {
+    for (f = fioFcbs; f != (FIO_FCB *)0; f = f_next) {
       /*
        * WARNING: __fortio_close() calls __fortio_free_fcb()
-       * which removes 'f' from the fioFcbTbls.fcbs list;
+       * which removes 'f' from the fioFcbs list;
        * consequently, need to extract the 'next' field now.
        */
       f_next = f->next;
@@ -665,10 +665,12 @@ void I8(copy_setup)(copy_sect *y, char *b, F90_Desc *c, int *axis_map)
   }
 }
 
-/* base addresses already adjusted for scalar subscripts */
+/* base addresses already adjusted for scalar subscripts.  The transfers
+   are added to the channel list cc if it is not NULL, and the channel is
+   pruned only if prune is set. */
 
-chdr *I8(__fort_copy)(void *db, void *sb, F90_Desc *dc, F90_Desc *sc,
-                     int *src_axis_map)
+static chdr *I8(copy_sections)(chdr *cc, int prune, void *db, void *sb,
+                               F90_Desc *dc, F90_Desc *sc, int *src_axis_map)
 {
   DECL_DIM_PTRS(dcd);
   DECL_DIM_PTRS(scd);
@@ -786,7 +788,7 @@ chdr *I8(__fort_copy)(void *db, void *sb, F90_Desc *dc, F90_Desc *sc,
       n = Min(dn, sn);
 
       if (n <= 0)
-        return NULL;
+        return cc;
 
       /* set up sections with adjusted bounds */
 
@@ -817,7 +819,7 @@ chdr *I8(__fort_copy)(void *db, void *sb, F90_Desc *dc, F90_Desc *sc,
   }
 
   if (F90_GSIZE_G(dc) <= 0 && F90_GSIZE_G(sc) <= 0)
-    return NULL;
+    return cc;
 
   I8(copy_setup)(&z.dy, db, dc, identity_map);
   I8(copy_setup)(&z.sy, sb, sc, src_axis_map);
@@ -839,13 +841,14 @@ chdr *I8(__fort_copy)(void *db, void *sb, F90_Desc *dc, F90_Desc *sc,
 #endif
 
   if ((z.dy.islocal | z.sy.islocal) == 0)
-    return NULL;
+    return cc;
 
   if (LOCAL_MODE) {
 
     /* only local communication */
 
-    z.cc = __fort_chn_1to1(NULL, 0, lcpu, &_1, &_1, 0, lcpu, &_1, &_1);
+    z.cc = cc ? cc : __fort_chn_1to1(NULL, 0, lcpu, &_1, &_1, 0, lcpu, &_1,
+                                     &_1);
   } else if (DIST_REPLICATED_G(dc) | DIST_REPLICATED_G(sc)) {
 
     /* source or destination replication */
@@ -882,7 +885,8 @@ chdr *I8(__fort_copy)(void *db, void *sb, F90_Desc *dc, F90_Desc *sc,
     z.cpu = 0; /* always processor 0 */
   } else {
     tcpus_addr = GET_DIST_TCPUS_ADDR;
-    z.cc = __fort_chn_1to1(NULL, 1, 0, tcpus_addr, &_1, 1, 0, tcpus_addr, &_1);
+    z.cc = cc ? cc : __fort_chn_1to1(NULL, 1, 0, tcpus_addr, &_1, 1, 0,
+                                     tcpus_addr, &_1);
   }
 
   if (z.sy.islocal) {
@@ -944,12 +948,31 @@ chdr *I8(__fort_copy)(void *db, void *sb, F90_Desc *dc, F90_Desc *sc,
       }
     }
     __fort_free(z.dy.ch);
-  } else
+    z.cc = __fort_chain_em_up(cc, z.cc);
+  } else if (prune)
     __fort_chn_prune(z.cc);
 
   return z.cc;
 }
 
+chdr *I8(__fort_copy)(void *db, void *sb, F90_Desc *dc, F90_Desc *sc,
+                     int *src_axis_map)
+{
+  return I8(copy_sections)(NULL, 1, db, sb, dc, sc, src_axis_map);
+}
+
+/* Add a copy to the channel list cc from an earlier call (NULL the first
+   time) and return the list.  A caller that copies an array in pieces
+   adds them all, then prunes the list with __fort_chn_prune and executes
+   it with one __fort_doit, which can then copy pieces that form a regular
+   pattern, such as the rows of a transpose, in a single pass. */
+
+chdr *I8(__fort_copy_add)(chdr *cc, void *db, void *sb, F90_Desc *dc,
+                         F90_Desc *sc, int *src_axis_map)
+{
+  return I8(copy_sections)(cc, 0, db, sb, dc, sc, src_axis_map);
+}
+
 void ENTFTN(PERMUTE_SECTION, permute_section)(void *rb, void *sb, F90_Desc *rs,
                                               F90_Desc *ss, ...)
 {
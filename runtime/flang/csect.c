@@ -11,16 +11,275 @@
  * Define the support of an i/o statement to be a critical section:
  *    ENTF90IO(BEGIN, begin)() - marks the begin of an i/o statement
  *    ENTF90IO(END, end)()   - marks the end of an i/o statement
- * Routines are called by the generated code if the option -x 125 1 is
- * selected.  Functions to be completed by users who need this facility.
+ * Routines are called by the generated code when compiling for OpenMP or
+ * if the option -x 125 1 is selected.
+ *
+ * The critical section is per unit.  The statement state of the i/o
+ * library is thread-local (FIO_TLS), so a statement only has to exclude
+ * other statements on the same unit:
+ *  - when a statement looks up a connected unit it takes the FCB's lock
+ *    and keeps it until ENTF90IO(END);
+ *  - when the unit is not connected, the statement keeps the FCB list
+ *    locked until ENTF90IO(END) so that no other thread can connect the
+ *    same unit in the meantime.
+ * Statements on different units run in parallel.  The FCB list lock is
+ * also taken briefly whenever the list is searched or changed.  Outside
+ * of a BEGIN/END pair no locks are taken.
+ *
+ * A function in an I/O list may itself do I/O on another unit, so a
+ * thread can wait for a second FCB while holding the first, and two such
+ * statements running the other way round on two threads would deadlock.
+ * Each FCB lock therefore records its holder, and a thread about to wait
+ * first follows the chain of holders and the FCBs they wait for.  If the
+ * chain leads back to itself the statement fails with FIO_EDEADLOCK
+ * instead; the outer statements keep their units locked throughout, so
+ * no other thread writes into a record they are still building.  The FCB
+ * list lock is kept out of such chains: it is never held while waiting
+ * for an FCB, and a statement that kept it to connect its unit gives it
+ * up once the I/O list starts running.
  */
 
-#include "fioMacros.h"
+#include <string.h>
+#include "global.h"
+#include "llcrit.h"
+
+MP_SEMAPHORE(static, sem);
+static omp_nest_lock_t fcbs_lock;
+static omp_lock_t owner_lock; /* FCB owner fields and the waiting below */
+static volatile int fcbs_lock_init = 0;
+
+/* locks held by this thread's active statements; NULL is the FCB list */
+static FIO_TLS FIO_FCB **held;
+static FIO_TLS int held_avl;
+static FIO_TLS int held_size;
+
+/* FCB this thread waits for; its address is what FCB owners point to */
+static FIO_TLS FIO_FCB *waiting;
+
+/* value of held_avl at the begin of each active statement */
+static FIO_TLS int *marks;
+static FIO_TLS int depth;
+static FIO_TLS int marks_size;
+
+static void
+init_fcbs_lock(void)
+{
+  if (!fcbs_lock_init) {
+    MP_P(sem);
+    if (!fcbs_lock_init) {
+      omp_init_nest_lock(&fcbs_lock);
+      omp_init_lock(&owner_lock);
+      fcbs_lock_init = 1;
+    }
+    MP_V(sem);
+  }
+}
+
+static void
+push_held(FIO_FCB *f)
+{
+  if (held_avl >= held_size) {
+    held_size += 16;
+    held = (FIO_FCB **)realloc(held, sizeof(FIO_FCB *) * held_size);
+  }
+  held[held_avl++] = f;
+}
+
+static void
+unlock_fcb(FIO_FCB *f)
+{
+  omp_set_lock(&owner_lock);
+  f->owner = NULL;
+  omp_unset_lock(&owner_lock);
+  omp_unset_nest_lock(&f->lock);
+}
+
+static void
+release(FIO_FCB *f)
+{
+  if (f)
+    unlock_fcb(f);
+  else
+    omp_unset_nest_lock(&fcbs_lock);
+}
+
+/* would waiting for \p f close a cycle of threads waiting for each other?
+ * Called with owner_lock held. */
+static int
+would_deadlock(FIO_FCB *f)
+{
+  FIO_FCB **t;
+
+  while ((t = f->owner) != NULL) {
+    if (t == &waiting)
+      return 1;
+    if ((f = *t) == NULL)
+      return 0;
+  }
+  return 0;
+}
+
+/* ------------------------------------------------------------------ */
+
+/** \brief Lock the FCB list while it is searched or changed. */
+void
+__fortio_lock_fcbs(void)
+{
+  if (depth) {
+    init_fcbs_lock();
+    omp_set_nest_lock(&fcbs_lock);
+  }
+}
+
+void
+__fortio_unlock_fcbs(void)
+{
+  if (depth)
+    omp_unset_nest_lock(&fcbs_lock);
+}
+
+/** \brief Keep the FCB list locked until the current statement ends. */
+void
+__fortio_hold_fcbs(void)
+{
+  int i;
+
+  if (depth == 0)
+    return;
+  for (i = 0; i < held_avl; ++i)
+    if (held[i] == NULL)
+      return;
+  init_fcbs_lock();
+  omp_set_nest_lock(&fcbs_lock);
+  push_held(NULL);
+}
+
+/** \brief Lock \p f until the current statement ends.
+ *
+ * Returns 1 if the lock was acquired by this call, in which case the
+ * caller must check that \p f still describes the unit it wants; the unit
+ * may have been closed while this thread was waiting.  Returns 0 if no
+ * statement is active or this thread already holds \p f, and -1, without
+ * locking \p f, if its holder waits, maybe through others, for an FCB
+ * this thread holds.
+ */
+int
+__fortio_lock_fcb(FIO_FCB *f)
+{
+  int i;
+
+  if (depth == 0)
+    return 0;
+  for (i = 0; i < held_avl; ++i)
+    if (held[i] == f)
+      return 0;
+  init_fcbs_lock();
+  omp_set_lock(&owner_lock);
+  if (!omp_test_nest_lock(&f->lock)) {
+    if (would_deadlock(f)) {
+      omp_unset_lock(&owner_lock);
+      return -1;
+    }
+    waiting = f;
+    omp_unset_lock(&owner_lock);
+    omp_set_nest_lock(&f->lock);
+    omp_set_lock(&owner_lock);
+    waiting = NULL;
+  }
+  f->owner = &waiting;
+  omp_unset_lock(&owner_lock);
+  push_held(f);
+  return 1;
+}
+
+/** \brief Lock \p f, an FCB about to be connected, until the current
+ * statement ends if that can be done without waiting.  Returns FALSE if
+ * another thread, one that was waiting for the unit that used \p f
+ * before, still has it locked.
+ */
+bool
+__fortio_trylock_fcb(FIO_FCB *f)
+{
+  if (depth == 0)
+    return TRUE;
+  init_fcbs_lock();
+  omp_set_lock(&owner_lock);
+  if (!omp_test_nest_lock(&f->lock)) {
+    omp_unset_lock(&owner_lock);
+    return FALSE;
+  }
+  f->owner = &waiting;
+  omp_unset_lock(&owner_lock);
+  push_held(f);
+  return TRUE;
+}
+
+/** \brief Undo the last __fortio_lock_fcb(\p f). */
+void
+__fortio_unlock_fcb(FIO_FCB *f)
+{
+  int i;
+
+  for (i = held_avl - 1; i >= 0; --i) {
+    if (held[i] == f) {
+      release(f);
+      --held_avl;
+      memmove(held + i, held + i + 1, sizeof(FIO_FCB *) * (held_avl - i));
+      return;
+    }
+  }
+}
+
+/** \brief Return the FCB of \p unit if this thread already holds it. */
+FIO_FCB *
+__fortio_held_unit(int unit)
+{
+  int i;
+
+  for (i = held_avl - 1; i >= 0; --i)
+    if (held[i] && held[i]->unit == unit)
+      return held[i];
+  return NULL;
+}
+
+/* ------------------------------------------------------------------ */
+
+void ENTF90IO(BEGIN, begin)()
+{
+  int i;
 
-void ENTF90IO(BEGIN, begin)() {}
+  /* a statement started from an I/O list: the outer statement's unit is
+     connected by now, so it no longer needs to keep the FCB list */
+  if (depth > 0) {
+    for (i = held_avl; --i >= marks[depth - 1];) {
+      if (held[i] == NULL) {
+        __fortio_unlock_fcb(NULL);
+        break;
+      }
+    }
+  }
+  if (depth >= marks_size) {
+    marks_size += 8;
+    marks = (int *)realloc(marks, sizeof(int) * marks_size);
+  }
+  marks[depth++] = held_avl;
+}
 
-void ENTF90IO(END, end)() {}
+void ENTF90IO(END, end)()
+{
+  if (depth == 0)
+    return;
+  --depth;
+  while (held_avl > marks[depth])
+    release(held[--held_avl]);
+}
 
-void ENTCRF90IO(BEGIN, begin)() {}
+void ENTCRF90IO(BEGIN, begin)()
+{
+  ENTF90IO(BEGIN, begin)();
+}
 
-void ENTCRF90IO(END, end)() {}
+void ENTCRF90IO(END, end)()
+{
+  ENTF90IO(END, end)();
+}
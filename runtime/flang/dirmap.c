@@ -0,0 +1,288 @@
+/*
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+ * See https://llvm.org/LICENSE.txt for license information.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+/* clang-format off */
+
+/*
+ * The external routines in this module are:
+ *
+ * Fio_map_open - called from open
+ * Fio_map_seek - called by __fortio_rwinit for each statement
+ * Fio_map_active - does the current statement use the mapping
+ * Fio_map_read, Fio_map_write, Fio_map_zero, Fio_map_skip - transfers
+ * Fio_map_sync - called from flush
+ * Fio_map_close - called from close
+ *
+ * When F90_DIRECT_MMAP is set to a nonzero value, direct access
+ * unformatted files are mapped into memory at OPEN.  A READ or WRITE of a
+ * record that lies inside the file then copies between the program and the
+ * mapping without any system call; the kernel writes modified pages back,
+ * and FLUSH and CLOSE msync them.  Records past the end of the file, that
+ * is writes that extend the file, go through stdio as before.  The mapping
+ * is grown when a later statement refers to one of those records.
+ *
+ * The stdio stream is not positioned by mapped statements.  Data stdio
+ * still buffers is flushed before the first mapped statement after a stdio
+ * one, and the stream is flushed and repositioned before the first stdio
+ * statement after a mapped one.
+ *
+ * Not used for byte swapped (CONVERT=) and asynchronous units, on pipes,
+ * or when the file cannot be mapped.  As with any mapped file, truncating
+ * the file from another process while it is open faults the program.
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#ifndef _WIN64
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "global.h"
+#include "dirmap.h"
+
+#ifndef _WIN64
+
+/* smallest amount by which a mapping is grown */
+#define MAP_MIN_GROW (1L << 20)
+
+struct dirmap {
+  char *base;      /* start of the mapping, or NULL */
+  seekoffx_t len;  /* bytes mapped; may extend past the end of file */
+  seekoffx_t size; /* size of the file when last checked */
+  seekoffx_t cur;  /* file offset of the current statement, or -1 if
+                    * the statement goes through stdio */
+  bool writable;   /* mapped PROT_WRITE */
+  bool dirty;      /* stored into since the last msync */
+  bool stale;      /* stdio stream not positioned; last statement mapped */
+};
+
+static int map_enabled = -1;
+
+/* find the size of the file, mapping more of it if it has grown */
+static void
+map_file(FIO_FCB *f, struct dirmap *m)
+{
+  struct stat st;
+  seekoffx_t len;
+  char *p;
+  int fd;
+  bool writable;
+
+  if (__io_fflush(f->fp) != 0)
+    return;
+  fd = __io_getfd(f->fp);
+  if (fstat(fd, &st) != 0 || st.st_size <= m->size)
+    return;
+  m->size = st.st_size;
+  if (m->base && m->size <= m->len)
+    return;
+
+  /* leave room for the file to grow before it has to be mapped again */
+  len = m->size + (m->size > MAP_MIN_GROW ? m->size : MAP_MIN_GROW);
+  if ((seekoffx_t)(size_t)len != len)
+    return;
+  p = (char *)mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  writable = p != MAP_FAILED;
+  if (p == MAP_FAILED && errno == EACCES) /* opened read only */
+    p = (char *)mmap(NULL, len, PROT_READ, MAP_SHARED, fd, 0);
+  if (p == MAP_FAILED)
+    return;
+  if (m->base) {
+    if (m->dirty)
+      (void)msync(m->base, m->len, MS_ASYNC);
+    (void)munmap(m->base, m->len);
+  }
+  m->base = p;
+  m->len = len;
+  m->writable = writable;
+}
+
+void
+Fio_map_open(FIO_FCB *f)
+{
+  struct dirmap *m;
+  char *p;
+
+  f->mapptr = NULL;
+  if (map_enabled < 0) {
+    p = getenv("F90_DIRECT_MMAP");
+    map_enabled = p ? atoi(p) != 0 : 0;
+  }
+  if (!map_enabled || f->acc != FIO_DIRECT || f->form != FIO_UNFORMATTED ||
+      f->ispipe)
+    return;
+  m = (struct dirmap *)calloc(1, sizeof(struct dirmap));
+  if (m == NULL)
+    return;
+  m->cur = -1;
+  map_file(f, m);
+  f->mapptr = m;
+}
+
+bool
+Fio_map_seek(FIO_FCB *f, seekoffx_t rec, bool write)
+{
+  struct dirmap *m = f->mapptr;
+  seekoffx_t pos = f->reclen * (rec - 1);
+  seekoffx_t end = pos + f->reclen;
+
+  m->cur = -1;
+  if (end > m->size && rec <= f->maxrec)
+    map_file(f, m); /* an existing record; the file has grown */
+  if (m->base && end <= m->size && (m->writable || !write)) {
+    if (!m->stale) {
+      /* whatever stdio holds must be in the file first */
+      if (__io_fflush(f->fp) != 0)
+        return FALSE;
+      m->stale = TRUE;
+    }
+    m->cur = pos;
+    return TRUE;
+  }
+  if (m->stale) {
+    /* drop anything stdio read before the mapped statements */
+    (void)__io_fflush(f->fp);
+    (void)__io_fseekx(f->fp, pos, SEEK_SET);
+    f->coherent = 0;
+    m->stale = FALSE;
+  }
+  return FALSE;
+}
+
+bool
+Fio_map_active(struct dirmap *m)
+{
+  return m && m->cur >= 0;
+}
+
+int
+Fio_map_read(struct dirmap *m, void *adr, size_t len)
+{
+  if (m->cur + (seekoffx_t)len > m->size) {
+    __io_set_errno(EIO);
+    return -1;
+  }
+  memcpy(adr, m->base + m->cur, len);
+  m->cur += len;
+  return 0;
+}
+
+int
+Fio_map_write(struct dirmap *m, void *adr, size_t len)
+{
+  if (m->cur + (seekoffx_t)len > m->size) {
+    __io_set_errno(EIO);
+    return -1;
+  }
+  memcpy(m->base + m->cur, adr, len);
+  m->cur += len;
+  m->dirty = TRUE;
+  return 0;
+}
+
+int
+Fio_map_zero(struct dirmap *m, size_t len)
+{
+  if (m->cur + (seekoffx_t)len > m->size) {
+    __io_set_errno(EIO);
+    return -1;
+  }
+  memset(m->base + m->cur, 0, len);
+  m->cur += len;
+  m->dirty = TRUE;
+  return 0;
+}
+
+int
+Fio_map_skip(struct dirmap *m, long offset)
+{
+  m->cur += offset;
+  return 0;
+}
+
+int
+Fio_map_sync(struct dirmap *m)
+{
+  if (m->base && m->dirty) {
+    if (msync(m->base, m->size, MS_SYNC) != 0)
+      return -1;
+    m->dirty = FALSE;
+  }
+  return 0;
+}
+
+int
+Fio_map_close(struct dirmap *m)
+{
+  int s;
+
+  s = Fio_map_sync(m);
+  if (m->base)
+    (void)munmap(m->base, m->len);
+  free(m);
+  return s;
+}
+
+#else
+
+void
+Fio_map_open(FIO_FCB *f)
+{
+  f->mapptr = NULL;
+}
+
+bool
+Fio_map_seek(FIO_FCB *f, seekoffx_t rec, bool write)
+{
+  return FALSE;
+}
+
+bool
+Fio_map_active(struct dirmap *m)
+{
+  return FALSE;
+}
+
+int
+Fio_map_read(struct dirmap *m, void *adr, size_t len)
+{
+  return -1;
+}
+
+int
+Fio_map_write(struct dirmap *m, void *adr, size_t len)
+{
+  return -1;
+}
+
+int
+Fio_map_zero(struct dirmap *m, size_t len)
+{
+  return -1;
+}
+
+int
+Fio_map_skip(struct dirmap *m, long offset)
+{
+  return -1;
+}
+
+int
+Fio_map_sync(struct dirmap *m)
+{
+  return 0;
+}
+
+int
+Fio_map_close(struct dirmap *m)
+{
+  return 0;
+}
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+ * See https://llvm.org/LICENSE.txt for license information.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+#ifndef _DIRMAP_H
+#define _DIRMAP_H
+
+/** \file
+ * Memory-mapped direct access unformatted files (from dirmap.c)
+ */
+
+struct dirmap;
+
+/** \brief
+ * Map a direct access unformatted file if F90_DIRECT_MMAP is set; called
+ * from open
+ */
+void Fio_map_open(FIO_FCB *f);
+
+/** \brief
+ * Start a transfer of record \p rec.  Return TRUE if the statement goes
+ * through the mapping; otherwise position the stdio stream at the record
+ * and return FALSE.
+ */
+bool Fio_map_seek(FIO_FCB *f, seekoffx_t rec, bool write);
+
+/** \brief
+ * TRUE if the current statement on the file goes through the mapping
+ */
+bool Fio_map_active(struct dirmap *m);
+
+/** \brief
+ * Copy \p len bytes of the current record to \p adr
+ */
+int Fio_map_read(struct dirmap *m, void *adr, size_t len);
+
+/** \brief
+ * Copy \p len bytes from \p adr into the current record
+ */
+int Fio_map_write(struct dirmap *m, void *adr, size_t len);
+
+/** \brief
+ * Zero the next \p len bytes of the current record
+ */
+int Fio_map_zero(struct dirmap *m, size_t len);
+
+/** \brief
+ * Move within the current record
+ */
+int Fio_map_skip(struct dirmap *m, long offset);
+
+/** \brief
+ * Write modified pages back to the file, called from flush
+ */
+int Fio_map_sync(struct dirmap *m);
+
+/** \brief
+ * Write back and unmap, called from close
+ */
+int Fio_map_close(struct dirmap *m);
+
+#endif /* _DIRMAP_H */
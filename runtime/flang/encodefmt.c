@@ -9,6 +9,7 @@
 
 /*  encodefmt.c - translate format string into encoded form at runtime. */
 
+#include <string.h>
 #include "global.h"
 #include "feddesc.h"
 
@@ -17,14 +18,14 @@
 
 typedef int ERRCODE;
 
-static long numval; /* numeric value computed by ef_getnum */
-static char *firstchar, *lastchar;
-static int curpos; /* current avail posn in output buffer */
-static int paren_stack[STACK_SIZE];
-static bool enclosing_parens;
-static INT *buff = NULL;
-static int buffsize = 0;
-static char quote;
+static FIO_TLS long numval; /* numeric value computed by ef_getnum */
+static FIO_TLS char *firstchar, *lastchar;
+static FIO_TLS int curpos; /* current avail posn in output buffer */
+static FIO_TLS int paren_stack[STACK_SIZE];
+static FIO_TLS bool enclosing_parens;
+static FIO_TLS INT *buff = NULL;
+static FIO_TLS int buffsize = 0;
+static FIO_TLS char quote;
 
 static ERRCODE check_outer_parens(char *, __CLEN_T);
 static bool ef_getnum(char *, int *);
@@ -37,6 +38,29 @@ static INT ef_error(ERRCODE);
 static void ef_putvlist(char *, int *);
 static void ef_putdt();
 static void ef_putiotype(char *, int *);
+static bool fmt_cache_get(char *, __CLEN_T, unsigned int *);
+static void fmt_cache_put(char *, __CLEN_T, unsigned int);
+
+/*
+ * Cache of encoded formats, indexed by a hash of the format string.  A
+ * program that builds a format at runtime and uses it over and over in a
+ * loop then only parses it once.  Each i/o statement still receives its own
+ * malloc'd copy of the encoded format since the formatted i/o routines free
+ * it at the end of the statement (and DT edit descriptors are rewritten in
+ * place).  The cache is per thread so that no locking is needed.  Long
+ * strings are not cached; ENCODE_FMTV passes an unknown length which is
+ * excluded this way, too.
+ */
+#define FMT_CACHE_SIZE 64     /* number of entries, power of 2 */
+#define FMT_CACHE_MAXLEN 1024 /* longest format string cached */
+
+static FIO_TLS struct {
+  unsigned int hash;
+  __CLEN_T len; /* length of str */
+  char *str;    /* copy of the format string */
+  INT *code;    /* encoded format */
+  int ncode;    /* number of INTs in code */
+} fmt_cache[FMT_CACHE_SIZE];
 
 /* ----------------------------------------------------------------------- */
 
@@ -56,6 +80,8 @@ _f90io_encode_fmt(char *str,      /* unencoded format string */
   int paren_level = 0;   /* current paren nesting level */
   int k, n;
   bool unlimited_repeat_count = FALSE;
+  __CLEN_T len;      /* length of the format string */
+  unsigned int hash; /* hash of the format string */
 
   /* the following call is just to ensure __fortio_init() has been called: */
   __fortio_errinit03(0, 0, NULL, "encode format string");
@@ -68,7 +94,11 @@ _f90io_encode_fmt(char *str,      /* unencoded format string */
   n = 1;
   if (*nelem)
     n = *nelem;
-  i = check_outer_parens(str, str_siz * n);
+  len = str_siz * n;
+  if (fmt_cache_get(str, len, &hash))
+    return 0;
+
+  i = check_outer_parens(str, len);
   if (i != 0)
     return ef_error(i);
 
@@ -612,11 +642,82 @@ end_of_format:
   ef_put(FED_END); /* end of format */
   ef_put(reversion_loc);
 
+  fmt_cache_put(str, len, hash);
   return 0; /* no error */
 }
 
 /* ------------------------------------------------------------------- */
 
+static unsigned int
+fmt_hash(char *str, __CLEN_T len)
+{
+  unsigned int h = 2166136261U; /* FNV-1a */
+  __CLEN_T i;
+
+  for (i = 0; i < len; i++) {
+    h ^= (unsigned char)str[i];
+    h *= 16777619U;
+  }
+  return h;
+}
+
+/** \brief If \p str has been encoded before, copy its encoded form into
+ * the output buffer and return TRUE.  Its hash is returned in \p hash.
+ */
+static bool
+fmt_cache_get(char *str, __CLEN_T len, unsigned int *hash)
+{
+  unsigned int h;
+  int k;
+
+  if (len > FMT_CACHE_MAXLEN || str == NULL)
+    return FALSE;
+  h = fmt_hash(str, len);
+  *hash = h;
+  k = h & (FMT_CACHE_SIZE - 1);
+  if (fmt_cache[k].str == NULL || fmt_cache[k].hash != h ||
+      fmt_cache[k].len != len || memcmp(fmt_cache[k].str, str, len) != 0)
+    return FALSE;
+  curpos = fmt_cache[k].ncode;
+  if (curpos > buffsize)
+    ef_alloc(curpos - buffsize);
+  memcpy(buff, fmt_cache[k].code, curpos * sizeof(INT));
+  return TRUE;
+}
+
+/** \brief Remember the encoded form of \p str, replacing whatever format
+ * used the same cache entry before.
+ */
+static void
+fmt_cache_put(char *str, __CLEN_T len, unsigned int hash)
+{
+  int k;
+  char *s;
+  INT *code;
+
+  if (len > FMT_CACHE_MAXLEN)
+    return;
+  s = (char *)malloc(len);
+  code = (INT *)malloc(curpos * sizeof(INT));
+  if (s == NULL || code == NULL) {
+    free(s);
+    free(code);
+    return;
+  }
+  memcpy(s, str, len);
+  memcpy(code, buff, curpos * sizeof(INT));
+  k = hash & (FMT_CACHE_SIZE - 1);
+  free(fmt_cache[k].str);
+  free(fmt_cache[k].code);
+  fmt_cache[k].hash = hash;
+  fmt_cache[k].len = len;
+  fmt_cache[k].str = s;
+  fmt_cache[k].code = code;
+  fmt_cache[k].ncode = curpos;
+}
+
+/* ------------------------------------------------------------------- */
+
 static ERRCODE
 check_outer_parens(char *p, /* ptr to format string to be encoded */
                    __CLEN_T len)
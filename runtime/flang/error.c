@@ -21,16 +21,16 @@ typedef struct {
   int lineno;
 } src_info_struct;
 
-static src_info_struct src_info;
+static FIO_TLS src_info_struct src_info;
 
-static int current_unit;
-static INT *iostat_ptr;
-static int iobitv;
-static char *err_str = "?";
+static FIO_TLS int current_unit;
+static FIO_TLS INT *iostat_ptr;
+static FIO_TLS int iobitv;
+static FIO_TLS char *err_str = "?";
 char *envar_fortranopt;
 
-static char *iomsg; /* pointer for optional IOMSG area */
-static __CLEN_T iomsgl;  /* length of above */
+static FIO_TLS char *iomsg; /* pointer for optional IOMSG area */
+static FIO_TLS __CLEN_T iomsgl;  /* length of above */
 
 typedef struct {
   INT *enctab;
@@ -48,7 +48,6 @@ typedef struct {
   __CLEN_T iomsgl;
 
   /* fioFcbTbls stuff */
-  FIO_FCB *fcbs;
   INT *enctab;
   char *fname;
   int fnamelen;
@@ -60,17 +59,17 @@ typedef struct {
 } fioerror;
 
 #define GBL_SIZE 15
-static int gbl_size = 15;
-static int gbl_avl = 0;
-static fioerror static_gbl[GBL_SIZE];
-static fioerror *gbl = &static_gbl[0];
-static fioerror *gbl_head = &static_gbl[0];
-
-static int fmtgbl_size = 15;
-static int fmtgbl_avl = 0;
-static f90fmt static_fmtgbl[GBL_SIZE];
-static f90fmt *fmtgbl = &static_fmtgbl[0];
-static f90fmt *fmtgbl_head = &static_fmtgbl[0];
+static FIO_TLS int gbl_size = 15;
+static FIO_TLS int gbl_avl = 0;
+static FIO_TLS fioerror static_gbl[GBL_SIZE];
+static FIO_TLS fioerror *gbl;      /* set by init_gbl() */
+static FIO_TLS fioerror *gbl_head;
+
+static FIO_TLS int fmtgbl_size = 15;
+static FIO_TLS int fmtgbl_avl = 0;
+static FIO_TLS f90fmt static_fmtgbl[GBL_SIZE];
+static FIO_TLS f90fmt *fmtgbl;      /* set by init_gbl() */
+static FIO_TLS f90fmt *fmtgbl_head;
 
 static void ioerrinfo(FIO_FCB *);
 static void __fortio_init(void);
@@ -79,15 +78,29 @@ static void __fortio_init(void);
 extern void  f90_compiled();
 
 /* --------------------------------------------------------------------- */
+/* A thread-local pointer can't be initialized with the address of
+ * thread-local data, so point the stacks at their static parts here.
+ */
+static void
+init_gbl()
+{
+  if (gbl_head == NULL) {
+    gbl = gbl_head = &static_gbl[0];
+    fmtgbl = fmtgbl_head = &static_fmtgbl[0];
+  }
+}
+
 void
 set_gbl_newunit(bool newunit)
 {
+  init_gbl();
   gbl->newunit = newunit;
 }
 
 bool
 get_gbl_newunit()
 {
+  init_gbl();
   return gbl->newunit;
 }
 
@@ -126,14 +139,6 @@ restore_gbl()
     src_info.len = gbl->src_info.len;
     src_info.lineno = gbl->src_info.lineno;
 
-    if (gbl->current_unit != current_unit) {
-      fioFcbTbls.error = gbl->error;
-      fioFcbTbls.eof = gbl->eof;
-    } else {
-      /* may need to recursively check current_unit with other gbl->current_unit
-       * if it is a match, then save fioFcbTbls.error/eof to that gbl? F2008?
-       */
-    }
     fioFcbTbls.pos_present = gbl->pos_present;
     fioFcbTbls.pos = gbl->pos;
     fioFcbTbls.fname = gbl->fname;
@@ -157,6 +162,7 @@ static void
 allocate_new_gbl()
 {
   fioerror *tmp_gbl;
+  init_gbl();
   if (gbl_avl >= gbl_size) {
     if (gbl_size == GBL_SIZE) {
       gbl_size = gbl_size + 15;
@@ -177,6 +183,7 @@ static void
 allocate_new_fmtgbl()
 {
   f90fmt *tmp_gbl;
+  init_gbl();
   if (fmtgbl_avl >= fmtgbl_size) {
     if (fmtgbl_size == GBL_SIZE) {
       fmtgbl_size = fmtgbl_size + 15;
@@ -227,7 +234,7 @@ save_fmtgbl()
 extern void
 __fortio_errinit(__INT_T unit, __INT_T bitv, __INT_T *iostat, char *str)
 {
-  if (fioFcbTbls.fcbs == NULL)
+  if (fioFcbs == NULL)
     __fortio_init();
 
   fioFcbTbls.error = FALSE;
@@ -251,7 +258,7 @@ __fortio_errinit(__INT_T unit, __INT_T bitv, __INT_T *iostat, char *str)
 extern void
 __fortio_errinit03(__INT_T unit, __INT_T bitv, __INT_T *iostat, char *str)
 {
-  if (fioFcbTbls.fcbs == NULL)
+  if (fioFcbs == NULL)
     __fortio_init();
 
   save_gbl();
@@ -276,8 +283,37 @@ extern void
 __fortio_errend03()
 /* restore the previous value of previous status of io error.*/
 {
+  fioerror *done = gbl;
+  int unit = current_unit;
+
   free_gbl();
   restore_gbl();
+  /* errinit03 saved the status of the statement this one interrupted in
+   * the entry just freed; a nested statement on another unit must not
+   * hand its error or end-of-file over to it.
+   * may need to recursively check current_unit with other gbl->current_unit
+   * if it is a match, then save fioFcbTbls.error/eof to that gbl? F2008?
+   */
+  if (gbl_avl && done->current_unit != unit) {
+    fioFcbTbls.error = done->error;
+    fioFcbTbls.eof = done->eof;
+  }
+}
+
+/** \brief Whether a statement whose init or data transfer call returned
+ * \p s is left by a branch to its ERR=, END= or EOR= label.
+ *
+ * Only then is its end routine skipped and its state must be dropped at
+ * once; otherwise the I/O list still runs, finding the error set, and the
+ * end routine drops it.  Dropping it twice would drop the state of the
+ * statement whose I/O list started this one.
+ */
+bool
+__fortio_leaves_stmt(int s)
+{
+  return (s == ERR_FLAG && (iobitv & FIO_BITV_ERR)) ||
+         (s == EOF_FLAG && (iobitv & FIO_BITV_EOF)) ||
+         (s == EOR_FLAG && (iobitv & FIO_BITV_EOR));
 }
 
 extern void
@@ -366,6 +402,7 @@ static char *errtxt[] = {
     X("POS can only be specified for a 'STREAM' file")       /* EPOS    256 */
     X("POS value must be positive")                          /* EPOSV   257 */
     X("NEWUNIT requires FILE or STATUS=SCRATCH")             /* ENEWUNIT 258 */
+    X("unit held by a thread waiting for this one")          /* EDEADLOCK 259 */
 };
 
 /*  include Kanji error message text:  */
@@ -393,7 +430,8 @@ __fortio_error(int errval)
   if (errval == FIO_EEOR) /* handle end-of-record separately */
     return __fortio_eorerr(FIO_EEOR);
 
-  fdesc = __fortio_find_unit(current_unit);
+  /* the unit of a statement that would deadlock is locked elsewhere */
+  fdesc = errval == FIO_EDEADLOCK ? NULL : __fortio_find_unit(current_unit);
 
   if (iobitv == FIO_BITV_NONE || iobitv == FIO_BITV_EOF) {
 /* Abort if:
@@ -455,7 +493,7 @@ extern char *
 __fortio_errmsg(int errval)
 {
   char *txt;
-  static char buf[128];
+  static FIO_TLS char buf[128];
   if (errval == 0) {
     buf[0] = ' ';
     buf[1] = '\0';
@@ -788,6 +826,7 @@ void ENTCRF90IO(SRC_INFOX, src_infox)(
 static void
 set_iomsg()
 {
+  init_gbl();
   gbl->iomsg = iomsg;
   gbl->iomsgl = iomsgl;
 }
@@ -848,7 +887,11 @@ __fortio_init(void)
 {
   FIO_FCB *f;
 
-  assert(fioFcbTbls.fcbs == NULL);
+  __fortio_lock_fcbs();
+  if (fioFcbs != NULL) { /* another thread got here first */
+    __fortio_unlock_fcbs();
+    return;
+  }
 
   /* preconnect stdin as unit -5 for * unit specifier */
   f = __fortio_alloc_fcb();
@@ -1027,6 +1070,7 @@ __fortio_init(void)
       new_fp_formatter = 1;
     }
   }
+  __fortio_unlock_fcbs();
 }
 
 int
@@ -1062,6 +1106,7 @@ __fortio_new_fp_formatter(void)
 static void
 set_pos()
 {
+  init_gbl();
   gbl->pos = fioFcbTbls.pos;
   gbl->pos_present = fioFcbTbls.pos_present;
 }
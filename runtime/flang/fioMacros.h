@@ -23,6 +23,13 @@
 #include "fioStructs.h"
 #include "FuncArgMacros.h"
 
+/* storage class for per-thread Fortran I/O statement state */
+#if defined(_WIN32)
+#define FIO_TLS __declspec(thread)
+#else
+#define FIO_TLS __thread
+#endif
+
 /* special argument pointers */
 
 #if defined(TARGET_WIN) || defined(WIN64) || defined(WIN32)
@@ -1555,9 +1562,15 @@ void __fort_bcopy(char *to, char *fr, size_t n);
 void __fort_bcopysl(char *to, char *fr, size_t cnt, size_t tostr, size_t frstr,
                    size_t size);
 
+void __fort_bcopys2d(char *to, char *fr, size_t cnt, size_t tostr,
+                     size_t frstr, size_t nvec, long todel, long frdel,
+                     size_t len);
+
 void I8(__fort_fills)(char *ab, F90_Desc *ad, void *fill);
 
 chdr *I8(__fort_copy)(void *db, void *sb, F90_Desc *dd, F90_Desc *sd, int *smap);
+chdr *I8(__fort_copy_add)(chdr *cc, void *db, void *sb, F90_Desc *dd,
+                         F90_Desc *sd, int *smap);
 
 void I8(__fort_copy_out)(void *db, void *sb, F90_Desc *dd, F90_Desc *sd,
                         __INT_T flags);
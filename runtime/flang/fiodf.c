@@ -11,13 +11,15 @@
 
 /* define global variables for fortran I/O (members of struct fioFcbTbls): */
 
-FIO_TBL fioFcbTbls = {0};
+FIO_TLS FIO_TBL fioFcbTbls = {0};
+
+FIO_FCB *fioFcbs = NULL;
 
 #ifdef WINNT
 FIO_FCB *
 __get_hpfio_fcbs(void)
 {
-  return fioFcbTbls.fcbs;
+  return fioFcbs;
 }
 #endif
 
@@ -13,6 +13,7 @@
 
 #include "global.h"
 #include "async.h"
+#include "dirmap.h"
 
 int ENTF90IO(FLUSH, flush)(unit, bitv, iostat) __INT_T *unit;
 __INT_T *bitv;
@@ -49,6 +50,14 @@ __INT_T *iostat;
       __fortio_errend03();
       return s;
     }
+
+    /* write back records stored into a mapped file */
+
+    if (f->mapptr && Fio_map_sync(f->mapptr) == -1) {
+      s = __fortio_error(__io_errno());
+      __fortio_errend03();
+      return s;
+    }
   }
 
   __fortio_errend03();
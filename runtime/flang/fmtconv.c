@@ -58,17 +58,18 @@ static char *__fortio_fmt_z(unsigned int);
 #define PP_REAL8(i) (*(__REAL8_T *)(i))
 #define PP_REAL16(i) (*(__REAL16_T *)(i))
 
-static int field_overflow;
+static FIO_TLS int field_overflow;
 
-char __f90io_conv_buf[96] = {0}; /* sufficient size for non-char types - must
-                                  * be init'd for 32-bit OSX
-                                  */
-static char *conv_bufp = __f90io_conv_buf;
-static unsigned conv_bufsize = sizeof(__f90io_conv_buf);
+FIO_TLS char __f90io_conv_buf[96] = {0}; /* sufficient size for non-char
+                                          * types - must be init'd for
+                                          * 32-bit OSX
+                                          */
+static FIO_TLS char *conv_bufp; /* NULL until first used on this thread */
+static FIO_TLS unsigned conv_bufsize = sizeof(__f90io_conv_buf);
 
-static char cmplx_buf[64]; /* just for list-directed and nml io */
-static char exp_letter = 'E';
-static char *buff_pos;
+static FIO_TLS char cmplx_buf[64]; /* just for list-directed and nml io */
+static FIO_TLS char exp_letter = 'E';
+static FIO_TLS char *buff_pos;
 
 /* ----------------------------------------------------------------- */
 void
@@ -88,6 +89,8 @@ __fortio_default_convert(char *item, int type,
   char *p;
   DBLINT64 i8val;
 
+  if (conv_bufp == NULL)
+    conv_bufp = __f90io_conv_buf;
   switch (type) {
   default:
     assert(0);
@@ -299,7 +302,7 @@ conv_int(__BIGINT_T val, int *lenp, int *negp)
 #define MAX_HX 0x80000000
 #define MAX_STR "2147483648"
 
-  static char tmp[MAX_CONV_INT];
+  static FIO_TLS char tmp[MAX_CONV_INT];
   char *p;
   int len;
   int neg;
@@ -378,7 +381,7 @@ conv_int8(DBLINT64 val, int *lenp, int *negp)
 {
 #define MAX_CONV_INT8 32
 
-  static char tmp[MAX_CONV_INT8];
+  static FIO_TLS char tmp[MAX_CONV_INT8];
   char *p;
   int len;
   DBLINT64 value;
@@ -413,8 +416,8 @@ conv_int8(DBLINT64 val, int *lenp, int *negp)
   return p;
 }
 
-static char fpbuf[64];
-static struct {
+static FIO_TLS char fpbuf[64];
+static FIO_TLS struct {
   int exp;  /* initially set by ecvt/fcvt. adjusted by the
              * scale factor.  WARNING: may be set to zero if
              * value to be printed represents 0.
@@ -435,7 +438,7 @@ static struct {
   char *buf;
   int bufsize;
   __BIGREAL_T zero; /* hide 0.0 from the optimizer here */
-} fpdat = {0, 0, 0, '.', 0, 0, 0, fpbuf, sizeof(fpbuf), 0.0};
+} fpdat = {0, 0, 0, '.', 0, 0, 0, NULL, sizeof(fpbuf), 0.0}; /* buf: fpbuf */
 
 static void put_buf(int width,     /* where width (# bytes) */
                     char *valp,    /* value in string form */
@@ -449,6 +452,8 @@ static void put_buf(int width,     /* where width (# bytes) */
   if (DBGBIT(0x1))
     __io_printf("put_buf: width=%d, len=%d, val=%.*s#, sign_char=%d\n", width,
                  len, len, valp, sign_char);
+  if (conv_bufp == NULL)
+    conv_bufp = __f90io_conv_buf;
   if (width >= conv_bufsize) {
     conv_bufsize = width + 128;
     if (conv_bufp != __f90io_conv_buf)
@@ -1148,6 +1153,8 @@ cvtp_set(int n, int ch)
 static void
 alloc_fpbuf(int n)
 {
+  if (fpdat.buf == NULL) /* first conversion on this thread */
+    fpdat.buf = fpbuf;
   if (n > fpdat.bufsize) {
     fpdat.bufsize = n + 32;
     if (fpdat.buf != fpbuf)
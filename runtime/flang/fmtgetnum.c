@@ -19,15 +19,31 @@
 
 #include "global.h"
 #include "format.h"
+#include "format-double.h"
 
 /* define a few things for run-time tracing */
 static int dbgflag;
 #undef DBGBIT
 #define DBGBIT(v) (LOCAL_DEBUG && (dbgflag & v))
 
-static char buf[128];
-static char *buf_p = buf;
-static int buf_size = sizeof(buf);
+static FIO_TLS char buf[128];
+static FIO_TLS char *buf_p; /* NULL until first used on this thread */
+static FIO_TLS int buf_size = sizeof(buf);
+
+/* Collect up to 19 significant digits of the number being scanned. */
+#define MAX_MANT_DIGITS 19
+#define ACCUM_DIGIT(c, frac)                                                   \
+  if (mant_digits < MAX_MANT_DIGITS) {                                         \
+    mant = mant * 10 + ((c) - '0');                                            \
+    if (mant != 0)                                                             \
+      ++mant_digits;                                                           \
+    if (frac)                                                                  \
+      --mant_expo;                                                             \
+  } else if ((c) != '0') {                                                     \
+    mant_lost = TRUE;                                                          \
+  } else if (!(frac)) {                                                        \
+    ++mant_expo;                                                               \
+  }
 
 /*
  *  __fortio_getnum() - extracts integer or __BIGREAL_T scalar values from
@@ -57,6 +73,10 @@ __fortio_getnum(
   char *bp;
   char decimal_char = '.';
   int itmp;
+  bool neg = FALSE;
+  unsigned long long mant = 0;
+  int mant_digits = 0, mant_expo = 0, expo = 0, expo_digits = 0;
+  bool mant_lost = FALSE, expo_neg = FALSE;
   union {
     __BIGINT_T i;
     __BIGREAL_T d;
@@ -70,13 +90,16 @@ __fortio_getnum(
   val = _val;
   ret_err = 0;
   c = *(cp = currc);
-  if (c == '-' || c == '+')
+  if (c == '-' || c == '+') {
+    neg = c == '-';
     c = *++cp;
+  }
   if (c == decimal_char) {
     *cp = '.';
-    c = *++cp;
-    if (!ISDIGIT(c))
+    if (!ISDIGIT(cp[1])) {
+      c = *++cp;
       goto junk0;
+    }
     goto state2;
   }
   if (!ISDIGIT(c))
@@ -84,6 +107,7 @@ __fortio_getnum(
 
   /*state1:			digits */
   do {
+    ACCUM_DIGIT(c, FALSE);
     c = *++cp;
   } while (ISDIGIT(c));
   if (c == decimal_char) {
@@ -96,9 +120,11 @@ __fortio_getnum(
     goto state6;
   goto return_integer;
 state2: /* . digit [digits] or digits . [ digits ] */
-  do {
+  c = *++cp;
+  while (ISDIGIT(c)) {
+    ACCUM_DIGIT(c, TRUE);
     c = *++cp;
-  } while (ISDIGIT(c));
+  }
   if (c == 'e' || c == 'E' || c == 'd' || c == 'D')
     goto state3;
   if (c == '+' || c == '-')
@@ -111,8 +137,10 @@ state3: /* digits [ . [ digits ] ] { e | d } */
   c = *++cp;
   if (ISDIGIT(c))
     goto state5;
-  if (c == '+' || c == '-')
+  if (c == '+' || c == '-') {
+    expo_neg = c == '-';
     goto state4;
+  }
   /*
    * VMS extension: no digits, +, or - after e or d
    */
@@ -131,6 +159,11 @@ state4: /* digits [ . [ digits ] ] { e | d } { + | - } */
   }
 
 state5: /* digits [ . [ digits ] ] { e | d } [ + | - ] digits */
+  if (expo != 0 || c != '0') {
+    /* past 4 digits __io_strtod converts it; only the count matters */
+    if (++expo_digits <= 4)
+      expo = expo * 10 + (c - '0');
+  }
   c = *++cp;
   if (ISDIGIT(c))
     goto state5;
@@ -145,6 +178,8 @@ state6: /* digits [ . [ digits ] ] { + | - } */
   do { /* scan past exponent */
     c = *++cp;
   } while (ISDIGIT(c));
+  if (buf_p == NULL)
+    buf_p = buf;
   if ((cp - currc) + 2 > buf_size) {
     buf_size = (cp - currc) + 64;
     if (buf_p != buf)
@@ -193,6 +228,10 @@ junk0:
 
 return_integer:
   *type = 0;
+  if (mant_digits <= 9 && !mant_lost && mant_expo == 0) {
+    val->i = neg ? -(__BIGINT_T)mant : (__BIGINT_T)mant;
+    goto ret;
+  }
   fcptr = NULL;
   ret_err = __fort_atoxi32(currc, &val->i, cp - currc, 10);
   if (ret_err) {
@@ -206,6 +245,10 @@ return_integer:
 
 return_real:
   *type = 1;
+  if (!mant_lost && expo_digits <= 4 &&
+      __fortio_fast_strtod(neg, mant, mant_expo + (expo_neg ? -expo : expo),
+                           &val->d))
+    goto ret;
   fcptr = NULL;
   val->d = __io_strtod(currc, &fcptr);
   if (fcptr == currc)
@@ -16,6 +16,7 @@
 #include "global.h"
 #include "feddesc.h"
 #include "format.h"
+#include "format-double.h"
 #include "fioMacros.h"
 
 #define RPSTACK_SIZE 20 /* determines max paren nesting level */
@@ -26,7 +27,7 @@ typedef struct {
   int fmtpos;
 } rpstack_struct;
 
-static rpstack_struct rpstack[RPSTACK_SIZE];
+static FIO_TLS rpstack_struct rpstack[RPSTACK_SIZE];
 
 union ieee {
   double d;
@@ -86,13 +87,13 @@ typedef struct struct_G G;
 
 #define GBL_SIZE 5
 
-static G static_gbl[GBL_SIZE];
-static G *gbl = &static_gbl[0];
-static G *gbl_head = &static_gbl[0];
-static int gbl_avl = 0;
-static int gbl_size = GBL_SIZE;
+static FIO_TLS G static_gbl[GBL_SIZE];
+static FIO_TLS G *gbl;      /* set by allocate_new_gbl() */
+static FIO_TLS G *gbl_head;
+static FIO_TLS int gbl_avl = 0;
+static FIO_TLS int gbl_size = GBL_SIZE;
 
-static int move_fwd_eor;
+static FIO_TLS int move_fwd_eor;
 
 static int fr_read(char *, int, int);
 
@@ -177,6 +178,8 @@ allocate_new_gbl()
   long obuff_len = 0;
   int eor_seen;
   int gsize = sizeof(G);
+  if (gbl_head == NULL) /* first statement on this thread */
+    gbl_head = &static_gbl[0];
   if (gbl_avl >= gbl_size) {
     if (gbl_size == GBL_SIZE) {
       gbl_size = gbl_size + GBL_SIZE;
@@ -430,7 +433,7 @@ ENTF90IO(FMTR_INITA, fmtr_inita)
       s = fr_init(unit, rec, bitv, iostat, fmt, (__INT8_T *)size, p, n);
     }
   }
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -487,7 +490,7 @@ ENTF90IO(FMTR_INIT2003A, fmtr_init2003a)
     }
     s = fr_init(unit, rec, bitv, iostat, fmt, size, p, n);
   }
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -615,7 +618,7 @@ ENTCRF90IO(FMTR_INITA, fmtr_inita)
   } else {
     s = fr_init(unit, rec, bitv, iostat, fmt, (__INT8_T *)size, p, n);
   }
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -670,7 +673,7 @@ ENTCRF90IO(FMTR_INIT2003A, fmtr_init2003a)
   }
 
   s = fr_init(unit, rec, bitv, iostat, fmt, size, p, n);
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -733,7 +736,7 @@ ENTF90IO(FMTR_INITVA, fmtr_initva)
       s = fr_init(unit, rec, bitv, iostat, *fmt, (__INT8_T *)size, p, n);
     }
   }
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -788,7 +791,7 @@ ENTF90IO(FMTR_INITV2003A, fmtr_initv2003a)
     }
     s = fr_init(unit, rec, bitv, iostat, *fmt, size, p, n);
   }
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -848,7 +851,7 @@ ENTCRF90IO(FMTR_INITVA, fmtr_initva)
   } else {
     s = fr_init(unit, rec, bitv, iostat, *fmt, (__INT8_T *)size, p, n);
   }
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -901,7 +904,7 @@ ENTCRF90IO(FMTR_INITV2003A, fmtr_initv2003a)
   }
 
   s = fr_init(unit, rec, bitv, iostat, *fmt, size, p, n);
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -1015,7 +1018,7 @@ ENTF90IO(FMTR_INTERN_INITA, fmtr_intern_inita)
   if ((GET_DIST_LCPU == GET_DIST_IOPROC) || LOCAL_MODE) {
     s = fr_intern_init(CADR(cunit), rec_num, bitv, iostat, fmt, CLEN(cunit));
   }
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -1052,7 +1055,7 @@ ENTCRF90IO(FMTR_INTERN_INITA, fmtr_intern_inita)
   int s = 0;
 
   s = fr_intern_init(CADR(cunit), rec_num, bitv, iostat, fmt, CLEN(cunit));
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -1092,7 +1095,7 @@ ENTF90IO(FMTR_INTERN_INITVA, fmtr_intern_initva)
   if ((GET_DIST_LCPU == GET_DIST_IOPROC) || LOCAL_MODE) {
     s = fr_intern_init(CADR(cunit), rec_num, bitv, iostat, *fmt, CLEN(cunit));
   }
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -1128,7 +1131,7 @@ ENTCRF90IO(FMTR_INTERN_INITVA, fmtr_intern_initva)
 {
   int s = 0;
   s = fr_intern_init(CADR(cunit), rec_num, bitv, iostat, *fmt, CLEN(cunit));
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -1169,7 +1172,7 @@ ENTF90IO(FMTR_INTERN_INITE, fmtr_intern_inite)
   if ((GET_DIST_LCPU == GET_DIST_IOPROC) || LOCAL_MODE) {
     s = fr_intern_init(*cunit, rec_num, bitv, iostat, fmt, *len);
   }
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -1191,7 +1194,7 @@ ENTCRF90IO(FMTR_INTERN_INITE, fmtr_intern_inite)
   int s = 0;
 
   s = fr_intern_init(*cunit, rec_num, bitv, iostat, fmt, *len);
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -1216,7 +1219,7 @@ ENTF90IO(FMTR_INTERN_INITEV, fmtr_intern_initev)
   if ((GET_DIST_LCPU == GET_DIST_IOPROC) || LOCAL_MODE) {
     s = fr_intern_init(*cunit, rec_num, bitv, iostat, *fmt, *len);
   }
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -1237,7 +1240,7 @@ ENTCRF90IO(FMTR_INTERN_INITEV, fmtr_intern_initev)
 {
   int s = 0;
   s = fr_intern_init(*cunit, rec_num, bitv, iostat, *fmt, *len);
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -1325,9 +1328,11 @@ __f90io_fmt_read(int type,    /* data type (as defined in pghpft.h) */
   return 0;
 
 fmtr_err:
-  free_gbl();
-  restore_gbl();
-  __fortio_errend03();
+  if (__fortio_leaves_stmt(ret_err)) {
+    free_gbl();
+    restore_gbl();
+    __fortio_errend03();
+  }
   return ret_err;
 }
 
@@ -2379,10 +2384,10 @@ fr_assign(char *item, int type, __BIGINT_T ival, DBLINT64 i8val, __BIGREAL_T dva
 
 /*  local static variables for octal/hex conversion:  */
 
-static int OZbase;
-static unsigned char *OZbuff;
-static int numbits;
-static unsigned char *buff_pos, *buff_end;
+static FIO_TLS int OZbase;
+static FIO_TLS unsigned char *OZbuff;
+static FIO_TLS int numbits;
+static FIO_TLS unsigned char *buff_pos, *buff_end;
 
 static void fr_OZconv_init(int, int);
 static void fr_OZbyte(int);
@@ -2603,7 +2608,7 @@ fr_OZreadnum(int code, char *item, int type, int item_length)
 static void
 fr_OZconv_init(int w, int sz)
 {
-  static int buff_len = 0;
+  static FIO_TLS int buff_len = 0;
   int len;
 
   if (OZbase == 16)
@@ -2990,6 +2995,27 @@ after_exponent:
   else /*if (!expflag)*/
     expval -= d;
 
+  /* Convert directly when the digits fit in 64 bits */
+  if (ipos > (buff[0] == '-')) {
+    unsigned long long mant = 0;
+    int mant_digits = 0, mant_expo = expval;
+    int k;
+    for (k = buff[0] == '-'; k < ipos; ++k) {
+      if (mant_digits < 19) {
+        mant = mant * 10 + (buff[k] - '0');
+        if (mant != 0)
+          ++mant_digits;
+      } else if (buff[k] != '0') {
+        break;
+      } else {
+        ++mant_expo;
+      }
+    }
+    if (k == ipos &&
+        __fortio_fast_strtod(buff[0] == '-', mant, mant_expo, &dval))
+      return dval;
+  }
+
   if (expval != 0) {
     buff[ipos] = 'E';
     sprintf(buff + ipos + 1, "%d", expval);
@@ -26,7 +26,7 @@ typedef struct {
   int fmtpos;
 } rpstack_struct;
 
-static rpstack_struct rpstack[RPSTACK_SIZE];
+static FIO_TLS rpstack_struct rpstack[RPSTACK_SIZE];
 
 #define INIT_BUFF_LEN 200
 
@@ -71,11 +71,11 @@ struct struct_G {
 #define GBL_SIZE 5
 typedef struct struct_G G;
 
-static G static_gbl[GBL_SIZE];
-static G *gbl = &static_gbl[0];
-static G *gbl_head = &static_gbl[0];
-static int gbl_avl = 0;
-static int gbl_size = GBL_SIZE;
+static FIO_TLS G static_gbl[GBL_SIZE];
+static FIO_TLS G *gbl;      /* set by allocate_new_gbl() */
+static FIO_TLS G *gbl_head;
+static FIO_TLS int gbl_avl = 0;
+static FIO_TLS int gbl_size = GBL_SIZE;
 
 static int fw_write(char *, int, int);
 static int fw_slashes(G *, int);
@@ -140,6 +140,8 @@ allocate_new_gbl()
   char *rec_buff = 0;
   long obuff_len = 0;
   int gsize = sizeof(G);
+  if (gbl_head == NULL) /* first statement on this thread */
+    gbl_head = &static_gbl[0];
   if (gbl_avl >= gbl_size) {
     if (gbl_size == GBL_SIZE) {
       gbl_size = gbl_size + GBL_SIZE;
@@ -360,7 +362,7 @@ ENTF90IO(FMTW_INITA, fmtw_inita)
   __fort_status_init(bitv, iostat);
   if (LOCAL_MODE || GET_DIST_LCPU == GET_DIST_IOPROC)
     s = fw_init(unit, rec, bitv, iostat, fmt, advadr, advlen);
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -432,7 +434,7 @@ ENTF90IO(FMTW_INIT03A, fmtw_init03a)
         s = __fortio_error(FIO_ESPEC);
     }
   }
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -480,7 +482,7 @@ ENTCRF90IO(FMTW_INITA, fmtw_inita)
     advlen = 0;
   }
   s = fw_init(unit, rec, bitv, iostat, fmt, advadr, advlen);
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -538,7 +540,7 @@ ENTF90IO(FMTW_INITVA, fmtw_initva)
   __fort_status_init(bitv, iostat);
   if (LOCAL_MODE || GET_DIST_LCPU == GET_DIST_IOPROC)
     s = fw_init(unit, rec, bitv, iostat, *fmt, advadr, advlen);
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -592,7 +594,7 @@ ENTCRF90IO(FMTW_INITVA, fmtw_initva)
     advlen = 0;
   }
   s = fw_init(unit, rec, bitv, iostat, *fmt, advadr, advlen);
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -686,7 +688,7 @@ ENTF90IO(FMTW_INTERN_INITA, fmtw_intern_inita)
   __fort_status_init(bitv, iostat);
   if (LOCAL_MODE || GET_DIST_LCPU == GET_DIST_IOPROC)
     s = fw_intern_init(CADR(cunit), rec_num, bitv, iostat, fmt, CLEN(cunit));
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -731,7 +733,7 @@ ENTCRF90IO(FMTW_INTERN_INITA, fmtw_intern_inita)
   g->internal_unit = CADR(cunit);
 
   s = fw_intern_init(CADR(cunit), rec_num, bitv, iostat, fmt, CLEN(cunit));
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -777,7 +779,7 @@ ENTF90IO(FMTW_INTERN_INITVA, fmtw_intern_initva)
   __fort_status_init(bitv, iostat);
   if (LOCAL_MODE || GET_DIST_LCPU == GET_DIST_IOPROC)
     s = fw_intern_init(CADR(cunit), rec_num, bitv, iostat, *fmt, CLEN(cunit));
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -821,7 +823,7 @@ ENTCRF90IO(FMTW_INTERN_INITVA, fmtw_intern_initva)
   g->internal_unit = CADR(cunit);
 
   s = fw_intern_init(CADR(cunit), rec_num, bitv, iostat, *fmt, CLEN(cunit));
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -868,7 +870,7 @@ ENTF90IO(FMTW_INTERN_INITE, fmtw_intern_inite)
   __fort_status_init(bitv, iostat);
   if (LOCAL_MODE || GET_DIST_LCPU == GET_DIST_IOPROC)
     s = fw_intern_init(*cunit, rec_num, bitv, iostat, fmt, *len);
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -898,7 +900,7 @@ ENTCRF90IO(FMTW_INTERN_INITE, fmtw_intern_inite)
   g->internal_unit = *cunit;
 
   s = fw_intern_init(*cunit, rec_num, bitv, iostat, fmt, *len);
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -930,7 +932,7 @@ ENTF90IO(FMTW_INTERN_INITEV, fmtw_intern_initev)
   __fort_status_init(bitv, iostat);
   if (LOCAL_MODE || GET_DIST_LCPU == GET_DIST_IOPROC)
     s = fw_intern_init(*cunit, rec_num, bitv, iostat, *fmt, *len);
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -960,7 +962,7 @@ ENTCRF90IO(FMTW_INTERN_INITEV, fmtw_intern_initev)
   g->internal_unit = *cunit;
 
   s = fw_intern_init(*cunit, rec_num, bitv, iostat, *fmt, *len);
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -2277,12 +2279,12 @@ fmt_mismatch:
 
 /*  local static variables for octal/hex conversion:  */
 
-static int OZbase;
+static FIO_TLS int OZbase;
 static char hextab[17] = "0123456789ABCDEF";
-static char *OZbuff;
-static int bits_left;
-static int bits; /* 0, 1 or 2 left over bits */
-static char *buff_pos;
+static FIO_TLS char *OZbuff;
+static FIO_TLS int bits_left;
+static FIO_TLS int bits; /* 0, 1 or 2 left over bits */
+static FIO_TLS char *buff_pos;
 
 static __CLEN_T fw_OZconv_init(__CLEN_T);
 static void fw_OZbyte(unsigned int);
@@ -2528,7 +2530,7 @@ fw_Bbyte(unsigned int c)
 static __CLEN_T
 fw_OZconv_init(__CLEN_T len)
 {
-  static __CLEN_T buff_len = 0;
+  static FIO_TLS __CLEN_T buff_len = 0;
 
   if (OZbase == 16)
     len += len;
@@ -542,6 +542,213 @@ fraction_digits(char buff[MAX_FRACTION_SIGNIFICANT_DECIMAL_DIGITS],
   return frac_leading_zeroes;
 }
 
+/*
+ *  Fast path for the leading significant digits of a value.  When
+ *  x == m * 2**e and the needed power of ten are small enough that
+ *  x * 10**k can be formed as a quotient of two 128-bit integers, the
+ *  digits and the exact remainder come from a single division (often just
+ *  a shift) instead of from the multiple-word loops above.  Exact.
+ */
+#if defined(__SIZEOF_INT128__)
+typedef unsigned __int128 uint128_t;
+
+static const uint64_t pow10_64[20] = {
+  1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+  10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+  100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+  100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+  100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+
+static const uint64_t pow5_64[28] = {
+  1ULL, 5ULL, 25ULL, 125ULL, 625ULL, 3125ULL, 15625ULL, 78125ULL, 390625ULL,
+  1953125ULL, 9765625ULL, 48828125ULL, 244140625ULL, 1220703125ULL,
+  6103515625ULL, 30517578125ULL, 152587890625ULL, 762939453125ULL,
+  3814697265625ULL, 19073486328125ULL, 95367431640625ULL, 476837158203125ULL,
+  2384185791015625ULL, 11920928955078125ULL, 59604644775390625ULL,
+  298023223876953125ULL, 1490116119384765625ULL, 7450580596923828125ULL
+};
+
+#define MAX_POW5_64 27
+#define MAX_POW5_128 54 /* 5**54 < 2**126 */
+
+static inline uint128_t
+pow5_128(int k)
+{
+  if (k <= MAX_POW5_64)
+    return pow5_64[k];
+  return (uint128_t) pow5_64[MAX_POW5_64] * pow5_64[k - MAX_POW5_64];
+}
+
+static inline int
+bits_128(uint128_t x)
+{
+  uint64_t hi = x >> 64;
+  if (hi)
+    return 128 - __builtin_clzll(hi);
+  return x ? 64 - __builtin_clzll((uint64_t) x) : 0;
+}
+#endif
+
+int
+__fortio_leading_digits(double x, int ndigits, unsigned long long *digits,
+                        int *expo, int *rest)
+{
+#if defined(__SIZEOF_INT128__)
+  uint64_t raw = RAW_BITS(x);
+  int biased_exponent = (raw >> EXPLICIT_MANTISSA_BITS) & RJ_EXPONENT_MASK;
+  uint64_t m = raw & MANTISSA_MASK;
+  int e, b, k, s, ex, m_bits;
+  uint128_t p5, num, den, n, r;
+
+  if (ndigits < 1 || ndigits > 19 || biased_exponent == INF_OR_NAN_EXPONENT)
+    return 0;
+  if (biased_exponent == 0) {
+    e = 1 - 1075; /* subnormal */
+  } else {
+    m |= IMPLICIT_NORMALIZED_BIT;
+    e = biased_exponent - 1075;
+  }
+  if (m == 0)
+    return 0;
+  m_bits = 64 - __builtin_clzll(m);
+
+  /* 2**b <= |x| < 2**(b+1), so 10**(ex-1) <= |x| < 10**(ex+1) */
+  b = m_bits - 1 + e;
+  if (b >= 0)
+    ex = ((b * 78913) >> 18) + 1;
+  else
+    ex = -(((-b) * 78913) >> 18);
+
+  for (;; ++ex) {
+    /* n = floor(|x| * 10**k) = floor(m * 5**k * 2**(e+k)) */
+    k = ndigits - ex;
+    if (k > MAX_POW5_128 || k < -MAX_POW5_128)
+      return 0;
+    p5 = pow5_128(k < 0 ? -k : k);
+    s = e + k;
+    if (k >= 0) {
+      num = p5 * m;
+      if (bits_128(p5) + m_bits > 128)
+        return 0;
+      if (s >= 0) {
+        if (bits_128(num) + s > 128)
+          return 0;
+        n = num << s;
+        r = 0;
+        den = 1;
+      } else {
+        if (-s > 127)
+          return 0;
+        n = num >> -s;
+        den = (uint128_t) 1 << -s;
+        r = num & (den - 1);
+      }
+    } else {
+      if (s >= 0) {
+        if (m_bits + s > 128)
+          return 0;
+        num = (uint128_t) m << s;
+        den = p5;
+      } else {
+        if (bits_128(p5) - s > 127)
+          return 0;
+        num = m;
+        den = p5 << -s;
+      }
+      n = num / den;
+      r = num - n * den;
+    }
+    if (n < pow10_64[ndigits - 1])
+      return 0; /* cannot happen */
+    if (n < pow10_64[ndigits])
+      break;
+    /* |x| >= 10**ex; one digit too many */
+  }
+
+  *digits = (uint64_t) n;
+  *expo = ex;
+  if (r == 0)
+    *rest = 0;
+  else if (r < den - r)
+    *rest = 1;
+  else if (r == den - r)
+    *rest = 2;
+  else
+    *rest = 3;
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+/* powers of ten that are exact doubles */
+static const double pow10_22[23] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static inline double
+pow2(int k)
+{
+  union raw_fp u;
+  u.i = (uint64_t) (k + 1023) << EXPLICIT_MANTISSA_BITS;
+  return u.d;
+}
+
+int
+__fortio_fast_strtod(int neg, unsigned long long w, int e, double *d)
+{
+  double x;
+
+  /* With w and 10**|e| both exact doubles, one operation rounds. */
+  if (w <= (1ULL << 53) && e >= -22 && e <= 22) {
+    x = neg ? -(double) w : (double) w;
+    *d = e < 0 ? x / pow10_22[-e] : x * pow10_22[e];
+    return 1;
+  }
+#if defined(__SIZEOF_INT128__)
+  if (w != 0 && e >= -MAX_POW5_64 && e <= MAX_POW5_128) {
+    /* Find the leading 62 or 63 bits t of w * 10**e exactly, with the
+     * last one set if anything nonzero follows, so that converting t
+     * rounds just as converting the exact value would.
+     */
+    uint128_t p5 = pow5_128(e < 0 ? -e : e), m, q;
+    int w_bits = 64 - __builtin_clzll(w), shift;
+    int64_t t;
+
+    if (e >= 0) {
+      if (w_bits + bits_128(p5) > 128)
+        return 0;
+      m = p5 * w;
+      shift = bits_128(m) - 62;
+      if (shift > 0) {
+        t = (int64_t) (m >> shift);
+        if (m & (((uint128_t) 1 << shift) - 1))
+          t |= 1;
+      } else {
+        t = (int64_t) m;
+        shift = 0;
+      }
+      shift += e;
+    } else {
+      /* 2**61 < t < 2**63 */
+      shift = 62 + bits_128(p5) - w_bits;
+      m = (uint128_t) w << shift;
+      q = m / p5;
+      t = (int64_t) q;
+      if (m - q * p5 != 0)
+        t |= 1;
+      shift = e - shift;
+    }
+    x = neg ? (double) -t : (double) t;
+    *d = x * pow2(shift);
+    return 1;
+  }
+#endif
+  return 0;
+}
+
 /*
  *  Discern the CPU's current FPCR rounding mode by the portable means
  *  of observing its effect on floating-point addition.
@@ -851,8 +1058,8 @@ ED_format(char *out_buffer, int width, const struct formatting_control *control,
 
     char buffer[MAX_INT_DECIMAL_DIGITS +
                 MAX_FRACTION_SIGNIFICANT_DECIMAL_DIGITS];
-    int int_part_digits = format_int_part(buffer, MAX_INT_DECIMAL_DIGITS, absx);
-    char *payload = buffer + MAX_INT_DECIMAL_DIGITS - int_part_digits;
+    int int_part_digits;
+    char *payload;
     int trailing_zeroes = 0;
     int ESN = control->ESN_format;
     int extra_digits = ESN == 'N' ? 3 :
@@ -868,38 +1075,54 @@ ED_format(char *out_buffer, int width, const struct formatting_control *control,
                                ESN == '\0' ? control->exponent_digits : 0;
     int expo_digits = explicit_expo_digits;
     int significant_digits = frac_digits + extra_digits - lost_digits;
-    int frac_part_digits = significant_digits - int_part_digits;
+    int frac_part_digits;
     int expo, abs_expo;
     int leading_spaces;
     bool all_digits_zero = false;
     int next_digit_for_rounding = 0, last_digit_for_rounding = 0;
     bool is_inexact = false;
+    unsigned long long leading;
+    int rest;
+
+    if (absx != 0.0 && significant_digits >= 0 &&
+        __fortio_leading_digits(absx, significant_digits + 1, &leading, &expo,
+                                &rest)) {
+      /* All the digits needed, plus the one for rounding, at once. */
+      payload = buffer + MAX_INT_DECIMAL_DIGITS;
+      reversed_uint64(payload + significant_digits, buffer, leading / 10);
+      next_digit_for_rounding = leading % 10;
+      is_inexact = rest != 0;
+    } else {
+      int_part_digits = format_int_part(buffer, MAX_INT_DECIMAL_DIGITS, absx);
+      payload = buffer + MAX_INT_DECIMAL_DIGITS - int_part_digits;
+      frac_part_digits = significant_digits - int_part_digits;
+
+      if (frac_part_digits > MAX_FRACTION_SIGNIFICANT_DECIMAL_DIGITS) {
+        trailing_zeroes = frac_part_digits -
+                          MAX_FRACTION_SIGNIFICANT_DECIMAL_DIGITS;
+        frac_part_digits = MAX_FRACTION_SIGNIFICANT_DECIMAL_DIGITS;
+      }
 
-    if (frac_part_digits > MAX_FRACTION_SIGNIFICANT_DECIMAL_DIGITS) {
-      trailing_zeroes = frac_part_digits -
-                        MAX_FRACTION_SIGNIFICANT_DECIMAL_DIGITS;
-      frac_part_digits = MAX_FRACTION_SIGNIFICANT_DECIMAL_DIGITS;
-    }
-
-    if (int_part_digits == 0) {
-      int frac_leading_zeroes = fraction_digits(payload,
-                                                &next_digit_for_rounding,
-                                                &is_inexact, frac_part_digits,
-                                                absx);
-      all_digits_zero = frac_leading_zeroes < 0;
-      expo = all_digits_zero ? 0 : -frac_leading_zeroes;
-    } else if (frac_part_digits < 0) {
-      expo = int_part_digits;
-      is_inexact = absx < MAX_EXACTLY_REPRESENTABLE_UINT64 &&
-                   absx != double_to_uint64(absx);
-      while (int_part_digits > significant_digits) {
-        is_inexact |= next_digit_for_rounding != 0;
-        next_digit_for_rounding = payload[--int_part_digits] - '0';
+      if (int_part_digits == 0) {
+        int frac_leading_zeroes = fraction_digits(payload,
+                                                  &next_digit_for_rounding,
+                                                  &is_inexact,
+                                                  frac_part_digits, absx);
+        all_digits_zero = frac_leading_zeroes < 0;
+        expo = all_digits_zero ? 0 : -frac_leading_zeroes;
+      } else if (frac_part_digits < 0) {
+        expo = int_part_digits;
+        is_inexact = absx < MAX_EXACTLY_REPRESENTABLE_UINT64 &&
+                     absx != double_to_uint64(absx);
+        while (int_part_digits > significant_digits) {
+          is_inexact |= next_digit_for_rounding != 0;
+          next_digit_for_rounding = payload[--int_part_digits] - '0';
+        }
+      } else {
+        format_fraction(payload + int_part_digits, &next_digit_for_rounding,
+                        &is_inexact, frac_part_digits, absx);
+        expo = int_part_digits;
       }
-    } else {
-      format_fraction(payload + int_part_digits, &next_digit_for_rounding,
-                      &is_inexact, frac_part_digits, absx);
-      expo = int_part_digits;
     }
 
     /* "Engineering" (EN) format: ensure that the exponent is a multiple of 3.
@@ -44,4 +44,24 @@ void __fortio_format_double(char *out, int width,
                             const struct formatting_control *control,
                             double x);
 
+/*
+ *  Exact leading decimal digits of a finite nonzero |x|, for ndigits
+ *  from 1 to 19.  On success, returns 1 and sets *digits to the first
+ *  ndigits significant digits as an integer, *expo so that
+ *  10**(*expo - 1) <= |x| < 10**(*expo), and *rest to what follows the
+ *  last digit: 0 (nothing), 1 (less than half a unit), 2 (exactly half),
+ *  or 3 (more than half).  Returns 0 when this quick method does not apply
+ *  (very large or small magnitudes, or no 128-bit integer support).
+ */
+int __fortio_leading_digits(double x, int ndigits, unsigned long long *digits,
+                            int *expo, int *rest);
+
+/*
+ *  The double nearest to (or, in the directed rounding modes, next to)
+ *  [-]w * 10**e, as strtod() would give in the current rounding mode.
+ *  Returns 1 on success and 0, leaving *d alone, when e is out of the
+ *  range this quick method covers.
+ */
+int __fortio_fast_strtod(int neg, unsigned long long w, int e, double *d);
+
 #endif /* FORMAT_DOUBLE_H_ */
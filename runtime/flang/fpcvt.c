@@ -13,6 +13,7 @@
 #include "fioMacros.h"
 #include "stdioInterf.h"
 #include "fio_fcb_flags.h"
+#include "format-double.h"
 
 /* this continues down to __io_fcvt() definition.
     we use our __io_fcvt for C90 but we can't use any of
@@ -763,11 +764,70 @@ writefmt(char *fmt, int prec, char c)
   fmt[i++] = '\0';
 }
 
+/*
+ * sprintf(tmp, "%-.<prec>E", value) for value >= 0.  The common precisions
+ * are done exactly from the binary value when the FPU rounds to nearest,
+ * which is what sprintf would then do as well.
+ */
+static int
+sprintf_e(char *tmp, char *fmt, int prec, double value)
+{
+  unsigned long long n;
+  int expo, rest, i, j;
+
+  if (prec > 17 || __fenv_fegetround() != FE_TONEAREST) {
+    writefmt(fmt, prec, 'E');
+    return sprintf(tmp, fmt, value);
+  }
+  if (value == 0) {
+    n = 0;
+    expo = 1;
+  } else if (__fortio_leading_digits(value, prec + 1, &n, &expo, &rest)) {
+    if (rest == 3 || (rest == 2 && (n & 1)))
+      ++n;
+  } else {
+    writefmt(fmt, prec, 'E');
+    return sprintf(tmp, fmt, value);
+  }
+
+  /* d.ddd...E+xx */
+  for (i = prec + 1; i > 1; --i) {
+    tmp[i] = '0' + n % 10;
+    n /= 10;
+  }
+  if (n >= 10) {
+    /* 9.99...5 rounded up to 10.0... */
+    n = 1;
+    ++expo;
+  }
+  tmp[0] = '0' + n;
+  i = prec + 2;
+  if (prec)
+    tmp[1] = '.';
+  else
+    i = 1;
+  tmp[i++] = 'E';
+  expo -= 1;
+  if (expo < 0) {
+    tmp[i++] = '-';
+    expo = -expo;
+  } else {
+    tmp[i++] = '+';
+  }
+  if (expo >= 100)
+    tmp[i++] = '0' + expo / 100;
+  j = expo % 100;
+  tmp[i++] = '0' + j / 10;
+  tmp[i++] = '0' + j % 10;
+  tmp[i] = '\0';
+  return i;
+}
+
 char *
 __fortio_ecvt(double value, int ndigit, int *decpt, int *sign, int round)
 {
-  static char buf[30]; /* WARNING: dependency on size in fmtconv.c.
-                        * look for ECVTSIZE */
+  static FIO_TLS char buf[30]; /* WARNING: dependency on size in fmtconv.c.
+                                * look for ECVTSIZE */
   char *s;
   void ufptosci();
   UFP u;
@@ -775,8 +835,8 @@ __fortio_ecvt(double value, int ndigit, int *decpt, int *sign, int round)
 
   union ieee ieee_v;
 
-  static char tmp[512];
-  static char fmt[16];
+  static FIO_TLS char tmp[512];
+  static FIO_TLS char fmt[16];
   int idx, fexp, kdz, engfmt;
   int i0, i1;
 
@@ -826,8 +886,7 @@ __fortio_ecvt(double value, int ndigit, int *decpt, int *sign, int round)
   /* Compatible rounding, or compatible in number of good bits??? */
 
   if (round == FIO_COMPATIBLE) {
-      writefmt(fmt, ndigit, 'E');
-      j = sprintf(tmp, fmt, value);
+      j = sprintf_e(tmp, fmt, ndigit, value);
       if (ndigit) {
         i0 = 1;
         tmp[i0] = tmp[0];
@@ -856,8 +915,7 @@ __fortio_ecvt(double value, int ndigit, int *decpt, int *sign, int round)
 
         /* We know sprintf is rounded, so get more bits */
         if (tmp[i1] == '5') {
-          writefmt(fmt, ndigit + 20, 'E');
-          j = sprintf(tmp, fmt, value);
+          j = sprintf_e(tmp, fmt, ndigit + 20, value);
           i0 = 1;
           tmp[i0] = tmp[0];
         }
@@ -889,8 +947,7 @@ __fortio_ecvt(double value, int ndigit, int *decpt, int *sign, int round)
          Turns out that sprintf is nearest
       */
       if (ndigit) {
-        writefmt(fmt, ndigit - 1, 'E');
-        j = sprintf(tmp, fmt, value);
+        j = sprintf_e(tmp, fmt, ndigit - 1, value);
         if (ndigit > 1) {
           i0 = 1;
           tmp[i0] = tmp[0];
@@ -916,8 +973,7 @@ __fortio_ecvt(double value, int ndigit, int *decpt, int *sign, int round)
           i1 = i0 + ndigit;
           if (tmp[i1] == '5') {
             /* Use sprintf to round again */
-            writefmt(fmt, ndigit - 1, 'E');
-            j = sprintf(tmp, fmt, value);
+            j = sprintf_e(tmp, fmt, ndigit - 1, value);
             if (ndigit > 1) {
               i0 = 1;
               tmp[i0] = tmp[0];
@@ -976,8 +1032,7 @@ __fortio_ecvt(double value, int ndigit, int *decpt, int *sign, int round)
          Round Down:
          Lop everything extra off.
       */
-      writefmt(fmt, ndigit, 'E');
-      j = sprintf(tmp, fmt, value);
+      j = sprintf_e(tmp, fmt, ndigit, value);
       i0 = 1;
       tmp[i0] = tmp[0];
       i = ndigit + 4;
@@ -1000,8 +1055,7 @@ __fortio_ecvt(double value, int ndigit, int *decpt, int *sign, int round)
       if (ndigit) {
         i = ndigit + 1;
         if (tmp[i] == '0') {
-          writefmt(fmt, ndigit + 20, 'E');
-          j = sprintf(tmp, fmt, value);
+          j = sprintf_e(tmp, fmt, ndigit + 20, value);
           i0 = 1;
           tmp[i0] = tmp[0];
         }
@@ -1027,8 +1081,7 @@ __fortio_ecvt(double value, int ndigit, int *decpt, int *sign, int round)
          If we find a character other than 9, add 1 and we're done
          If we went all the way, make tmp[0] 1, and return that.
       */
-      writefmt(fmt, ndigit, 'E');
-      j = sprintf(tmp, fmt, value);
+      j = sprintf_e(tmp, fmt, ndigit, value);
       i0 = 1;
       tmp[i0] = tmp[0];
       i = ndigit + 4;
@@ -1051,8 +1104,7 @@ __fortio_ecvt(double value, int ndigit, int *decpt, int *sign, int round)
       i = ndigit + 1;
       if (ndigit) {
         if (tmp[i] == '0') {
-          writefmt(fmt, ndigit + 20, 'E');
-          j = sprintf(tmp, fmt, value);
+          j = sprintf_e(tmp, fmt, ndigit + 20, value);
           i0 = 1;
           tmp[i0] = tmp[0];
           tmp[ndigit + 21] = '\0';
@@ -1105,8 +1157,8 @@ __fortio_fcvt(__BIGREAL_T v, int prec, int sf, int *decpt, int *sign, int round)
 {
 
   union ieee ieee_v;
-  static char tmp[512];
-  static char fmt[16];
+  static FIO_TLS char tmp[512];
+  static FIO_TLS char fmt[16];
   int idx, fexp, nexp, kdz, ldz;
   int i, j, i0, i1;
 
@@ -1641,7 +1693,7 @@ __fortio_lldecvt(int num[4], int ndigit, int *decpt, int *sign)
   char b1[512];
   char *c;
   int e;
-  static char b2[512];
+  static FIO_TLS char b2[512];
 
   if (ndigit <= 0) {
     *sign = 0;
@@ -2992,13 +3044,13 @@ edivm(USHORT *den, USHORT *num)
  * Input "rcntrl" is the rounding control.
  */
 
-static int rlast = -1;
-static int rw = 0;
-static USHORT rmsk = 0;
-static USHORT rmbit = 0;
-static USHORT rebit = 0;
-static int re = 0;
-static USHORT rbit[NI] = {0, 0, 0, 0, 0, 0, 0, 0};
+static FIO_TLS int rlast = -1;
+static FIO_TLS int rw = 0;
+static FIO_TLS USHORT rmsk = 0;
+static FIO_TLS USHORT rmbit = 0;
+static FIO_TLS USHORT rebit = 0;
+static FIO_TLS int re = 0;
+static FIO_TLS USHORT rbit[NI] = {0, 0, 0, 0, 0, 0, 0, 0};
 
 void
 emdnorm(USHORT *s, int lost, int subflg, INT exp, int rcntrl)
@@ -3175,7 +3227,7 @@ static void eadd1(USHORT *a, USHORT *b, USHORT *c);
  * esub( a, b, c );      c = b - a
  */
 
-static int subflg = 0;
+static FIO_TLS int subflg = 0;
 
 void
 esub(USHORT *a, USHORT *b, USHORT *c)
@@ -12,6 +12,7 @@
 #include "fioMacros.h"
 #include "stdioInterf.h" /* stubbed version of stdio.h */
 #include "cnfg.h" /* declarations for configuration items */
+#include "komp.h"
 
 #define GBL_SIZE_T_FORMAT "zu"
 
@@ -166,6 +167,7 @@ extern char *strcpy();
 #define FIO_EPOS 256
 #define FIO_EPOSV 257
 #define FIO_ENEWUNIT 258
+#define FIO_EDEADLOCK 259
 
 #define FIRST_NEWUNIT -13 /* newunits are less than or equal to  this  */
 #define ILLEGAL_UNIT(u) \
@@ -259,6 +261,7 @@ typedef struct fcb {
   sbool native;       /* unformatted data is in native format */
   sbool asy_rw;       /* async read/write stmt active */
   struct asy *asyptr; /* pointer to asynch information,set by open */
+  struct dirmap *mapptr; /* mapping of a direct access file, set by open */
   char *pread;        /* points to buffer of already read line
                        * this is currently used in namelist only
                        * record is read per line, we must point back
@@ -267,6 +270,13 @@ typedef struct fcb {
   char *pback;        /* need to keep track of the last line read
                        * used in nmlread too.
                        */
+  /* lock, gen and owner must stay last: __fortio_alloc_fcb() clears only
+   * the fields before them since another thread may still be waiting for
+   * a unit that used this FCB before.
+   */
+  omp_nest_lock_t lock; /* held for the duration of an i/o statement */
+  unsigned int gen;     /* incremented when the FCB is freed */
+  struct fcb **owner;   /* what the thread holding lock waits for (csect.c) */
 } FIO_FCB;
 
 /*
@@ -301,8 +311,8 @@ typedef struct atag {
 
 /*  declare global variables for Fortran I/O:  */
 
+/* state of the current i/o statement, one copy per thread */
 typedef struct {
-  FIO_FCB *fcbs; /* pointer to list of allocated fcbs */
   INT *enctab;   /* pointer to buffer w encoded format */
   char *fname;   /* file name for OPEN error messages */
   int fnamelen;
@@ -310,18 +320,20 @@ typedef struct {
   bool eof;
   bool pos_present;
   seekoffx_t pos;
+  bool asy_write; /* statement is an asynchronous unformatted write */
 } FIO_TBL;
 
 /*  declare external variables/arrays used by Fortran I/O:  */
 
 #include <errno.h>
 
-extern FIO_TBL fioFcbTbls;
+extern FIO_TLS FIO_TBL fioFcbTbls;
+extern FIO_FCB *fioFcbs; /* pointer to list of allocated fcbs */
 #ifdef WINNT
 extern FIO_FCB *__get_fio_fcbs(void);
 #define GET_FIO_FCBS __get_fio_fcbs()
 #else
-#define GET_FIO_FCBS fioFcbTbls.fcbs
+#define GET_FIO_FCBS fioFcbs
 
 #endif
 
@@ -348,6 +360,15 @@ extern char *__fortio_fcvt(__BIGREAL_T, int, int, int *, int *, int);
 WIN_MSVCRT_IMP double WIN_CDECL strtod(const char *, char **);
 #define __fortio_strtod(x, y) strtod(x, y)
 
+/*****  csect.c  *****/
+extern void __fortio_lock_fcbs(void);
+extern void __fortio_unlock_fcbs(void);
+extern void __fortio_hold_fcbs(void);
+extern int __fortio_lock_fcb(FIO_FCB *);
+extern bool __fortio_trylock_fcb(FIO_FCB *);
+extern void __fortio_unlock_fcb(FIO_FCB *);
+extern FIO_FCB *__fortio_held_unit(int);
+
 /*****  error.c  *****/
 extern VOID set_gbl_newunit(bool newunit);
 extern bool get_gbl_newunit();
@@ -356,6 +377,7 @@ extern VOID __fortio_errinit03(__INT_T unit, __INT_T bitv, __INT_T *iostat,
                                char *str);
 extern VOID __fortio_errend(void);
 extern VOID __fortio_errend03(void);
+extern bool __fortio_leaves_stmt(int);
 extern int f90_old_huge_rec_fmt(void);
 extern int __fortio_error(int);
 extern int __fortio_eoferr(int);
@@ -20,7 +20,7 @@
 #define access _access
 #endif
 
-static FIO_FCB *f2; /* save fcb for inquire2 */
+static FIO_TLS FIO_FCB *f2; /* save fcb for inquire2 */
 
 static void copystr(char *dst, /*  destination string, blank-filled */
                     int len,   /*  length of destination space */
@@ -76,10 +76,22 @@ inquire(__INT_T *unit, char *file_ptr, __INT_T *bitv, __INT_T *iostat,
       len = 0;
       f = NULL;
     } else {
-      for (f = fioFcbTbls.fcbs; f; f = f->next)
+      int u = 0;
+      __fortio_lock_fcbs();
+      for (f = fioFcbs; f; f = f->next)
         if (len == strlen(f->name) &&
             strncmp(file_ptr + nleadb, f->name, len) == 0)
           break;
+      if (f != NULL)
+        u = f->unit;
+      __fortio_unlock_fcbs();
+      /* look up the unit again to lock it; it may have changed meanwhile */
+      if (f != NULL) {
+        f = __fortio_find_unit(u);
+        if (f != NULL && (len != strlen(f->name) ||
+                          strncmp(file_ptr + nleadb, f->name, len) != 0))
+          f = NULL;
+      }
     }
   } else { /*  inquire by unit  */
     if (ILLEGAL_UNIT(*unit)) {
@@ -33,23 +33,23 @@ static int read_record(void);
 static char *alloc_rbuf(int, bool);
 static int skip_record(void);
 
-static FIO_FCB *fcb;  /* fcb of external file */
-static bool accessed; /* file has been read */
-static int byte_cnt;  /* number of bytes read */
-static int n_irecs;   /* number of internal file records */
-static bool internal_file;
-static int rec_len;
+static FIO_TLS FIO_FCB *fcb;  /* fcb of external file */
+static FIO_TLS bool accessed; /* file has been read */
+static FIO_TLS int byte_cnt;  /* number of bytes read */
+static FIO_TLS int n_irecs;   /* number of internal file records */
+static FIO_TLS bool internal_file;
+static FIO_TLS int rec_len;
 
-static int gbl_dtype; /* data type of item (global to local funcs) */
+static FIO_TLS int gbl_dtype; /* data type of item (global to local funcs) */
 
 #define RBUF_SIZE 256
-static char rbuf[RBUF_SIZE + 1];
-static unsigned rbuf_size = RBUF_SIZE;
+static FIO_TLS char rbuf[RBUF_SIZE + 1];
+static FIO_TLS unsigned rbuf_size = RBUF_SIZE;
 
-static char *rbufp = rbuf; /* ptr to read buffer */
-static char *currc;        /* current pointer in buffer */
+static FIO_TLS char *rbufp;        /* ptr to read buffer */
+static FIO_TLS char *currc;        /* current pointer in buffer */
 
-static char *in_recp; /* internal i/o record (user's space) */
+static FIO_TLS char *in_recp; /* internal i/o record (user's space) */
 
 struct struct_G {
   short blank_zero; /* FIO_ ZERO or NULL */
@@ -85,11 +85,11 @@ struct struct_G {
 
 typedef struct struct_G G;
 
-static G static_gbl[GBL_SIZE];
-static G *gbl = &static_gbl[0];
-static G *gbl_head = &static_gbl[0];
-static int gbl_avl = 0;
-static int gbl_size = GBL_SIZE;
+static FIO_TLS G static_gbl[GBL_SIZE];
+static FIO_TLS G *gbl;      /* set by allocate_new_gbl() */
+static FIO_TLS G *gbl_head;
+static FIO_TLS int gbl_avl = 0;
+static FIO_TLS int gbl_size = GBL_SIZE;
 
 union ieee {
   double d;
@@ -113,6 +113,7 @@ union ieee {
 static void shared_init(void);
 static void get_token(void);
 static void get_number(void);
+static bool get_value_fast(char *, int);
 static void get_cmplx(void);
 static void get_infinity(void);
 static void get_nan(void);
@@ -122,14 +123,14 @@ static void get_junk(void);
 static bool skip_spaces(void);
 static bool find_char(int);
 
-static AVAL tknval; /* TK_VAL value returned by get_token */
-static int tkntyp;
-static int scan_err;
+static FIO_TLS AVAL tknval; /* TK_VAL value returned by get_token */
+static FIO_TLS int tkntyp;
+static FIO_TLS int scan_err;
 
 /*  Initial state for a READ statement  */
-static int repeat_cnt;
-static int prev_tkntyp;
-static bool comma_seen;
+static FIO_TLS int repeat_cnt;
+static FIO_TLS int prev_tkntyp;
+static FIO_TLS bool comma_seen;
 
 static void
 save_gbl()
@@ -254,6 +255,10 @@ allocate_new_gbl()
 {
   G *tmp_gbl;
   int gsize = sizeof(G);
+  if (gbl_head == NULL) { /* first statement on this thread */
+    gbl_head = &static_gbl[0];
+    rbufp = rbuf;
+  }
   if (gbl_avl >= gbl_size) {
     if (gbl_size == GBL_SIZE) {
       gbl_size = gbl_size + GBL_SIZE;
@@ -385,7 +390,7 @@ ENTF90IO(LDR_INIT, ldr_init)
   __fort_status_init(bitv, iostat);
   if (LOCAL_MODE || GET_DIST_LCPU == GET_DIST_IOPROC)
     s = _f90io_ldr_init(unit, rec, bitv, iostat);
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -446,7 +451,7 @@ ENTF90IO(LDR_INIT03A, ldr_init03a)
         s = __fortio_error(FIO_ESPEC);
     }
   }
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -474,7 +479,7 @@ ENTCRF90IO(LDR_INIT, ldr_init)
 {
   int s = 0;
   s = _f90io_ldr_init(unit, rec, bitv, iostat);
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -658,6 +663,8 @@ __f90io_ldr(int type,    /* data type (as defined in pghpft.h) */
   tmpitem = item;
   gbl_dtype = type;
   for (item_num = 0; item_num < length; item_num++, tmpitem += stride) {
+    if (get_value_fast(tmpitem, type))
+      continue;
     get_token();
     if (tkntyp == TK_SLASH)
       return 0;
@@ -684,9 +691,11 @@ __f90io_ldr(int type,    /* data type (as defined in pghpft.h) */
   return 0;
 
 ldr_err:
-  free_gbl();
-  restore_gbl();
-  __fortio_errend03();
+  if (__fortio_leaves_stmt(ret_err)) {
+    free_gbl();
+    restore_gbl();
+    __fortio_errend03();
+  }
   return (ret_err);
 }
 
@@ -1191,6 +1200,82 @@ is_repeat_count(char *p)
   return 0;
 }
 
+/** \brief
+ * Read a plain number into a numeric item without going through
+ * get_token() and __fortio_assign().
+ *
+ * Handles the common case of an optional comma and blanks followed by an
+ * integer, or a real for a real item.  Returns FALSE, having changed
+ * nothing, for anything else: repeat counts, null values, a slash, the end
+ * of the record, or a decimal comma.
+ */
+static bool
+get_value_fast(char *item, int type)
+{
+  char *p;
+  int ntype, len;
+  union {
+    __BIGINT_T i;
+    __BIGREAL_T d;
+    __INT8_T i8v;
+  } val;
+  char c;
+
+  if (repeat_cnt || gbl->decimal == FIO_COMMA)
+    return FALSE;
+  switch (type) {
+  case __INT4:
+  case __INT8:
+  case __REAL4:
+  case __REAL8:
+    break;
+  default:
+    return FALSE;
+  }
+
+  p = currc;
+  while (*p == ' ' || *p == '\t')
+    ++p;
+  if (*p == ',' && !comma_seen) {
+    ++p;
+    while (*p == ' ' || *p == '\t')
+      ++p;
+  }
+  c = *p;
+  if (!ISDIGIT(c) &&
+      !((c == '-' || c == '+' || c == '.') && ISDIGIT(p[1])))
+    return FALSE;
+  if (__fortio_getnum(p, &ntype, &val, &len, FALSE) != 0 || p[len] == '*')
+    return FALSE;
+
+  if (ntype == 0) {
+    switch (type) {
+    case __INT4:
+      *(__INT4_T *)item = val.i;
+      break;
+    case __INT8:
+      *(__INT8_T *)item = val.i;
+      break;
+    case __REAL4:
+      *(__REAL4_T *)item = (__REAL4_T)(__BIGREAL_T)val.i;
+      break;
+    case __REAL8:
+      *(__REAL8_T *)item = (__BIGREAL_T)val.i;
+      break;
+    }
+  } else if (ntype == 1 && type == __REAL4) {
+    *(__REAL4_T *)item = (__REAL4_T)val.d;
+  } else if (ntype == 1 && type == __REAL8) {
+    *(__REAL8_T *)item = val.d;
+  } else {
+    return FALSE;
+  }
+  currc = p + len;
+  comma_seen = FALSE;
+  prev_tkntyp = tkntyp = TK_VAL;
+  return TRUE;
+}
+
 /** \brief
  * Extract integer, real, or double precision constant token:
  */
@@ -1250,7 +1335,7 @@ get_number(void)
 static void
 get_cmplx(void)
 {
-  static AVAL cmplx[2] = {{__BIGREAL, {0}}, {__BIGREAL, {0}}};
+  static FIO_TLS AVAL cmplx[2] = {{__BIGREAL, {0}}, {__BIGREAL, {0}}};
 
   get_token();
   if (tkntyp != TK_VAL || tknval.dtype == __STR || tknval.dtype == __NCHAR)
@@ -1423,9 +1508,9 @@ to_bigreal(AVAL *valp)
 
 /*  stuff for returning a string token */
 
-static char chval[128];
-static int chval_size = sizeof(chval);
-static char *chvalp = chval;
+static FIO_TLS char chval[128];
+static FIO_TLS int chval_size = sizeof(chval);
+static FIO_TLS char *chvalp; /* NULL until first used on this thread */
 
 /** \brief
  * A quote has been seen (' or ").  Create a character constant.
@@ -1436,6 +1521,8 @@ get_qstr(int quote)
   int len;
   char ch;
 
+  if (chvalp == NULL)
+    chvalp = chval;
   len = 0;
   while (TRUE) {
     ch = *currc++;
@@ -1478,6 +1565,8 @@ get_junk(void)
   int len;
   char ch;
 
+  if (chvalp == NULL)
+    chvalp = chval;
   len = 0;
   while (TRUE) {
     ch = *currc++;
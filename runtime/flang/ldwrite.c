@@ -21,21 +21,21 @@ static int dbgflag;
 #undef DBGBIT
 #define DBGBIT(v) (LOCAL_DEBUG && (dbgflag & v))
 
-static FIO_FCB *fcb; /* fcb of external file */
+static FIO_TLS FIO_FCB *fcb; /* fcb of external file */
 
-static char *in_recp; /* internal i/o record (user's space) */
-static char *in_curp; /* current position in internal i/o record */
+static FIO_TLS char *in_recp; /* internal i/o record (user's space) */
+static FIO_TLS char *in_curp; /* current position in internal i/o record */
 
-static bool record_written; /* only used for writes to an external file */
-static int byte_cnt;
-static int rec_len;
-static int n_irecs;         /* number of records in internal file */
-static bool write_called;   /* __f90io_ldw called at least once (extern file)*/
-static bool internal_file;  /* TRUE if writing to internal file */
-static char *internal_unit; /* base address of internal file buffer */
-static char delim;          /* delimiter character if DELIM was specified */
+static FIO_TLS bool record_written; /* only used for writes to an external file */
+static FIO_TLS int byte_cnt;
+static FIO_TLS int rec_len;
+static FIO_TLS int n_irecs;         /* number of records in internal file */
+static FIO_TLS bool write_called;   /* __f90io_ldw called at least once (extern file)*/
+static FIO_TLS bool internal_file;  /* TRUE if writing to internal file */
+static FIO_TLS char *internal_unit; /* base address of internal file buffer */
+static FIO_TLS char delim;          /* delimiter character if DELIM was specified */
 
-static int last_type; /* last data type written */
+static FIO_TLS int last_type; /* last data type written */
 
 struct struct_G {
   short decimal; /* COMMA, POINT, NONE */
@@ -64,11 +64,11 @@ struct struct_G {
 #define GBL_SIZE 5
 typedef struct struct_G G;
 
-static G static_gbl[GBL_SIZE];
-static G *gbl = &static_gbl[0];
-static G *gbl_head = &static_gbl[0];
-static int gbl_avl = 0;
-static int gbl_size = GBL_SIZE;
+static FIO_TLS G static_gbl[GBL_SIZE];
+static FIO_TLS G *gbl;      /* set by allocate_new_gbl() */
+static FIO_TLS G *gbl_head;
+static FIO_TLS int gbl_avl = 0;
+static FIO_TLS int gbl_size = GBL_SIZE;
 
 /* local functions */
 
@@ -135,6 +135,8 @@ allocate_new_gbl()
 {
   G *tmp_gbl;
   int gsize = sizeof(G);
+  if (gbl_head == NULL) /* first statement on this thread */
+    gbl_head = &static_gbl[0];
   if (gbl_avl >= gbl_size) {
     if (gbl_size == GBL_SIZE) {
       gbl_size = gbl_size + 15;
@@ -247,7 +249,7 @@ ENTF90IO(LDW_INIT, ldw_init)
   if (LOCAL_MODE || GET_DIST_LCPU == GET_DIST_IOPROC)
     s = _f90io_ldw_init(unit, rec, bitv, iostat);
   gbl->internal_file = FALSE;
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -268,7 +270,7 @@ ENTF90IO(PRINT_INIT, print_init)
   if (LOCAL_MODE || GET_DIST_LCPU == GET_DIST_IOPROC)
     s = _f90io_ldw_init(unit, rec, bitv, iostat);
   gbl->internal_file = FALSE;
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -287,7 +289,7 @@ ENTCRF90IO(LDW_INIT, ldw_init)
   internal_file = FALSE;
   s = _f90io_ldw_init(unit, rec, bitv, iostat);
   gbl->internal_file = FALSE;
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -306,7 +308,7 @@ ENTCRF90IO(PRINT_INIT, print_init)
   internal_file = FALSE;
   s = _f90io_ldw_init(unit, rec, bitv, iostat);
   gbl->internal_file = FALSE;
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -359,7 +361,7 @@ ENTF90IO(LDW_INIT03A, ldw_init03a)
     }
   }
 init03_end:
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -432,7 +434,7 @@ ENTF90IO(LDW_INTERN_INITA, ldw_intern_inita)
     s = _f90io_ldw_intern_init(CADR(cunit), rec_num, bitv, iostat, CLEN(cunit));
   gbl->internal_file = internal_file;
   gbl->internal_unit = internal_unit;
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -472,7 +474,7 @@ ENTCRF90IO(LDW_INTERN_INITA, ldw_intern_inita)
   s = _f90io_ldw_intern_init(CADR(cunit), rec_num, bitv, iostat, CLEN(cunit));
   gbl->internal_file = internal_file;
   gbl->internal_unit = internal_unit;
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -515,7 +517,7 @@ ENTF90IO(LDW_INTERN_INITE, ldw_intern_inite)
     s = _f90io_ldw_intern_init(*cunit, rec_num, bitv, iostat, *len);
   gbl->internal_file = internal_file;
   gbl->internal_unit = internal_unit;
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -541,7 +543,7 @@ ENTCRF90IO(LDW_INTERN_INITE, ldw_intern_inite)
   s = _f90io_ldw_intern_init(*cunit, rec_num, bitv, iostat, *len);
   gbl->internal_file = internal_file;
   gbl->internal_unit = internal_unit;
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -553,7 +555,7 @@ ENTCRF90IO(LDW_INTERN_INITE, ldw_intern_inite)
 /*   list-directed write   */
 /* *************************/
 
-extern char __f90io_conv_buf[];
+extern FIO_TLS char __f90io_conv_buf[];
 
 int
 __f90io_ldw(int type,    /* data type (as defined in pghpft.h) */
@@ -650,9 +652,11 @@ __f90io_ldw(int type,    /* data type (as defined in pghpft.h) */
   return 0;
 
 ldw_error:
-  free_gbl();
-  restore_gbl();
-  __fortio_errend03();
+  if (__fortio_leaves_stmt(ret_err)) {
+    free_gbl();
+    restore_gbl();
+    __fortio_errend03();
+  }
   return (ret_err);
 }
 
@@ -8,6 +8,12 @@
  * \brief Matrix multiplication routines
  */
 
+/** \brief Minimum number of multiplications (n*m*k) for which a contiguous
+ *  MATMUL uses the packed, cache-blocked engine in mmul_gemm.c rather than
+ *  the unblocked loops.  Keep in sync with mmul_dir.h.
+ */
+#define MMUL_GEMM_MIN_MULT 100000
+
 void f90_mm_cplx16_str1_mxv_(__CPLX16_T *, __CPLX16_T *, __CPLX16_T *,
                                __INT_T *, __INT_T *, __INT_T *, __INT_T *);
 void f90_mm_cplx16_str1_vxm_(__CPLX16_T *, __CPLX16_T *, __CPLX16_T *,
@@ -79,3 +85,16 @@ void f90_mm_real8_str1_(__REAL8_T *, __REAL8_T *, __REAL8_T *, __INT_T *,
                           __INT_T *);
 void f90_mm_real8_str1_mxv_t_(__REAL8_T *, __REAL8_T *, __REAL8_T *,
                                 __INT_T *, __INT_T *, __INT_T *, __INT_T *);
+
+void F90_MATMUL(real4_gemm)(__REAL4_T *, __REAL4_T *, __REAL4_T *, __INT_T *,
+                            __INT_T *, __INT_T *, __INT_T *, __INT_T *,
+                            __INT_T *);
+void F90_MATMUL(real8_gemm)(__REAL8_T *, __REAL8_T *, __REAL8_T *, __INT_T *,
+                            __INT_T *, __INT_T *, __INT_T *, __INT_T *,
+                            __INT_T *);
+void F90_MATMUL(cplx8_gemm)(__CPLX8_T *, __CPLX8_T *, __CPLX8_T *, __INT_T *,
+                            __INT_T *, __INT_T *, __INT_T *, __INT_T *,
+                            __INT_T *);
+void F90_MATMUL(cplx16_gemm)(__CPLX16_T *, __CPLX16_T *, __CPLX16_T *,
+                             __INT_T *, __INT_T *, __INT_T *, __INT_T *,
+                             __INT_T *, __INT_T *);
@@ -9,6 +9,7 @@
 
 #include "stdioInterf.h"
 #include "fioMacros.h"
+#include "mmul_par.h"
 #include "complex.h"
 #include "mthdecls.h"
 
@@ -16,6 +17,46 @@
 #define SMALL_ROWSB 10
 #define SMALL_COLSB 10
 
+/* One column slice [lo, hi) of the blocked multiply, so that large products
+ * can be split across the mmul_par.c worker pool.
+ */
+struct mm_cmplx16_args {
+  int tindex;
+  __POINT_T mra, kab, lda, ldb, ldc;
+  DOUBLE_COMPLEX_TYPE *alpha, *a, *b, *beta, *c;
+};
+
+static void
+mm_cmplx16_cols(void *arg, long lo, long hi)
+{
+  struct mm_cmplx16_args *p = arg;
+  __POINT_T ncb = hi - lo;
+  /* op(b) is b or its transpose; column lo of op(b) starts at b(1,lo+1) or
+   * b(lo+1,1) accordingly */
+  DOUBLE_COMPLEX_TYPE *b = p->b + ((p->tindex & 2) ? lo : lo * p->ldb);
+  DOUBLE_COMPLEX_TYPE *c = p->c + lo * p->ldc;
+  void ftn_mnaxnb_cmplx16_(), ftn_mnaxtb_cmplx16_();
+  void ftn_mtaxnb_cmplx16_(), ftn_mtaxtb_cmplx16_();
+
+  switch (p->tindex) {
+  case 0:
+    ftn_mnaxnb_cmplx16_(&p->mra, &ncb, &p->kab, p->alpha, p->a, &p->lda, b,
+                        &p->ldb, p->beta, c, &p->ldc);
+    break;
+  case 1:
+    ftn_mtaxnb_cmplx16_(&p->mra, &ncb, &p->kab, p->alpha, p->a, &p->lda, b,
+                        &p->ldb, p->beta, c, &p->ldc);
+    break;
+  case 2:
+    ftn_mnaxtb_cmplx16_(&p->mra, &ncb, &p->kab, p->alpha, p->a, &p->lda, b,
+                        &p->ldb, p->beta, c, &p->ldc);
+    break;
+  case 3:
+    ftn_mtaxtb_cmplx16_(&p->mra, &ncb, &p->kab, p->alpha, p->a, &p->lda, b,
+                        &p->ldb, p->beta, c, &p->ldc);
+  }
+}
+
 void ENTF90(MMUL_CMPLX16,
             mmul_cmplx16)(int ta, int tb, __POINT_T mra, __POINT_T ncb,
                           __POINT_T kab, DOUBLE_COMPLEX_TYPE *alpha,
@@ -57,12 +98,11 @@ void ENTF90(MMUL_CMPLX16,
   int bufr, bufc, loc, lor;
   int small_size = SMALL_ROWSA * SMALL_ROWSB * SMALL_COLSB;
   int tindex = 0;
+  struct mm_cmplx16_args args;
   DOUBLE_COMPLEX_TYPE buffera[SMALL_ROWSA * SMALL_ROWSB];
   DOUBLE_COMPLEX_TYPE bufferb[SMALL_COLSB * SMALL_ROWSB];
   DOUBLE_COMPLEX_TYPE temp;
   void ftn_mvmul_cmplx16_(), ftn_vmmul_cmplx16_();
-  void ftn_mnaxnb_cmplx16_(), ftn_mnaxtb_cmplx16_();
-  void ftn_mtaxnb_cmplx16_(), ftn_mtaxtb_cmplx16_();
   DOUBLE_COMPLEX_TYPE calpha, cbeta;
   /*
    * Small matrix multiply variables
@@ -528,23 +568,19 @@ void ENTF90(MMUL_CMPLX16,
       tindex--;
     if (tb == 0)
       tindex -= 2;
-    switch (tindex) {
-    case 0:
-      ftn_mnaxnb_cmplx16_(&mra, &ncb, &kab, alpha, a, &lda, b, &ldb,
-                            beta, c, &ldc);
-      break;
-    case 1:
-      ftn_mtaxnb_cmplx16_(&mra, &ncb, &kab, alpha, a, &lda, b, &ldb,
-                            beta, c, &ldc);
-      break;
-    case 2:
-      ftn_mnaxtb_cmplx16_(&mra, &ncb, &kab, alpha, a, &lda, b, &ldb,
-                            beta, c, &ldc);
-      break;
-    case 3:
-      ftn_mtaxtb_cmplx16_(&mra, &ncb, &kab, alpha, a, &lda, b, &ldb,
-                            beta, c, &ldc);
-    }
+    args.tindex = tindex;
+    args.mra = mra;
+    args.kab = kab;
+    args.lda = lda;
+    args.ldb = ldb;
+    args.ldc = ldc;
+    args.alpha = alpha;
+    args.a = a;
+    args.b = b;
+    args.beta = beta;
+    args.c = c;
+    __fort_mmul_par(__fort_mmul_nthreads((double)mra * ncb * kab),
+                    mm_cmplx16_cols, &args, ncb, 4);
   }
 
 }
@@ -11,11 +11,52 @@
 
 #include "stdioInterf.h"
 #include "fioMacros.h"
+#include "mmul_par.h"
 
 #define SMALL_ROWSA 10
 #define SMALL_ROWSB 10
 #define SMALL_COLSB 10
 
+/* One column slice [lo, hi) of the blocked multiply, so that large products
+ * can be split across the mmul_par.c worker pool.
+ */
+struct mm_real8_args {
+  int tindex;
+  __POINT_T mra, kab, lda, ldb, ldc;
+  double *alpha, *a, *b, *beta, *c;
+};
+
+static void
+mm_real8_cols(void *arg, long lo, long hi)
+{
+  struct mm_real8_args *p = arg;
+  __POINT_T ncb = hi - lo;
+  /* op(b) is b or its transpose; column lo of op(b) starts at b(1,lo+1) or
+   * b(lo+1,1) accordingly */
+  double *b = p->b + ((p->tindex & 2) ? lo : lo * p->ldb);
+  double *c = p->c + lo * p->ldc;
+  void ftn_mnaxnb_real8_(), ftn_mnaxtb_real8_();
+  void ftn_mtaxnb_real8_(), ftn_mtaxtb_real8_();
+
+  switch (p->tindex) {
+  case 0:
+    ftn_mnaxnb_real8_(&p->mra, &ncb, &p->kab, p->alpha, p->a, &p->lda, b,
+                      &p->ldb, p->beta, c, &p->ldc);
+    break;
+  case 1:
+    ftn_mtaxnb_real8_(&p->mra, &ncb, &p->kab, p->alpha, p->a, &p->lda, b,
+                      &p->ldb, p->beta, c, &p->ldc);
+    break;
+  case 2:
+    ftn_mnaxtb_real8_(&p->mra, &ncb, &p->kab, p->alpha, p->a, &p->lda, b,
+                      &p->ldb, p->beta, c, &p->ldc);
+    break;
+  case 3:
+    ftn_mtaxtb_real8_(&p->mra, &ncb, &p->kab, p->alpha, p->a, &p->lda, b,
+                      &p->ldb, p->beta, c, &p->ldc);
+  }
+}
+
 void ENTF90(MMUL_REAL8, mmul_real8)(int ta, int tb, __POINT_T mra,
                                     __POINT_T ncb, __POINT_T kab, double *alpha,
                                     double a[], __POINT_T lda, double b[],
@@ -57,12 +98,11 @@ void ENTF90(MMUL_REAL8, mmul_real8)(int ta, int tb, __POINT_T mra,
   int bufr, bufc, loc, lor;
   int small_size = SMALL_ROWSA * SMALL_ROWSB * SMALL_COLSB;
   int tindex = 0;
+  struct mm_real8_args args;
   double buffera[SMALL_ROWSA * SMALL_ROWSB];
   double bufferb[SMALL_COLSB * SMALL_ROWSB];
   double temp;
   void ftn_mvmul_real8_(), ftn_vmmul_real8_();
-  void ftn_mnaxnb_real8_(), ftn_mnaxtb_real8_();
-  void ftn_mtaxnb_real8_(), ftn_mtaxtb_real8_();
   double calpha, cbeta;
   /*
    * Small matrix multiply variables
@@ -323,23 +363,19 @@ void ENTF90(MMUL_REAL8, mmul_real8)(int ta, int tb, __POINT_T mra,
       }
     }
   } else {
-    switch (tindex) {
-    case 0:
-      ftn_mnaxnb_real8_(&mra, &ncb, &kab, alpha, a, &lda, b, &ldb, beta, c,
-                          &ldc);
-      break;
-    case 1:
-      ftn_mtaxnb_real8_(&mra, &ncb, &kab, alpha, a, &lda, b, &ldb, beta, c,
-                          &ldc);
-      break;
-    case 2:
-      ftn_mnaxtb_real8_(&mra, &ncb, &kab, alpha, a, &lda, b, &ldb, beta, c,
-                          &ldc);
-      break;
-    case 3:
-      ftn_mtaxtb_real8_(&mra, &ncb, &kab, alpha, a, &lda, b, &ldb, beta, c,
-                          &ldc);
-    }
+    args.tindex = tindex;
+    args.mra = mra;
+    args.kab = kab;
+    args.lda = lda;
+    args.ldb = ldb;
+    args.ldc = ldc;
+    args.alpha = alpha;
+    args.a = a;
+    args.b = b;
+    args.beta = beta;
+    args.c = c;
+    __fort_mmul_par(__fort_mmul_nthreads((double)mra * ncb * kab),
+                    mm_real8_cols, &args, ncb, 4);
   }
 
 }
@@ -10,11 +10,16 @@
 #define PREFIX(x) f90##x
 #define _PREFIX(x) _f90##x
 
+! Minimum number of multiplications for the contiguous MATMUL routines to
+! use the blocked engine in mmul_gemm.c; keep in sync with matmul.h.
+#define MMUL_GEMM_MIN_MULT 100000
+
 #ifdef DESC_I8
 #define DESC_INT INTEGER(8)
 #define F90_matmul_cplx16_contmxm	PREFIX(_mm_cplx16_contmxm_i8)
 #define F90_matmul_cplx16_contmxv	PREFIX(_mm_cplx16_contmxv_i8)
 #define F90_matmul_cplx16_contvxm	PREFIX(_mm_cplx16_contvxm_i8)
+#define F90_matmul_cplx16_gemm		PREFIX(_mm_cplx16_gemm_i8)
 #define F90_matmul_cplx16_str1		PREFIX(_mm_cplx16_str1_i8)
 #define F90_matmul_cplx16_str1_mxv	PREFIX(_mm_cplx16_str1_mxv_i8)
 #define F90_matmul_cplx16_str1_mxv_t	PREFIX(_mm_cplx16_str1_mxv_t_i8)
@@ -27,6 +32,7 @@
 #define F90_matmul_cplx8_contmxm	PREFIX(_mm_cplx8_contmxm_i8)
 #define F90_matmul_cplx8_contmxv	PREFIX(_mm_cplx8_contmxv_i8)
 #define F90_matmul_cplx8_contvxm	PREFIX(_mm_cplx8_contvxm_i8)
+#define F90_matmul_cplx8_gemm		PREFIX(_mm_cplx8_gemm_i8)
 #define F90_matmul_cplx8_str1		PREFIX(_mm_cplx8_str1_i8)
 #define F90_matmul_cplx8_str1_mxv	PREFIX(_mm_cplx8_str1_mxv_i8)
 #define F90_matmul_cplx8_str1_mxv_t	PREFIX(_mm_cplx8_str1_mxv_t_i8)
@@ -74,6 +80,7 @@
 #define F90_matmul_real4_contmxm	PREFIX(_mm_real4_contmxm_i8)
 #define F90_matmul_real4_contmxv	PREFIX(_mm_real4_contmxv_i8)
 #define F90_matmul_real4_contvxm	PREFIX(_mm_real4_contvxm_i8)
+#define F90_matmul_real4_gemm		PREFIX(_mm_real4_gemm_i8)
 #define F90_matmul_real4_str1		PREFIX(_mm_real4_str1_i8)
 #define F90_matmul_real4_str1_mxv	PREFIX(_mm_real4_str1_mxv_i8)
 #define F90_matmul_real4_str1_mxv_t	PREFIX(_mm_real4_str1_mxv_t_i8)
@@ -82,6 +89,7 @@
 #define F90_matmul_real8_contmxm	PREFIX(_mm_real8_contmxm_i8)
 #define F90_matmul_real8_contmxv	PREFIX(_mm_real8_contmxv_i8)
 #define F90_matmul_real8_contvxm	PREFIX(_mm_real8_contvxm_i8)
+#define F90_matmul_real8_gemm		PREFIX(_mm_real8_gemm_i8)
 #define F90_matmul_real8_str1		PREFIX(_mm_real8_str1_i8)
 #define _F90_matmul_real8_str1a		_PREFIX(_mm_real8_str1a_i8)
 #define _F90_matmul_real8_str1b		_PREFIX(_mm_real8_str1b_i8)
@@ -94,6 +102,7 @@
 #define F90_matmul_cplx16_contmxm	PREFIX(_mm_cplx16_contmxm)
 #define F90_matmul_cplx16_contmxv	PREFIX(_mm_cplx16_contmxv)
 #define F90_matmul_cplx16_contvxm	PREFIX(_mm_cplx16_contvxm)
+#define F90_matmul_cplx16_gemm		PREFIX(_mm_cplx16_gemm)
 #define F90_matmul_cplx16_str1		PREFIX(_mm_cplx16_str1)
 #define F90_matmul_cplx16_str1_mxv	PREFIX(_mm_cplx16_str1_mxv)
 #define F90_matmul_cplx16_str1_mxv_t	PREFIX(_mm_cplx16_str1_mxv_t)
@@ -106,6 +115,7 @@
 #define F90_matmul_cplx8_contmxm	PREFIX(_mm_cplx8_contmxm)
 #define F90_matmul_cplx8_contmxv	PREFIX(_mm_cplx8_contmxv)
 #define F90_matmul_cplx8_contvxm	PREFIX(_mm_cplx8_contvxm)
+#define F90_matmul_cplx8_gemm		PREFIX(_mm_cplx8_gemm)
 #define F90_matmul_cplx8_str1		PREFIX(_mm_cplx8_str1)
 #define F90_matmul_cplx8_str1_mxv	PREFIX(_mm_cplx8_str1_mxv)
 #define F90_matmul_cplx8_str1_mxv_t	PREFIX(_mm_cplx8_str1_mxv_t)
@@ -153,6 +163,7 @@
 #define F90_matmul_real4_contmxm	PREFIX(_mm_real4_contmxm)
 #define F90_matmul_real4_contmxv	PREFIX(_mm_real4_contmxv)
 #define F90_matmul_real4_contvxm	PREFIX(_mm_real4_contvxm)
+#define F90_matmul_real4_gemm		PREFIX(_mm_real4_gemm)
 #define F90_matmul_real4_str1		PREFIX(_mm_real4_str1)
 #define F90_matmul_real4_str1_mxv	PREFIX(_mm_real4_str1_mxv)
 #define F90_matmul_real4_str1_mxv_t	PREFIX(_mm_real4_str1_mxv_t)
@@ -161,6 +172,7 @@
 #define F90_matmul_real8_contmxm	PREFIX(_mm_real8_contmxm)
 #define F90_matmul_real8_contmxv	PREFIX(_mm_real8_contmxv)
 #define F90_matmul_real8_contvxm	PREFIX(_mm_real8_contvxm)
+#define F90_matmul_real8_gemm		PREFIX(_mm_real8_gemm)
 #define F90_matmul_real8_str1		PREFIX(_mm_real8_str1)
 #define _F90_matmul_real8_str1a		_PREFIX(_mm_real8_str1a)
 #define _F90_matmul_real8_str1b		_PREFIX(_mm_real8_str1b)
@@ -0,0 +1,476 @@
+/*
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+ * See https://llvm.org/LICENSE.txt for license information.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+/* clang-format off */
+
+/** \file
+ * \brief Cache-blocked, packed matrix multiply for contiguous MATMUL
+ *
+ * The engine follows the usual packed GEMM structure.  The second operand
+ * is packed into an L3-sized panel of NR-wide column slivers, the first
+ * operand into an L2-sized block of MR-tall row slivers, and an MR x NR
+ * register-tiled micro-kernel walks the packed data with unit stride.
+ * Packing pads partial slivers with zeros so the micro-kernel always runs
+ * the full tile; only the store back to the result is clipped.
+ *
+ * For REAL*4 and REAL*8 the micro-kernel is written with vector types, and
+ * on x86-64 an AVX2/FMA variant is selected once at run time when the
+ * processor supports it.  The complex kernels are register tiled but
+ * scalar.
+ *
+ * All entries compute dest(n,k) = s1(n,m) * s2(m,k), with the same argument
+ * order as the F90_MATMUL(*_str1) routines; the leading dimensions of the
+ * three column-major operands are passed explicitly.  Large products are
+ * split into column slices of dest (row slices when dest has few columns)
+ * and run on the mmul_par.c worker pool.
+ */
+
+#include "stdioInterf.h"
+#include "fioMacros.h"
+#include "matmul.h"
+#include "mmul_par.h"
+
+#if defined(TARGET_X8664) && (defined(__GNUC__) || defined(__clang__))
+#define GEMM_X86_DISPATCH
+#endif
+
+typedef float gemm_v8sf __attribute__((vector_size(32)));
+typedef double gemm_v4df __attribute__((vector_size(32)));
+
+/* Block sizes: KC x NR slivers of s2 stay in L1, an MC x KC block of s1
+ * stays in L2, and a KC x NC panel of s2 stays in L3.
+ */
+#define R4_MR 16
+#define R4_NR 4
+#define R4_MC 256
+#define R4_KC 256
+#define R4_NC 4096
+
+#define R8_MR 8
+#define R8_NR 4
+#define R8_MC 128
+#define R8_KC 256
+#define R8_NC 2048
+
+#define C8_MR 4
+#define C8_NR 2
+#define C8_MC 128
+#define C8_KC 256
+#define C8_NC 1024
+
+#define C16_MR 4
+#define C16_NR 2
+#define C16_MC 64
+#define C16_KC 256
+#define C16_NC 1024
+
+#define GEMM_ALIGN 64
+#define GEMM_MIN(a, b) ((a) < (b) ? (a) : (b))
+
+/* ------------------------------------------------------------------------ */
+/* packing */
+
+/* Pack an mc x kc block of a (leading dimension lda) into MR-tall row
+ * slivers, each stored column by column.
+ */
+#define GEMM_PACK_A(NAME, T, MR, ZERO)                                         \
+  static void NAME(long mc, long kc, const T *a, long lda, T *pa)              \
+  {                                                                            \
+    long i, ii, p;                                                             \
+    for (ii = 0; ii < mc; ii += MR) {                                          \
+      long mr = GEMM_MIN(MR, mc - ii);                                         \
+      const T *ap = a + ii;                                                    \
+      for (p = 0; p < kc; ++p) {                                               \
+        for (i = 0; i < mr; ++i)                                               \
+          pa[i] = ap[i];                                                       \
+        for (; i < MR; ++i)                                                    \
+          pa[i] = ZERO;                                                        \
+        pa += MR;                                                              \
+        ap += lda;                                                             \
+      }                                                                        \
+    }                                                                          \
+  }
+
+/* Pack a kc x nc panel of b (leading dimension ldb) into NR-wide column
+ * slivers, each stored row by row.
+ */
+#define GEMM_PACK_B(NAME, T, NR, ZERO)                                         \
+  static void NAME(long kc, long nc, const T *b, long ldb, T *pb)              \
+  {                                                                            \
+    long j, jj, p;                                                             \
+    for (jj = 0; jj < nc; jj += NR) {                                          \
+      long nr = GEMM_MIN(NR, nc - jj);                                         \
+      const T *bp = b + jj * ldb;                                              \
+      for (p = 0; p < kc; ++p) {                                               \
+        for (j = 0; j < nr; ++j)                                               \
+          pb[j] = bp[p + j * ldb];                                             \
+        for (; j < NR; ++j)                                                    \
+          pb[j] = ZERO;                                                        \
+        pb += NR;                                                              \
+      }                                                                        \
+    }                                                                          \
+  }
+
+static const __CPLX8_T cplx8_zero = {0, 0};
+static const __CPLX16_T cplx16_zero = {0, 0};
+
+GEMM_PACK_A(pack_a_real4, __REAL4_T, R4_MR, 0)
+GEMM_PACK_B(pack_b_real4, __REAL4_T, R4_NR, 0)
+GEMM_PACK_A(pack_a_real8, __REAL8_T, R8_MR, 0)
+GEMM_PACK_B(pack_b_real8, __REAL8_T, R8_NR, 0)
+GEMM_PACK_A(pack_a_cplx8, __CPLX8_T, C8_MR, cplx8_zero)
+GEMM_PACK_B(pack_b_cplx8, __CPLX8_T, C8_NR, cplx8_zero)
+GEMM_PACK_A(pack_a_cplx16, __CPLX16_T, C16_MR, cplx16_zero)
+GEMM_PACK_B(pack_b_cplx16, __CPLX16_T, C16_NR, cplx16_zero)
+
+/* ------------------------------------------------------------------------ */
+/* micro-kernels */
+
+/* Real MR x NR kernel, MR = 2 vectors, NR = 4.  The kc-long product of an
+ * A sliver and a B sliver is accumulated in eight vector registers and then
+ * stored to (or, when accum is set, added into) the mr x nr corner of c.
+ */
+#define GEMM_REAL_KERNEL(NAME, ATTR, T, VT, VL)                                \
+  static ATTR void NAME(long kc, const T *pa, const T *pb, T *c, long ldc,     \
+                        int accum, long mr, long nr)                           \
+  {                                                                            \
+    VT c00 = {0}, c01 = {0}, c02 = {0}, c03 = {0};                             \
+    VT c10 = {0}, c11 = {0}, c12 = {0}, c13 = {0};                             \
+    VT a0, a1, t;                                                              \
+    T tile[4][2 * VL];                                                         \
+    long i, j, p;                                                              \
+                                                                               \
+    for (p = 0; p < kc; ++p) {                                                 \
+      a0 = *(const VT *)pa;                                                    \
+      a1 = *(const VT *)(pa + VL);                                             \
+      c00 += a0 * pb[0];                                                       \
+      c10 += a1 * pb[0];                                                       \
+      c01 += a0 * pb[1];                                                       \
+      c11 += a1 * pb[1];                                                       \
+      c02 += a0 * pb[2];                                                       \
+      c12 += a1 * pb[2];                                                       \
+      c03 += a0 * pb[3];                                                       \
+      c13 += a1 * pb[3];                                                       \
+      pa += 2 * VL;                                                            \
+      pb += 4;                                                                 \
+    }                                                                          \
+                                                                               \
+    if (mr == 2 * VL && nr == 4) {                                             \
+      VT *cv[4][2];                                                            \
+      cv[0][0] = &c00; cv[0][1] = &c10;                                        \
+      cv[1][0] = &c01; cv[1][1] = &c11;                                        \
+      cv[2][0] = &c02; cv[2][1] = &c12;                                        \
+      cv[3][0] = &c03; cv[3][1] = &c13;                                        \
+      for (j = 0; j < 4; ++j) {                                                \
+        T *cp = c + j * ldc;                                                   \
+        if (accum) {                                                           \
+          memcpy(&t, cp, sizeof(VT));                                          \
+          *cv[j][0] += t;                                                      \
+          memcpy(&t, cp + VL, sizeof(VT));                                     \
+          *cv[j][1] += t;                                                      \
+        }                                                                      \
+        memcpy(cp, cv[j][0], sizeof(VT));                                      \
+        memcpy(cp + VL, cv[j][1], sizeof(VT));                                 \
+      }                                                                        \
+      return;                                                                  \
+    }                                                                          \
+                                                                               \
+    memcpy(&tile[0][0], &c00, sizeof(VT));                                     \
+    memcpy(&tile[0][VL], &c10, sizeof(VT));                                    \
+    memcpy(&tile[1][0], &c01, sizeof(VT));                                     \
+    memcpy(&tile[1][VL], &c11, sizeof(VT));                                    \
+    memcpy(&tile[2][0], &c02, sizeof(VT));                                     \
+    memcpy(&tile[2][VL], &c12, sizeof(VT));                                    \
+    memcpy(&tile[3][0], &c03, sizeof(VT));                                     \
+    memcpy(&tile[3][VL], &c13, sizeof(VT));                                    \
+    for (j = 0; j < nr; ++j) {                                                 \
+      T *cp = c + j * ldc;                                                     \
+      for (i = 0; i < mr; ++i)                                                 \
+        cp[i] = accum ? cp[i] + tile[j][i] : tile[j][i];                       \
+    }                                                                          \
+  }
+
+/* Complex MR x NR kernel, MR = 4, NR = 2, with separate real and imaginary
+ * accumulators.
+ */
+#define GEMM_CPLX_KERNEL(NAME, T, RT, MR, NR)                                  \
+  static void NAME(long kc, const T *pa, const T *pb, T *c, long ldc,          \
+                   int accum, long mr, long nr)                                \
+  {                                                                            \
+    RT cr[NR][MR], ci[NR][MR];                                                 \
+    long i, j, p;                                                              \
+                                                                               \
+    for (j = 0; j < NR; ++j)                                                   \
+      for (i = 0; i < MR; ++i)                                                 \
+        cr[j][i] = ci[j][i] = 0;                                               \
+    for (p = 0; p < kc; ++p) {                                                 \
+      for (j = 0; j < NR; ++j) {                                               \
+        RT br = pb[j].r;                                                       \
+        RT bi = pb[j].i;                                                       \
+        for (i = 0; i < MR; ++i) {                                             \
+          cr[j][i] += pa[i].r * br - pa[i].i * bi;                             \
+          ci[j][i] += pa[i].r * bi + pa[i].i * br;                             \
+        }                                                                      \
+      }                                                                        \
+      pa += MR;                                                                \
+      pb += NR;                                                                \
+    }                                                                          \
+    for (j = 0; j < nr; ++j) {                                                 \
+      T *cp = c + j * ldc;                                                     \
+      for (i = 0; i < mr; ++i) {                                               \
+        if (accum) {                                                           \
+          cp[i].r += cr[j][i];                                                 \
+          cp[i].i += ci[j][i];                                                 \
+        } else {                                                               \
+          cp[i].r = cr[j][i];                                                  \
+          cp[i].i = ci[j][i];                                                  \
+        }                                                                      \
+      }                                                                        \
+    }                                                                          \
+  }
+
+GEMM_REAL_KERNEL(kernel_real4, , __REAL4_T, gemm_v8sf, 8)
+GEMM_REAL_KERNEL(kernel_real8, , __REAL8_T, gemm_v4df, 4)
+#if defined(GEMM_X86_DISPATCH)
+GEMM_REAL_KERNEL(kernel_real4_avx2, __attribute__((target("avx2,fma"))),
+                 __REAL4_T, gemm_v8sf, 8)
+GEMM_REAL_KERNEL(kernel_real8_avx2, __attribute__((target("avx2,fma"))),
+                 __REAL8_T, gemm_v4df, 4)
+#endif
+GEMM_CPLX_KERNEL(kernel_cplx8, __CPLX8_T, __REAL4_T, C8_MR, C8_NR)
+GEMM_CPLX_KERNEL(kernel_cplx16, __CPLX16_T, __REAL8_T, C16_MR, C16_NR)
+
+/* ------------------------------------------------------------------------ */
+/* kernel selection */
+
+typedef void (*gemm_kernel_real4)(long, const __REAL4_T *, const __REAL4_T *,
+                                  __REAL4_T *, long, int, long, long);
+typedef void (*gemm_kernel_real8)(long, const __REAL8_T *, const __REAL8_T *,
+                                  __REAL8_T *, long, int, long, long);
+
+static gemm_kernel_real4 sel_real4;
+static gemm_kernel_real8 sel_real8;
+
+/* Choose the micro-kernels once; the race on first use is benign since
+ * every thread computes the same answer.
+ */
+static void
+select_kernels(void)
+{
+  gemm_kernel_real4 k4 = kernel_real4;
+  gemm_kernel_real8 k8 = kernel_real8;
+
+#if defined(GEMM_X86_DISPATCH)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    k4 = kernel_real4_avx2;
+    k8 = kernel_real8_avx2;
+  }
+#endif
+  sel_real8 = k8;
+  sel_real4 = k4;
+}
+
+/* ------------------------------------------------------------------------ */
+/* drivers */
+
+/* Plain triple loop, used only when the packing buffers cannot be
+ * allocated.
+ */
+#define GEMM_SIMPLE(NAME, T, MULADD, ZERO)                                     \
+  static void NAME(long n, long m, long k, const T *a, long lda, const T *b,   \
+                   long ldb, T *c, long ldc)                                   \
+  {                                                                            \
+    long i, j, p;                                                              \
+    for (j = 0; j < k; ++j) {                                                  \
+      T *cp = c + j * ldc;                                                     \
+      for (i = 0; i < n; ++i)                                                  \
+        cp[i] = ZERO;                                                          \
+      for (p = 0; p < m; ++p) {                                                \
+        const T *ap = a + p * lda;                                             \
+        T bv = b[p + j * ldb];                                                 \
+        for (i = 0; i < n; ++i)                                                \
+          MULADD(cp[i], ap[i], bv);                                            \
+      }                                                                        \
+    }                                                                          \
+  }
+
+#define REAL_MULADD(c, a, b) (c) += (a) * (b)
+#define CPLX_MULADD(c, a, b)                                                   \
+  do {                                                                         \
+    (c).r += (a).r * (b).r - (a).i * (b).i;                                    \
+    (c).i += (a).r * (b).i + (a).i * (b).r;                                    \
+  } while (0)
+
+GEMM_SIMPLE(simple_real4, __REAL4_T, REAL_MULADD, 0)
+GEMM_SIMPLE(simple_real8, __REAL8_T, REAL_MULADD, 0)
+GEMM_SIMPLE(simple_cplx8, __CPLX8_T, CPLX_MULADD, cplx8_zero)
+GEMM_SIMPLE(simple_cplx16, __CPLX16_T, CPLX_MULADD, cplx16_zero)
+
+/* c(n,k) = a(n,m) * b(m,k).  The packing buffers are sized for the
+ * problem, not the maximum block, so small operands don't pay for a full
+ * panel.
+ */
+#define GEMM_DRIVER(NAME, T, MR, NR, MC, KC, NC, PACKA, PACKB, KERNEL, SIMPLE) \
+  static void NAME(long n, long m, long k, const T *a, long lda, const T *b,   \
+                   long ldb, T *c, long ldc)                                   \
+  {                                                                            \
+    long mcmax = GEMM_MIN(MC, (n + MR - 1) / MR * MR);                         \
+    long kcmax = GEMM_MIN(KC, m);                                              \
+    long ncmax = GEMM_MIN(NC, (k + NR - 1) / NR * NR);                         \
+    size_t asz = (size_t)mcmax * kcmax * sizeof(T);                            \
+    size_t bsz = (size_t)kcmax * ncmax * sizeof(T);                            \
+    char *buf;                                                                 \
+    T *pa, *pb;                                                                \
+    long jc, pc, ic, jr, ir;                                                   \
+                                                                               \
+    if (n <= 0 || k <= 0)                                                      \
+      return;                                                                  \
+    if (m <= 0) {                                                              \
+      SIMPLE(n, m, k, a, lda, b, ldb, c, ldc);                                 \
+      return;                                                                  \
+    }                                                                          \
+    buf = __fort_malloc_without_abort(asz + bsz + 2 * GEMM_ALIGN);             \
+    if (buf == NULL) {                                                         \
+      SIMPLE(n, m, k, a, lda, b, ldb, c, ldc);                                 \
+      return;                                                                  \
+    }                                                                          \
+    pa = (T *)(((size_t)buf + GEMM_ALIGN - 1) & ~(size_t)(GEMM_ALIGN - 1));    \
+    pb = (T *)(((size_t)((char *)pa + asz) + GEMM_ALIGN - 1) &                 \
+               ~(size_t)(GEMM_ALIGN - 1));                                     \
+                                                                               \
+    for (jc = 0; jc < k; jc += NC) {                                           \
+      long nc = GEMM_MIN(NC, k - jc);                                          \
+      for (pc = 0; pc < m; pc += KC) {                                         \
+        long kc = GEMM_MIN(KC, m - pc);                                        \
+        PACKB(kc, nc, b + pc + jc * ldb, ldb, pb);                             \
+        for (ic = 0; ic < n; ic += MC) {                                       \
+          long mc = GEMM_MIN(MC, n - ic);                                      \
+          PACKA(mc, kc, a + ic + pc * lda, lda, pa);                           \
+          for (jr = 0; jr < nc; jr += NR) {                                    \
+            for (ir = 0; ir < mc; ir += MR) {                                  \
+              KERNEL(kc, pa + ir * kc, pb + jr * kc,                           \
+                     c + (ic + ir) + (jc + jr) * ldc, ldc, pc != 0,            \
+                     GEMM_MIN(MR, mc - ir), GEMM_MIN(NR, nc - jr));            \
+            }                                                                  \
+          }                                                                    \
+        }                                                                      \
+      }                                                                        \
+    }                                                                          \
+    __fort_free(buf);                                                          \
+  }
+
+GEMM_DRIVER(gemm_real4, __REAL4_T, R4_MR, R4_NR, R4_MC, R4_KC, R4_NC,
+            pack_a_real4, pack_b_real4, sel_real4, simple_real4)
+GEMM_DRIVER(gemm_real8, __REAL8_T, R8_MR, R8_NR, R8_MC, R8_KC, R8_NC,
+            pack_a_real8, pack_b_real8, sel_real8, simple_real8)
+GEMM_DRIVER(gemm_cplx8, __CPLX8_T, C8_MR, C8_NR, C8_MC, C8_KC, C8_NC,
+            pack_a_cplx8, pack_b_cplx8, kernel_cplx8, simple_cplx8)
+GEMM_DRIVER(gemm_cplx16, __CPLX16_T, C16_MR, C16_NR, C16_MC, C16_KC, C16_NC,
+            pack_a_cplx16, pack_b_cplx16, kernel_cplx16, simple_cplx16)
+
+/* ------------------------------------------------------------------------ */
+/* thread-parallel slicing */
+
+struct gemm_slice {
+  long n, m, k;
+  const void *a, *b;
+  void *c;
+  long lda, ldb, ldc;
+  int by_rows;
+};
+
+#define GEMM_SLICE(NAME, T, DRIVER)                                            \
+  static void NAME(void *arg, long lo, long hi)                                \
+  {                                                                            \
+    struct gemm_slice *s = arg;                                                \
+    if (s->by_rows)                                                            \
+      DRIVER(hi - lo, s->m, s->k, (const T *)s->a + lo, s->lda,                \
+             (const T *)s->b, s->ldb, (T *)s->c + lo, s->ldc);                 \
+    else                                                                       \
+      DRIVER(s->n, s->m, hi - lo, (const T *)s->a, s->lda,                     \
+             (const T *)s->b + lo * s->ldb, s->ldb, (T *)s->c + lo * s->ldc,   \
+             s->ldc);                                                          \
+  }
+
+GEMM_SLICE(slice_real4, __REAL4_T, gemm_real4)
+GEMM_SLICE(slice_real8, __REAL8_T, gemm_real8)
+GEMM_SLICE(slice_cplx8, __CPLX8_T, gemm_cplx8)
+GEMM_SLICE(slice_cplx16, __CPLX16_T, gemm_cplx16)
+
+/* Slice on columns of c when there are enough of them to give every thread
+ * at least one NR-wide sliver, otherwise on rows in multiples of MR.
+ */
+static void
+gemm_par(mmul_par_fn fn, long mr, long nr, long n, long m, long k,
+         const void *a, long lda, const void *b, long ldb, void *c, long ldc)
+{
+  struct gemm_slice s;
+  int nthreads = __fort_mmul_nthreads((double)n * m * k);
+
+  s.n = n;
+  s.m = m;
+  s.k = k;
+  s.a = a;
+  s.b = b;
+  s.c = c;
+  s.lda = lda;
+  s.ldb = ldb;
+  s.ldc = ldc;
+  s.by_rows = k < nthreads * nr && n > k;
+  if (s.by_rows)
+    __fort_mmul_par(nthreads, fn, &s, n, mr);
+  else
+    __fort_mmul_par(nthreads, fn, &s, k, nr);
+}
+
+/* ------------------------------------------------------------------------ */
+/* Fortran-callable entries */
+
+void
+F90_MATMUL(real4_gemm)(__REAL4_T *dest, __REAL4_T *s1, __REAL4_T *s2,
+                       __INT_T *k_extent, __INT_T *m_extent,
+                       __INT_T *n_extent, __INT_T *s1_ld, __INT_T *s2_ld,
+                       __INT_T *d_ld)
+{
+  if (sel_real4 == NULL)
+    select_kernels();
+  gemm_par(slice_real4, R4_MR, R4_NR, *n_extent, *m_extent, *k_extent, s1,
+           *s1_ld, s2, *s2_ld, dest, *d_ld);
+}
+
+void
+F90_MATMUL(real8_gemm)(__REAL8_T *dest, __REAL8_T *s1, __REAL8_T *s2,
+                       __INT_T *k_extent, __INT_T *m_extent,
+                       __INT_T *n_extent, __INT_T *s1_ld, __INT_T *s2_ld,
+                       __INT_T *d_ld)
+{
+  if (sel_real8 == NULL)
+    select_kernels();
+  gemm_par(slice_real8, R8_MR, R8_NR, *n_extent, *m_extent, *k_extent, s1,
+           *s1_ld, s2, *s2_ld, dest, *d_ld);
+}
+
+void
+F90_MATMUL(cplx8_gemm)(__CPLX8_T *dest, __CPLX8_T *s1, __CPLX8_T *s2,
+                       __INT_T *k_extent, __INT_T *m_extent,
+                       __INT_T *n_extent, __INT_T *s1_ld, __INT_T *s2_ld,
+                       __INT_T *d_ld)
+{
+  gemm_par(slice_cplx8, C8_MR, C8_NR, *n_extent, *m_extent, *k_extent, s1,
+           *s1_ld, s2, *s2_ld, dest, *d_ld);
+}
+
+void
+F90_MATMUL(cplx16_gemm)(__CPLX16_T *dest, __CPLX16_T *s1, __CPLX16_T *s2,
+                        __INT_T *k_extent, __INT_T *m_extent,
+                        __INT_T *n_extent, __INT_T *s1_ld, __INT_T *s2_ld,
+                        __INT_T *d_ld)
+{
+  gemm_par(slice_cplx16, C16_MR, C16_NR, *n_extent, *m_extent, *k_extent, s1,
+           *s1_ld, s2, *s2_ld, dest, *d_ld);
+}
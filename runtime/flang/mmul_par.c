@@ -0,0 +1,193 @@
+/*
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+ * See https://llvm.org/LICENSE.txt for license information.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+/* clang-format off */
+
+/** \file
+ * \brief Worker pool for thread-parallel MATMUL
+ *
+ * Large matrix multiplies called from serial code split their result into
+ * column (or row) slices and hand them to a small pool of persistent
+ * threads.  Inside an OpenMP parallel region the program's own threads are
+ * already busy, so the multiply stays serial there.  Only one multiply uses
+ * the pool at a time; a concurrent caller simply runs serially.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include "stdioInterf.h"
+#include "komp.h"
+#include "mmul_par.h"
+
+/* Multiply-adds each thread should get before splitting pays off. */
+#define MMUL_PAR_MIN_WORK 4.0e6
+#define MMUL_PAR_MAX_THREADS 256
+
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_start = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t pool_finish = PTHREAD_COND_INITIALIZER;
+
+static int pool_workers;        /* worker threads started */
+static int pool_active;         /* workers currently running slices */
+static int pool_busy;           /* a multiply owns the pool */
+static unsigned long pool_gen;  /* bumped for every job */
+static int pool_atfork;         /* fork handler registered */
+static int max_threads = -1;
+
+static struct {
+  mmul_par_fn fn;
+  void *arg;
+  long n;
+  long chunk;
+  int nparts;
+  int next; /* next slice to hand out */
+} job;
+
+static void
+run_slices(void)
+{
+  int part;
+  long lo, hi;
+
+  while ((part = __sync_fetch_and_add(&job.next, 1)) < job.nparts) {
+    lo = part * job.chunk;
+    hi = lo + job.chunk < job.n ? lo + job.chunk : job.n;
+    job.fn(job.arg, lo, hi);
+  }
+}
+
+static void *
+worker(void *gen)
+{
+  unsigned long seen = (unsigned long)gen;
+
+  pthread_mutex_lock(&pool_lock);
+  for (;;) {
+    while (pool_gen == seen)
+      pthread_cond_wait(&pool_start, &pool_lock);
+    seen = pool_gen;
+    ++pool_active;
+    pthread_mutex_unlock(&pool_lock);
+
+    run_slices();
+
+    pthread_mutex_lock(&pool_lock);
+    if (--pool_active == 0)
+      pthread_cond_broadcast(&pool_finish);
+  }
+  return NULL;
+}
+
+/* The workers do not survive fork(); start over in the child. */
+static void
+pool_child(void)
+{
+  pthread_mutex_init(&pool_lock, NULL);
+  pthread_cond_init(&pool_start, NULL);
+  pthread_cond_init(&pool_finish, NULL);
+  pool_workers = 0;
+  pool_active = 0;
+  pool_busy = 0;
+}
+
+/* Called with pool_lock held. */
+static void
+start_workers(int n)
+{
+  pthread_attr_t attr;
+  pthread_t tid;
+
+  if (pool_workers >= n)
+    return;
+  if (!pool_atfork) {
+    if (pthread_atfork(NULL, NULL, pool_child) != 0)
+      return;
+    pool_atfork = 1;
+  }
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  while (pool_workers < n) {
+    if (pthread_create(&tid, &attr, worker, (void *)pool_gen) != 0)
+      break;
+    ++pool_workers;
+  }
+  pthread_attr_destroy(&attr);
+}
+
+int
+__fort_mmul_nthreads(double work)
+{
+  const char *p;
+  int n;
+
+  if (max_threads < 0) {
+    p = getenv("F90_MATMUL_THREADS");
+    n = p ? atoi(p) : omp_get_max_threads();
+    if (n < 1)
+      n = 1;
+    if (n > MMUL_PAR_MAX_THREADS)
+      n = MMUL_PAR_MAX_THREADS;
+    max_threads = n;
+  }
+  if (max_threads <= 1 || work < 2 * MMUL_PAR_MIN_WORK)
+    return 1;
+  if (pool_busy || omp_in_parallel())
+    return 1;
+  n = work / MMUL_PAR_MIN_WORK > max_threads ? max_threads
+                                             : (int)(work / MMUL_PAR_MIN_WORK);
+  return n;
+}
+
+void
+__fort_mmul_par(int nthreads, mmul_par_fn fn, void *arg, long n, long align)
+{
+  long chunk;
+  int nparts;
+
+  if (nthreads <= 1 || n <= align) {
+    fn(arg, 0, n);
+    return;
+  }
+  chunk = (n + nthreads - 1) / nthreads;
+  chunk = (chunk + align - 1) / align * align;
+  nparts = (n + chunk - 1) / chunk;
+
+  pthread_mutex_lock(&pool_lock);
+  if (pool_busy || nparts <= 1) {
+    pthread_mutex_unlock(&pool_lock);
+    fn(arg, 0, n);
+    return;
+  }
+  start_workers(nparts - 1);
+  if (pool_workers == 0) {
+    pthread_mutex_unlock(&pool_lock);
+    fn(arg, 0, n);
+    return;
+  }
+  /* a worker that woke late for the previous job may still be looking */
+  while (pool_active)
+    pthread_cond_wait(&pool_finish, &pool_lock);
+  pool_busy = 1;
+  job.fn = fn;
+  job.arg = arg;
+  job.n = n;
+  job.chunk = chunk;
+  job.nparts = nparts;
+  job.next = 0;
+  ++pool_gen;
+  pthread_cond_broadcast(&pool_start);
+  pthread_mutex_unlock(&pool_lock);
+
+  run_slices();
+
+  /* every slice has been taken; wait for the ones still running */
+  pthread_mutex_lock(&pool_lock);
+  while (pool_active)
+    pthread_cond_wait(&pool_finish, &pool_lock);
+  pool_busy = 0;
+  pthread_mutex_unlock(&pool_lock);
+}
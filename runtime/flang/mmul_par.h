@@ -0,0 +1,37 @@
+/*
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+ * See https://llvm.org/LICENSE.txt for license information.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+#ifndef _MMUL_PAR_H
+#define _MMUL_PAR_H
+
+/** \file
+ * Worker pool for the thread-parallel MATMUL routines and the large
+ * whole array reductions (from mmul_par.c)
+ */
+
+/** \brief Work function for one slice [lo, hi) of the output. */
+typedef void (*mmul_par_fn)(void *arg, long lo, long hi);
+
+/** \brief
+ * Return the number of threads to use for a multiply of \p work
+ * multiply-adds.  This is 1 inside an active OpenMP parallel region, while
+ * the pool is busy with another call, or when the product is too small to
+ * be worth splitting.  The limit is F90_MATMUL_THREADS if set, otherwise
+ * omp_get_max_threads().
+ */
+int __fort_mmul_nthreads(double work);
+
+/** \brief
+ * Split [0, n) into \p nthreads slices whose boundaries are multiples of
+ * \p align and call \p fn on each, the calling thread taking a share.
+ * Returns when every slice is done.  With \p nthreads <= 1 this is just
+ * fn(arg, 0, n).
+ */
+void __fort_mmul_par(int nthreads, mmul_par_fn fn, void *arg, long n,
+                     long align);
+
+#endif
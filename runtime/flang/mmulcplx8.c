@@ -207,6 +207,14 @@ void ENTF90(MATMUL_CPLX8, matmul_cplx8)(char *dest_addr, char *s1_addr,
                                      &k_extent,&m_extent,
                                      &s2_d2_lstride, &d_d1_lstride);
 
+    } else if (d_d1_lstride == 1 &&
+               (double)n_extent * m_extent * k_extent >= MMUL_GEMM_MIN_MULT) {
+      F90_MATMUL(cplx8_gemm)(dest_base + d_d1_soffset * d_d1_lstride +
+                                 d_d2_soffset * d_d2_lstride,
+                             s1_base + s1_d1_soffset * s1_d1_lstride,
+                             s2_base + s2_d2_soffset * s2_d2_lstride,
+                             &k_extent, &m_extent, &n_extent,
+                             &s1_d2_lstride, &s2_d2_lstride, &d_d2_lstride);
     } else {
       F90_MATMUL(cplx8_str1)(dest_base + d_d1_soffset*d_d1_lstride +
                                             d_d2_soffset*d_d2_lstride,
@@ -42,10 +42,10 @@ static int dbgflag;
 #define VRF_SECTION 2
 #define VRF_MEMBER 3
 
-static TRI tri;
+static FIO_TLS TRI tri;
 
 /* Record the presence of a substring in a reference */
-static struct {
+static FIO_TLS struct {
   bool present;
   __BIGINT_T start;
   __BIGINT_T end;
@@ -63,43 +63,43 @@ typedef struct {
   char *addr;
 } VRF;
 
-static struct {
+static FIO_TLS struct {
   int size;
   int avl;
   VRF *base;
 } vrf;
 
-static int vrf_cur;
+static FIO_TLS int vrf_cur;
 
 #define VRF_TYPE(i) vrf.base[i].type
 #define VRF_SUBSCRIPT(i) vrf.base[i].subscript
 #define VRF_DESCP(i) vrf.base[i].descp
 #define VRF_ADDR(i) vrf.base[i].addr
 
-static FIO_FCB *f;
-static bool accessed; /* file has been read */
-static int byte_cnt;  /* number of bytes read */
-static int n_irecs;   /* number of internal file records */
-static bool internal_file;
-static int rec_len;
-static int token;
-static char token_buff[MAX_TOKEN_LEN + 1];
-static INT tokenval;
-static int live_token;
-static AVAL constval;
-static AVAL cmplxval[2];
-static bool lparen_is_token;
-static bool comma_is_token;
-static FILE *gblfp;
+static FIO_TLS FIO_FCB *f;
+static FIO_TLS bool accessed; /* file has been read */
+static FIO_TLS int byte_cnt;  /* number of bytes read */
+static FIO_TLS int n_irecs;   /* number of internal file records */
+static FIO_TLS bool internal_file;
+static FIO_TLS int rec_len;
+static FIO_TLS int token;
+static FIO_TLS char token_buff[MAX_TOKEN_LEN + 1];
+static FIO_TLS INT tokenval;
+static FIO_TLS int live_token;
+static FIO_TLS AVAL constval;
+static FIO_TLS AVAL cmplxval[2];
+static FIO_TLS bool lparen_is_token;
+static FIO_TLS bool comma_is_token;
+static FIO_TLS FILE *gblfp;
 
 #define RBUF_SIZE 256
-static char rbuf[RBUF_SIZE + 1];
-static unsigned rbuf_size = RBUF_SIZE;
+static FIO_TLS char rbuf[RBUF_SIZE + 1];
+static FIO_TLS unsigned rbuf_size = RBUF_SIZE;
 
-static char *rbufp = rbuf; /* ptr to read buffer */
-static char *currc;        /* current pointer in buffer */
+static FIO_TLS char *rbufp;        /* ptr to read buffer */
+static FIO_TLS char *currc;        /* current pointer in buffer */
 
-static char *in_recp; /* internal i/o record (user's space) */
+static FIO_TLS char *in_recp; /* internal i/o record (user's space) */
 
 typedef struct {
   short blank_zero; /* FIO_ ZERO or NULL */
@@ -132,11 +132,8 @@ typedef struct {
 
 } G;
 
-static G static_gbl[GBL_SIZE];
-static G *gbl = &static_gbl[0];
-static G *gbl_head = &static_gbl[0];
-static int gbl_avl = 0;
-static int gbl_size = GBL_SIZE;
+static FIO_TLS G static_gbl[GBL_SIZE];
+#define gbl (&static_gbl[0])
 
 static void shared_init(void);
 static NML_DESC *skip_to_next(NML_DESC *);
@@ -154,7 +151,7 @@ static int eval_ptr(int, char *);
 static void I8(fillup_sb)(int, NML_DESC *, char *);
 static int dtio_read_scalar(NML_DESC *, char *);
 
-static bool comma_live;
+static FIO_TLS bool comma_live;
 static int eval(int, char *);
 static int I8(eval_dtio_sb)(int d);
 static int assign(NML_DESC *, char *, char **, bool, bool);
@@ -170,7 +167,7 @@ static int dtio_assign(NML_DESC *, char *, char **, bool, bool);
 
 static int read_record(void);
 static char *alloc_rbuf(int, bool);
-static SB sb;
+static FIO_TLS SB sb;
 
 /* ------------------------------------------------------------------- */
 
@@ -338,7 +335,7 @@ I8(_f90io_nmlr_intern_init)( char *cunit,
                              __INT_T *iostat,  
                              __CLEN_T cunit_siz)
 {
-  static FIO_FCB dumfcb;
+  static FIO_TLS FIO_FCB dumfcb;
 
   __fortio_errinit03(-99, *bitv, iostat, "namelist read");
 
@@ -672,7 +669,7 @@ find_group(char *str, int nlen)
 static int
 get_token(void)
 {
-  static int recur = 0;
+  static FIO_TLS int recur = 0;
   int i, c;
   FILE *fp = gblfp;
   char delim;
@@ -2149,6 +2146,8 @@ ENTCRF90IO(NMLR_END, nmlr_end)()
 static int
 read_record(void)
 {
+  if (rbufp == NULL) /* first record on this thread */
+    rbufp = rbuf;
   if (internal_file) {
     if (n_irecs == 0)
       return FIO_EEOF;
@@ -2225,7 +2224,7 @@ static int
 dtio_read_scalar(NML_DESC *descp, char *loc_addr)
 {
 
-  static __INT_T internal_unit = -1;
+  static FIO_TLS __INT_T internal_unit = -1;
   __INT_T tmp_iostat = 0;
   __INT_T *iostat;
   __INT_T *unit;
@@ -2239,7 +2238,7 @@ dtio_read_scalar(NML_DESC *descp, char *loc_addr)
   NML_DESC *start_descp;
   __CLEN_T iotypelen = 8;
   __CLEN_T iomsglen = 250;
-  static char iomsg[250];
+  static FIO_TLS char iomsg[250];
   int k, num_consts, ret_err, j;
   char *iotype = "NAMELIST";
   char *start_addr;
@@ -22,19 +22,19 @@ static int dbgflag;
 #undef DBGBIT
 #define DBGBIT(v) (LOCAL_DEBUG && (dbgflag & v))
 
-static FIO_FCB *f;
+static FIO_TLS FIO_FCB *f;
 
-static char *in_recp; /* internal i/o record (user's space) */
-static char *in_curp; /* current position in internal i/o record */
+static FIO_TLS char *in_recp; /* internal i/o record (user's space) */
+static FIO_TLS char *in_curp; /* current position in internal i/o record */
 
-static int byte_cnt;
-static int rec_len;
-static int n_irecs;         /* number of records in internal file */
-static bool internal_file;  /* TRUE if writing to internal file */
-static char *internal_unit; /* base address of internal file buffer */
-static char delim;
-static bool need_comma;
-static int skip;
+static FIO_TLS int byte_cnt;
+static FIO_TLS int rec_len;
+static FIO_TLS int n_irecs;         /* number of records in internal file */
+static FIO_TLS bool internal_file;  /* TRUE if writing to internal file */
+static FIO_TLS char *internal_unit; /* base address of internal file buffer */
+static FIO_TLS char delim;
+static FIO_TLS bool need_comma;
+static FIO_TLS int skip;
 
 typedef struct {
   short decimal; /* COMMA, POINT, NONE */
@@ -62,11 +62,8 @@ typedef struct {
   __INT_T *iostat; /* used in user defined io */
 } G;
 
-static G static_gbl[GBL_SIZE];
-static G *gbl = &static_gbl[0];
-static G *gbl_head = &static_gbl[0];
-static int gbl_avl = 0;
-static int gbl_size = GBL_SIZE;
+static FIO_TLS G static_gbl[GBL_SIZE];
+#define gbl (&static_gbl[0])
 
 static int emit_eol(void);
 static int write_nml_val(NML_DESC **, NML_DESC *, char *);
@@ -78,8 +75,8 @@ static int I8(eval_sb)(NML_DESC **, NML_DESC *, char *, int);
 static int I8(eval_dtio_sb)(NML_DESC **, NML_DESC *, char *, int);
 static int dtio_write_scalar(NML_DESC **, NML_DESC *, char *, int);
 
-static SB sb;
-static TRI tri;
+static FIO_TLS SB sb;
+static FIO_TLS TRI tri;
 
 /* ---------------------------------------------------------------- */
 
@@ -219,7 +216,7 @@ _f90io_nmlw_intern_init(char *cunit,      /* pointer to variable or array to
                        __INT_T *iostat,  /* same as for ENTF90IO(open_) */
                        __CLEN_T cunit_len)
 {
-  static FIO_FCB dumfcb;
+  static FIO_TLS FIO_FCB dumfcb;
 
   __fortio_errinit03(-99, *bitv, iostat, "internal namelist write");
   rec_len = cunit_len;
@@ -919,7 +916,7 @@ static int
 dtio_write_scalar(NML_DESC **NextDescp, NML_DESC *descp, char *loc_addr,
                   int dtvsize)
 {
-  static __INT_T internal_unit = -1;
+  static FIO_TLS __INT_T internal_unit = -1;
   __INT_T tmp_iostat = 0;
   __INT_T *iostat;
   __INT_T *unit;
@@ -933,7 +930,7 @@ dtio_write_scalar(NML_DESC **NextDescp, NML_DESC *descp, char *loc_addr,
   NML_DESC *start_descp;
   __CLEN_T iotypelen = 8;
   __CLEN_T iomsglen = 250;
-  static char iomsg[250];
+  static FIO_TLS char iomsg[250];
   int k, num_consts, ret_err, j;
   char *iotype = "NAMELIST";
   char *start_addr;
@@ -18,6 +18,8 @@
 #include "global.h"
 #include "open_close.h"
 #include "async.h"
+#include "dirmap.h"
+#include "llcrit.h"
 #include <fcntl.h>
 
 #if defined(WIN32) || defined(WIN64)
@@ -25,16 +27,24 @@
 #define unlink _unlink
 #endif
 
-static FIO_FCB *Fcb; /* pointer to the file control block */
+static FIO_TLS FIO_FCB *Fcb; /* pointer to the file control block */
 
 int next_newunit = -13;
+MP_SEMAPHORE(static, newunit_sem);
 
 /* --------------------------------------------------------------------- */
 int
 ENTF90IO(GET_NEWUNIT, get_newunit)()
 {
+  int unit;
+
   set_gbl_newunit(TRUE);
-  return next_newunit--;
+  /* also outside of an i/o statement's critical section, so that two
+     threads never get the same unit */
+  MP_P(newunit_sem);
+  unit = next_newunit--;
+  MP_V(newunit_sem);
+  return unit;
 }
 
 /* --------------------------------------------------------------------- */
@@ -105,15 +115,21 @@ __fortio_open(int unit, int action_flag, int status_flag, int dispose_flag,
     }
 #endif
     /*  check that file is not already connected to different unit: */
-    for (f = fioFcbTbls.fcbs; f; f = f->next)
+    __fortio_lock_fcbs();
+    for (f = fioFcbs; f; f = f->next)
       if (f->named && strcmp(filename, f->name) == 0)
         if (unit != f->unit)
-          EXIT_OPEN(__fortio_error(FIO_EOPENED))
+          break;
+    __fortio_unlock_fcbs();
+    if (f != NULL)
+      EXIT_OPEN(__fortio_error(FIO_EOPENED))
   }
 
   /* ------- handle situation in which unit is already connected:  */
 
   f = __fortio_find_unit(unit);
+  if (f == NULL && fioFcbTbls.error)
+    EXIT_OPEN(ERR_FLAG)
 
   if (f != NULL) {
     if (name == NULL || strcmp(filename, f->name) == 0) {
@@ -307,6 +323,7 @@ __fortio_open(int unit, int action_flag, int status_flag, int dispose_flag,
   f->encoding = FIO_DEFAULT;
   f->round = FIO_COMPATIBLE;
   f->sign = FIO_PROCESSOR_DEFINED;
+  Fio_map_open(f);
   Fcb = f; /* save pointer to the fcb for any augmented opens */
 
   EXIT_OPEN(0) /* no error occurred */
@@ -14,6 +14,7 @@
 #include "stdioInterf.h"
 #include "fioMacros.h"
 #include "red.h"
+#include "mmul_par.h"
 
 extern void (*__fort_scalar_copy[__NTYPES])(void *rp, void *sp, int len);
 
@@ -134,7 +135,9 @@ static void I8(red_scalar_loop)(red_parm *z, __INT_T aof, __INT_T ll, int dim)
         }
       }
       ap = z->ab + ao * F90_LEN_G(as);
-      if (z->l_fn_b) {
+      if (z->l_s1 && ahop == 1 && !z->mask_present) {
+        z->l_s1(z->rb, abn, ap, z->xb, li, z->back);
+      } else if (z->l_fn_b) {
         z->l_fn_b(z->rb, abn, ap, ahop, mp, mhop, z->xb, li, 1, z->len,
                   z->back);
       } else {
@@ -147,6 +150,128 @@ static void I8(red_scalar_loop)(red_parm *z, __INT_T aof, __INT_T ll, int dim)
   }
 }
 
+/* slices of a threaded stride 1 reduction */
+struct red_slices {
+  red_parm *z;
+  char *ap;      /* first element */
+  long align;    /* slice length */
+  char *res;     /* result of each slice */
+  long slot;     /* bytes for each result, at least the __INT_T that
+                    COUNT's g_fn adds */
+  __INT8_T *loc; /* location found by each slice, 0 if none */
+};
+
+static void
+I8(red_stride1_slice)(void *arg, long lo, long hi)
+{
+  struct red_slices *s = (struct red_slices *)arg;
+  red_parm *z = s->z;
+  long k = lo / s->align;
+  char *r = s->res + k * s->slot;
+
+  memset(r, 0, s->slot);
+  __fort_scalar_copy[z->kind](r, z->zb, z->len);
+  s->loc[k] = 0;
+  z->l_s1(r, hi - lo, s->ap + lo * F90_LEN_G(z->as), &s->loc[k], lo + 1,
+          z->back);
+}
+
+/* turn the element number the stride 1 functions found into the
+   linearized location red_scalar_loop produces */
+static void
+I8(red_stride1_loc)(red_parm *z, int kloc)
+{
+  DECL_DIM_PTRS(asd);
+  __INT8_T f, p, idx[MAXDIMS];
+  __INT_T extent;
+  int i, rank;
+
+  if (z->xb == NULL)
+    return;
+  f = kloc ? *(__INT8_T *)z->xb : *(__INT4_T *)z->xb;
+  if (f == 0)
+    return;
+  rank = F90_RANK_G(z->as);
+  --f;
+  for (i = 0; i < rank; ++i) {
+    SET_DIM_PTRS(asd, z->as, i);
+    extent = F90_DPTR_EXTENT_G(asd);
+    idx[i] = f % extent;
+    f /= extent;
+  }
+  p = 0;
+  for (i = rank; --i >= 0;) {
+    SET_DIM_PTRS(asd, z->as, i);
+    p = p * F90_DPTR_EXTENT_G(asd) + idx[i] + 1;
+  }
+  if (kloc)
+    *(__INT8_T *)z->xb = p;
+  else
+    *(__INT4_T *)z->xb = p;
+}
+
+/** \brief Reduce a whole contiguous array without a mask as one vector,
+ * split among the threads of the MATMUL worker pool when it is large.
+ * \p kloc is set when the locations are __INT8_T.  Returns 0 if the array
+ * is not contiguous, there is a mask, or there is no stride 1 function.
+ */
+static int
+I8(red_stride1)(red_parm *z, int kloc)
+{
+  DECL_HDR_PTRS(as);
+  DECL_DIM_PTRS(asd);
+  struct red_slices s;
+  __INT_T ao, i;
+  __INT8_T loc;
+  long n, k, nslices;
+  int nthreads;
+
+  as = z->as;
+  n = F90_GSIZE_G(as);
+  if (z->l_s1 == NULL || z->mask_present || n <= 0 ||
+      I8(is_nonsequential_section)(as, F90_RANK_G(as)))
+    return 0;
+
+  ao = -1;
+  for (i = 0; i < F90_RANK_G(as); ++i) {
+    SET_DIM_PTRS(asd, as, i);
+    ao += (F90_DPTR_SSTRIDE_G(asd) * F90_DPTR_LBOUND_G(asd) +
+           F90_DPTR_SOFFSET_G(asd)) *
+          F90_DPTR_LSTRIDE_G(asd);
+  }
+  s.ap = z->ab + ao * F90_LEN_G(as);
+
+  /* a load and an operation per element */
+  nthreads = __fort_mmul_nthreads(2.0 * n);
+  if (nthreads <= 1) {
+    z->l_s1(z->rb, n, s.ap, z->xb, 1, z->back);
+    I8(red_stride1_loc)(z, kloc);
+    return 1;
+  }
+
+  s.z = z;
+  s.align = (n + nthreads - 1) / nthreads;
+  nslices = (n + s.align - 1) / s.align;
+  s.slot = z->len > sizeof(__INT_T) ? z->len : sizeof(__INT_T);
+  s.loc = (__INT8_T *)__fort_malloc(nslices * (sizeof(__INT8_T) + s.slot));
+  s.res = (char *)(s.loc + nslices);
+  __fort_mmul_par(nthreads, I8(red_stride1_slice), &s, n, s.align);
+
+  /* combine the slices in order, so that ties resolve as without threads */
+  for (k = 0; k < nslices; ++k) {
+    if (z->xb == NULL) {
+      z->g_fn(1, z->rb, s.res + k * s.slot, NULL, NULL, z->len);
+      continue;
+    }
+    loc = kloc ? s.loc[k] : *(__INT4_T *)&s.loc[k];
+    if (loc != 0)
+      z->l_s1(z->rb, 1, s.res + k * s.slot, z->xb, loc, z->back);
+  }
+  __fort_free(s.loc);
+  I8(red_stride1_loc)(z, kloc);
+  return 1;
+}
+
 void I8(__fort_red_scalar)(red_parm *z, char *rb, char *ab, char *mb,
                           F90_Desc *rs, F90_Desc *as, F90_Desc *ms, __INT_T *xb,
                           red_enum op)
@@ -188,7 +313,8 @@ void I8(__fort_red_scalar)(red_parm *z, char *rb, char *ab, char *mb,
   if (~F90_FLAGS_G(as) & __OFF_TEMPLATE) {
     z->ab += F90_LBASE_G(as) * F90_LEN_G(as);
     ao = -1;
-    I8(red_scalar_loop)(z, ao, 0, F90_RANK_G(as));
+    if (!I8(red_stride1)(z, 0))
+      I8(red_scalar_loop)(z, ao, 0, F90_RANK_G(as));
   }
 
   I8(__fort_reduce_section)(rb, z->kind, z->len,
@@ -251,8 +377,8 @@ void I8(__fort_red_scalarlk)(red_parm *z, char *rb, char *ab, char *mb,
   if (~F90_FLAGS_G(as) & __OFF_TEMPLATE) {
     z->ab += F90_LBASE_G(as) * F90_LEN_G(as);
     ao = -1;
-
-    I8(red_scalar_loop)(z, ao, 0, F90_RANK_G(as));
+    if (!I8(red_stride1)(z, 0))
+      I8(red_scalar_loop)(z, ao, 0, F90_RANK_G(as));
   }
 
   I8(__fort_reduce_section)(rb, z->kind, z->len,
@@ -416,7 +542,9 @@ static void I8(red_array_loop)(red_parm *z, __INT_T rof, __INT_T aof, int rdim,
         lp = NULL;
 
       ap = z->ab + ao * F90_LEN_G(as);
-      if (z->l_fn_b) {
+      if (z->l_s1 && ahop == 1 && !z->mask_present) {
+        z->l_s1(rp, abn, ap, lp, li, z->back);
+      } else if (z->l_fn_b) {
         z->l_fn_b(rp, abn, ap, ahop, mp, mhop, lp, li, 1, z->len, z->back);
       } else {
         z->l_fn(rp, abn, ap, ahop, mp, mhop, lp, li, 1, z->len);
@@ -476,7 +604,8 @@ void I8(__fort_kred_scalarlk)(red_parm *z, char *rb, char *ab, char *mb,
   if (~F90_FLAGS_G(as) & __OFF_TEMPLATE) {
     z->ab += F90_LBASE_G(as) * F90_LEN_G(as);
     ao = -1;
-    I8(red_scalar_loop)(z, ao, 0, F90_RANK_G(as));
+    if (!I8(red_stride1)(z, 1))
+      I8(red_scalar_loop)(z, ao, 0, F90_RANK_G(as));
   }
 
   I8(__fort_reduce_section)(rb, z->kind, z->len,
@@ -640,7 +769,9 @@ static void I8(kred_array_loop)(red_parm *z, __INT_T rof, __INT_T aof, int rdim,
         lp = NULL;
 
       ap = z->ab + ao * F90_LEN_G(as);
-      if (z->l_fn_b) {
+      if (z->l_s1 && ahop == 1 && !z->mask_present) {
+        z->l_s1(rp, abn, ap, lp, li, z->back);
+      } else if (z->l_fn_b) {
         z->l_fn_b(rp, abn, ap, ahop, mp, mhop, lp, li, 1, z->len, z->back);
       } else {
         z->l_fn(rp, abn, ap, ahop, mp, mhop, lp, li, 1, z->len);
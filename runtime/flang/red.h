@@ -38,6 +38,8 @@ typedef struct {
   void (*l_fn_b)(void *, __INT_T, void *, __INT_T, __LOG_T *, __INT_T,
                  __INT_T *, __INT_T, __INT_T, __INT_T, __LOG_T);
   /* local reduction function with "back" arg */
+  void (*l_s1)(void *, long, void *, void *, long, __LOG_T);
+  /* local reduction function for stride 1 without mask, or NULL */
   void (*g_fn)(__INT_T, void *, void *, void *, void *, __INT_T);
   /* global reduction function */
   char *rb, *ab; /* result, array base addresses */
@@ -121,6 +123,18 @@ void I8(__fort_global_reduce)(char *rb, char *hb, int dims, F90_Desc *rd,
       lv  = local min/max value vector
       rv  = remote min/max value vector
       len = use for length of string
+
+   prototype stride 1 local reduction function (name beginning with s1_),
+   used instead of l_NAME when vs == 1 and there is no mask:
+
+   void s1_NAME(void *r, long n, void *v, void *loc, long li, __LOG_T back);
+   where
+      r    = result address (scalar)
+      n    = vector length
+      v    = vector base address
+      loc  = maxloc/minloc element location
+      li   = location of v[0]
+      back = back argument (maxloc/minloc)
 */
 
 /* arithmetic reduction functions
@@ -924,6 +938,179 @@ static void l_ ## NAME(RTYP *r, __INT_T n, RTYP *v, __INT_T vs, \
       *loc = t_loc;                                                            \
   }
 
+/* stride 1 reduction functions.  The loops keep RED_LANES independent
+   partial results so that the compiler can hold them in vector registers.
+   Sums are therefore associated differently than by the l_ functions;
+   maximum, minimum and location results are the same.
+*/
+
+#define RED_LANES 8
+
+#define ARITHS1(OP, NAME, RTYP, ATYP)                                          \
+  static void s1_##NAME(RTYP *r, long n, RTYP *v, void *loc, long li,          \
+                        __LOG_T back)                                          \
+  {                                                                            \
+    ATYP x[RED_LANES], y = *r;                                                 \
+    long i = 0;                                                                \
+    int k;                                                                     \
+    if (n >= 2 * RED_LANES) {                                                  \
+      for (k = 0; k < RED_LANES; k++)                                          \
+        x[k] = v[k];                                                           \
+      for (i = RED_LANES; i + RED_LANES <= n; i += RED_LANES)                  \
+        for (k = 0; k < RED_LANES; k++)                                        \
+          x[k] = x[k] OP v[i + k];                                             \
+      for (k = 0; k < RED_LANES; k++)                                          \
+        y = y OP x[k];                                                         \
+    }                                                                          \
+    for (; i < n; i++)                                                         \
+      y = y OP v[i];                                                           \
+    *r = y;                                                                    \
+  }
+
+#define CONDS1(COND, NAME, RTYP)                                               \
+  static void s1_##NAME(RTYP *r, long n, RTYP *v, void *loc, long li,          \
+                        __LOG_T back)                                          \
+  {                                                                            \
+    RTYP x[RED_LANES], y = *r;                                                 \
+    long i = 0;                                                                \
+    int k;                                                                     \
+    if (n >= 2 * RED_LANES) {                                                  \
+      for (k = 0; k < RED_LANES; k++)                                          \
+        x[k] = y;                                                              \
+      for (; i + RED_LANES <= n; i += RED_LANES)                               \
+        for (k = 0; k < RED_LANES; k++)                                        \
+          x[k] = v[i + k] COND x[k] ? v[i + k] : x[k];                         \
+      for (k = 0; k < RED_LANES; k++)                                          \
+        if (x[k] COND y)                                                       \
+          y = x[k];                                                            \
+    }                                                                          \
+    for (; i < n; i++)                                                         \
+      if (v[i] COND y)                                                         \
+        y = v[i];                                                              \
+    *r = y;                                                                    \
+  }
+
+/* find the extreme value as CONDS1 does, then its first (last if back)
+   occurrence */
+
+#define MLOCS1(COND, NAME, RTYP, LTYP)                                         \
+  static void s1_##NAME(RTYP *r, long n, RTYP *v, LTYP *loc, long li,          \
+                        __LOG_T back)                                          \
+  {                                                                            \
+    RTYP x[RED_LANES], y = *r;                                                 \
+    long i = 0;                                                                \
+    int k;                                                                     \
+    if (n >= 2 * RED_LANES) {                                                  \
+      for (k = 0; k < RED_LANES; k++)                                          \
+        x[k] = y;                                                              \
+      for (; i + RED_LANES <= n; i += RED_LANES)                               \
+        for (k = 0; k < RED_LANES; k++)                                        \
+          x[k] = v[i + k] COND x[k] ? v[i + k] : x[k];                         \
+      for (k = 0; k < RED_LANES; k++)                                          \
+        if (x[k] COND y)                                                       \
+          y = x[k];                                                            \
+    }                                                                          \
+    for (; i < n; i++)                                                         \
+      if (v[i] COND y)                                                         \
+        y = v[i];                                                              \
+    if (!(y COND *r) && !back && *loc != 0)                                    \
+      return; /* only ties with the earlier location */                        \
+    if (back) {                                                                \
+      for (i = n; --i >= 0;)                                                   \
+        if (v[i] == y)                                                         \
+          break;                                                               \
+    } else {                                                                   \
+      for (i = 0; i < n; i++)                                                  \
+        if (v[i] == y)                                                         \
+          break;                                                               \
+    }                                                                          \
+    if (i >= 0 && i < n) {                                                     \
+      *r = v[i];                                                               \
+      *loc = li + i;                                                           \
+    }                                                                          \
+  }
+
+/* type list for the stride 1 functions -- integer and real kinds */
+
+#define TYPELISTS1(NAME)                                                       \
+  {                                                                            \
+    NULL,     /*  0 __NONE       no type */                                    \
+        NULL, /*  1 __SHORT      short */                                      \
+        NULL, /*  2 __USHORT     unsigned short */                             \
+        NULL, /*  3 __CINT       int */                                        \
+        NULL, /*  4 __UINT       unsigned int */                               \
+        NULL, /*  5 __LONG       long */                                       \
+        NULL, /*  6 __ULONG      unsigned long */                              \
+        NULL, /*  7 __FLOAT      float */                                      \
+        NULL, /*  8 __DOUBLE     double */                                     \
+        NULL, /*  9 __CPLX8      float complex */                              \
+        NULL, /* 10 __CPLX16     double complex */                             \
+        NULL, /* 11 __CHAR       char */                                       \
+        NULL, /* 12 __UCHAR      unsigned char */                              \
+        NULL, /* 13 __LONGDOUBLE long double */                                \
+        NULL, /* 14 __STR        string */                                     \
+        NULL, /* 15 __LONGLONG   long long */                                  \
+        NULL, /* 16 __ULONGLONG  unsigned long long */                         \
+        NULL, /* 17 __LOG1       logical*1 */                                  \
+        NULL, /* 18 __LOG2       logical*2 */                                  \
+        NULL, /* 19 __LOG4       logical*4 */                                  \
+        NULL, /* 20 __LOG8       logical*8 */                                  \
+        NULL, /* 21 __WORD4      typeless */                                   \
+        NULL, /* 22 __WORD8      double typeless */                            \
+        NULL, /* 23 __NCHAR      ncharacter - kanji */                         \
+        NAME##int2,  /* 24 __INT2       integer*2 */                           \
+        NAME##int4,  /* 25 __INT4       integer*4 */                           \
+        NAME##int8,  /* 26 __INT8       integer*8 */                           \
+        NAME##real4, /* 27 __REAL4      real*4 */                              \
+        NAME##real8, /* 28 __REAL8      real*8 */                              \
+        NULL,        /* 29 __REAL16     real*16 */                             \
+        NULL,        /* 30 __CPLX32     complex*32 */                          \
+        NULL,        /* 31 __WORD16     quad typeless */                       \
+        NAME##int1,  /* 32 __INT1       integer*1 */                           \
+        NULL         /* 33 __DERIVED    derived type */                        \
+  }
+
+/* type list for the stride 1 functions -- logical and integer kinds
+   (count) */
+
+#define TYPELISTS1L(NAME)                                                      \
+  {                                                                            \
+    NULL,     /*  0 __NONE       no type */                                    \
+        NULL, /*  1 __SHORT      short */                                      \
+        NULL, /*  2 __USHORT     unsigned short */                             \
+        NULL, /*  3 __CINT       int */                                        \
+        NULL, /*  4 __UINT       unsigned int */                               \
+        NULL, /*  5 __LONG       long */                                       \
+        NULL, /*  6 __ULONG      unsigned long */                              \
+        NULL, /*  7 __FLOAT      float */                                      \
+        NULL, /*  8 __DOUBLE     double */                                     \
+        NULL, /*  9 __CPLX8      float complex */                              \
+        NULL, /* 10 __CPLX16     double complex */                             \
+        NULL, /* 11 __CHAR       char */                                       \
+        NULL, /* 12 __UCHAR      unsigned char */                              \
+        NULL, /* 13 __LONGDOUBLE long double */                                \
+        NULL, /* 14 __STR        string */                                     \
+        NULL, /* 15 __LONGLONG   long long */                                  \
+        NULL, /* 16 __ULONGLONG  unsigned long long */                         \
+        NAME##log1, /* 17 __LOG1       logical*1 */                            \
+        NAME##log2, /* 18 __LOG2       logical*2 */                            \
+        NAME##log4, /* 19 __LOG4       logical*4 */                            \
+        NAME##log8, /* 20 __LOG8       logical*8 */                            \
+        NULL,       /* 21 __WORD4      typeless */                             \
+        NULL,       /* 22 __WORD8      double typeless */                      \
+        NULL,       /* 23 __NCHAR      ncharacter - kanji */                   \
+        NAME##int2, /* 24 __INT2       integer*2 */                            \
+        NAME##int4, /* 25 __INT4       integer*4 */                            \
+        NAME##int8, /* 26 __INT8       integer*8 */                            \
+        NULL,       /* 27 __REAL4      real*4 */                               \
+        NULL,       /* 28 __REAL8      real*8 */                               \
+        NULL,       /* 29 __REAL16     real*16 */                              \
+        NULL,       /* 30 __CPLX32     complex*32 */                           \
+        NULL,       /* 31 __WORD16     quad typeless */                        \
+        NAME##int1, /* 32 __INT1       integer*1 */                            \
+        NULL        /* 33 __DERIVED    derived type */                         \
+  }
+
 /* type list 1 -- sum, product */
 
 #define TYPELIST1(NAME)                                                        \
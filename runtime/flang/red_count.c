@@ -46,6 +46,28 @@ static __INT_T mask_desc = __LOG; /* scalar mask descriptor */
     *r = x;                                                                    \
   }
 
+#define COUNTS1(NAME, RTYP, N)                                                 \
+  static void s1_##NAME(int *r, long n, RTYP *v, void *loc, long li,           \
+                        __LOG_T back)                                          \
+  {                                                                            \
+    int x[RED_LANES], y = *r;                                                  \
+    RTYP mask_log = GET_DIST_MASK_LOG##N;                                     \
+    long i = 0;                                                                \
+    int k;                                                                     \
+    if (n >= 2 * RED_LANES) {                                                  \
+      for (k = 0; k < RED_LANES; k++)                                          \
+        x[k] = 0;                                                              \
+      for (; i + RED_LANES <= n; i += RED_LANES)                               \
+        for (k = 0; k < RED_LANES; k++)                                        \
+          x[k] += (v[i + k] & mask_log) != 0;                                  \
+      for (k = 0; k < RED_LANES; k++)                                          \
+        y += x[k];                                                             \
+    }                                                                          \
+    for (; i < n; i++)                                                         \
+      y += (v[i] & mask_log) != 0;                                             \
+    *r = y;                                                                    \
+  }
+
 COUNTFN(count_log1, __LOG1_T)
 COUNTFN(count_log2, __LOG2_T)
 COUNTFN(count_log4, __LOG4_T)
@@ -91,7 +113,17 @@ COUNTFNLKN(count_int2, __INT2_T, 8)
 COUNTFNLKN(count_int4, __INT4_T, 8)
 COUNTFNLKN(count_int8, __INT8_T, 8)
 
+COUNTS1(count_log1, __LOG1_T, 1)
+COUNTS1(count_log2, __LOG2_T, 2)
+COUNTS1(count_log4, __LOG4_T, 4)
+COUNTS1(count_log8, __LOG8_T, 8)
+COUNTS1(count_int1, __INT1_T, 1)
+COUNTS1(count_int2, __INT2_T, 2)
+COUNTS1(count_int4, __INT4_T, 4)
+COUNTS1(count_int8, __INT8_T, 8)
+
 static void (*l_count[4][__NTYPES])() = TYPELIST2LK(l_count_);
+static void (*s1_count[__NTYPES])() = TYPELISTS1L(s1_count_);
 
 static void I8(g_count)(__INT_T n, __INT_T *lr, __INT_T *rr, void *lv, void *rv)
 {
@@ -119,6 +151,7 @@ void ENTFTN(COUNTS, counts)(char *rb, char *mb, DECL_HDR_PTRS(rs), F90_Desc *ms)
     z.lk_shift = GET_DIST_SHIFTS(F90_KIND_G(ms));
   }
   z.l_fn = l_count[z.lk_shift][ms->kind];
+  z.l_s1 = s1_count[ms->kind];
   z.g_fn =
       (void (*)(__INT_T, void *, void *, void *, void *, __INT_T))I8(g_count);
   z.zb = GET_DIST_ZED;
@@ -146,6 +179,7 @@ void ENTFTN(COUNT, count)(char *rb, char *mb, char *db, DECL_HDR_PTRS(rs),
     z.lk_shift = GET_DIST_SHIFTS(F90_KIND_G(ms));
   }
   z.l_fn = l_count[z.lk_shift][ms->kind];
+  z.l_s1 = s1_count[ms->kind];
   z.g_fn =
       (void (*)(__INT_T, void *, void *, void *, void *, __INT_T))I8(g_count);
   z.zb = GET_DIST_ZED;
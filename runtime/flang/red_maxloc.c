@@ -58,7 +58,15 @@ MLOCFNG(>, maxloc_real8, __REAL8_T)
 MLOCFNG(>, maxloc_real16, __REAL16_T)
 MLOCSTRFNG(>, maxloc_str, __STR_T)
 
+MLOCS1(>, maxloc_int1, __INT1_T, __INT4_T)
+MLOCS1(>, maxloc_int2, __INT2_T, __INT4_T)
+MLOCS1(>, maxloc_int4, __INT4_T, __INT4_T)
+MLOCS1(>, maxloc_int8, __INT8_T, __INT4_T)
+MLOCS1(>, maxloc_real4, __REAL4_T, __INT4_T)
+MLOCS1(>, maxloc_real8, __REAL8_T, __INT4_T)
+
 static void (*l_maxloc_b[4][__NTYPES])() = TYPELIST3LK(l_maxloc_);
+static void (*s1_maxloc[__NTYPES])() = TYPELISTS1(s1_maxloc_);
 static void (*g_maxloc[__NTYPES])() = TYPELIST3(g_maxloc_);
 
 KMLOCFNLKN(>, kmaxloc_int1, __INT1_T, 1)
@@ -106,7 +114,15 @@ KMLOCFNG(>, kmaxloc_real8, __REAL8_T)
 KMLOCFNG(>, kmaxloc_real16, __REAL16_T)
 KMLOCSTRFNG(>, kmaxloc_str, __STR_T)
 
+MLOCS1(>, kmaxloc_int1, __INT1_T, __INT8_T)
+MLOCS1(>, kmaxloc_int2, __INT2_T, __INT8_T)
+MLOCS1(>, kmaxloc_int4, __INT4_T, __INT8_T)
+MLOCS1(>, kmaxloc_int8, __INT8_T, __INT8_T)
+MLOCS1(>, kmaxloc_real4, __REAL4_T, __INT8_T)
+MLOCS1(>, kmaxloc_real8, __REAL8_T, __INT8_T)
+
 static void (*l_kmaxloc_b[4][__NTYPES])() = TYPELIST3LK(l_kmaxloc_);
+static void (*s1_kmaxloc[__NTYPES])() = TYPELISTS1(s1_kmaxloc_);
 static void (*g_kmaxloc[__NTYPES])() = TYPELIST3(g_kmaxloc_);
 
 /* dim absent */
@@ -128,6 +144,7 @@ maxlocs_common(red_parm *z, __INT_T *rb, char *ab, char *mb, F90_Desc *rs,
     z->lk_shift = GET_DIST_SHIFTS(F90_KIND_G(ms));
   }
   z->l_fn_b = l_maxloc_b[z->lk_shift][z->kind];
+  z->l_s1 = s1_maxloc[z->kind];
   z->g_fn = g_maxloc[z->kind];
   z->zb = GET_DIST_MINS(z->kind);
 
@@ -180,6 +197,7 @@ static void maxloc_common(red_parm *z, char *rb, char *ab, char *mb, char *db,
     z->lk_shift = GET_DIST_SHIFTS(F90_KIND_G(ms));
   }
   z->l_fn_b = l_maxloc_b[z->lk_shift][z->kind];
+  z->l_s1 = s1_maxloc[z->kind];
   z->g_fn = g_maxloc[z->kind];
   z->zb = GET_DIST_MINS(z->kind);
   if (z->kind == __STR)
@@ -233,6 +251,7 @@ static void kmaxlocs_common(red_parm *z, __INT8_T *rb, char *ab, char *mb,
     z->lk_shift = GET_DIST_SHIFTS(F90_KIND_G(ms));
   }
   z->l_fn_b = l_kmaxloc_b[z->lk_shift][z->kind];
+  z->l_s1 = s1_kmaxloc[z->kind];
   z->g_fn = g_kmaxloc[z->kind];
   z->zb = GET_DIST_MINS(z->kind);
 
@@ -286,6 +305,7 @@ static void kmaxloc_common(red_parm *z, char *rb, char *ab, char *mb, char *db,
     z->lk_shift = GET_DIST_SHIFTS(F90_KIND_G(ms));
   }
   z->l_fn_b = l_kmaxloc_b[z->lk_shift][z->kind];
+  z->l_s1 = s1_kmaxloc[z->kind];
   z->g_fn = g_kmaxloc[z->kind];
   z->zb = GET_DIST_MINS(z->kind);
 
@@ -58,7 +58,15 @@ CONDFNG(>, maxval_real8, __REAL8_T)
 CONDFNG(>, maxval_real16, __REAL16_T)
 CONDSTRFNG(>, maxval_str, __STR_T)
 
+CONDS1(>, maxval_int1, __INT1_T)
+CONDS1(>, maxval_int2, __INT2_T)
+CONDS1(>, maxval_int4, __INT4_T)
+CONDS1(>, maxval_int8, __INT8_T)
+CONDS1(>, maxval_real4, __REAL4_T)
+CONDS1(>, maxval_real8, __REAL8_T)
+
 static void (*l_maxval[4][__NTYPES])() = TYPELIST3LK(l_maxval_);
+static void (*s1_maxval[__NTYPES])() = TYPELISTS1(s1_maxval_);
 static void (*g_maxval[__NTYPES])() = TYPELIST3(g_maxval_);
 
 /* dim absent */
@@ -80,6 +88,7 @@ void ENTFTN(MAXVALS, maxvals)(char *rb, char *ab, char *mb, F90_Desc *rs,
     z.lk_shift = GET_DIST_SHIFTS(F90_KIND_G(ms));
   }
   z.l_fn = l_maxval[z.lk_shift][z.kind];
+  z.l_s1 = s1_maxval[z.kind];
   z.g_fn = g_maxval[z.kind];
   z.zb = GET_DIST_MINS(z.kind);
   if (z.kind == __STR)
@@ -107,6 +116,7 @@ void ENTFTN(MAXVAL, maxval)(char *rb, char *ab, char *mb, char *db,
     z.lk_shift = GET_DIST_SHIFTS(F90_KIND_G(ms));
   }
   z.l_fn = l_maxval[z.lk_shift][z.kind];
+  z.l_s1 = s1_maxval[z.kind];
   z.g_fn = g_maxval[z.kind];
   z.zb = GET_DIST_MINS(z.kind);
   if (z.kind == __STR)
@@ -59,7 +59,15 @@ MLOCFNG(<, minloc_real8, __REAL8_T)
 MLOCFNG(<, minloc_real16, __REAL16_T)
 MLOCSTRFNG(<, minloc_str, __STR_T)
 
+MLOCS1(<, minloc_int1, __INT1_T, __INT4_T)
+MLOCS1(<, minloc_int2, __INT2_T, __INT4_T)
+MLOCS1(<, minloc_int4, __INT4_T, __INT4_T)
+MLOCS1(<, minloc_int8, __INT8_T, __INT4_T)
+MLOCS1(<, minloc_real4, __REAL4_T, __INT4_T)
+MLOCS1(<, minloc_real8, __REAL8_T, __INT4_T)
+
 static void (*l_minloc_b[4][__NTYPES])() = TYPELIST3LK(l_minloc_);
+static void (*s1_minloc[__NTYPES])() = TYPELISTS1(s1_minloc_);
 static void (*g_minloc[__NTYPES])() = TYPELIST3(g_minloc_);
 
 KMLOCFNLKN(<, kminloc_int1, __INT1_T, 1)
@@ -107,7 +115,15 @@ KMLOCFNG(<, kminloc_real8, __REAL8_T)
 KMLOCFNG(<, kminloc_real16, __REAL16_T)
 KMLOCSTRFNG(<, kminloc_str, __STR_T)
 
+MLOCS1(<, kminloc_int1, __INT1_T, __INT8_T)
+MLOCS1(<, kminloc_int2, __INT2_T, __INT8_T)
+MLOCS1(<, kminloc_int4, __INT4_T, __INT8_T)
+MLOCS1(<, kminloc_int8, __INT8_T, __INT8_T)
+MLOCS1(<, kminloc_real4, __REAL4_T, __INT8_T)
+MLOCS1(<, kminloc_real8, __REAL8_T, __INT8_T)
+
 static void (*l_kminloc_b[4][__NTYPES])() = TYPELIST3LK(l_kminloc_);
+static void (*s1_kminloc[__NTYPES])() = TYPELISTS1(s1_kminloc_);
 static void (*g_kminloc[__NTYPES])() = TYPELIST3(g_kminloc_);
 
 /* dim absent */
@@ -128,6 +144,7 @@ static void minlocs_common(red_parm *z, __INT_T *rb, char *ab, char *mb,
     z->lk_shift = GET_DIST_SHIFTS(F90_KIND_G(ms));
   }
   z->l_fn_b = l_minloc_b[z->lk_shift][z->kind];
+  z->l_s1 = s1_minloc[z->kind];
   z->g_fn = g_minloc[z->kind];
   z->zb = GET_DIST_MAXS(z->kind);
 
@@ -179,6 +196,7 @@ static void minloc_common(red_parm *z, char *rb, char *ab, char *mb, char *db,
     z->lk_shift = GET_DIST_SHIFTS(F90_KIND_G(ms));
   }
   z->l_fn_b = l_minloc_b[z->lk_shift][z->kind];
+  z->l_s1 = s1_minloc[z->kind];
   z->g_fn = g_minloc[z->kind];
   z->zb = GET_DIST_MAXS(z->kind);
 
@@ -235,6 +253,7 @@ static void kminlocs_common(red_parm *z, __INT8_T *rb, char *ab, char *mb,
     z->lk_shift = GET_DIST_SHIFTS(F90_KIND_G(ms));
   }
   z->l_fn_b = l_kminloc_b[z->lk_shift][z->kind];
+  z->l_s1 = s1_kminloc[z->kind];
   z->g_fn = g_kminloc[z->kind];
   z->zb = GET_DIST_MAXS(z->kind);
 
@@ -284,6 +303,7 @@ static void kminloc_common(red_parm *z, char *rb, char *ab, char *mb, char *db,
     z->lk_shift = GET_DIST_SHIFTS(F90_KIND_G(ms));
   }
   z->l_fn_b = l_kminloc_b[z->lk_shift][z->kind];
+  z->l_s1 = s1_kminloc[z->kind];
   z->g_fn = g_kminloc[z->kind];
   z->zb = GET_DIST_MAXS(z->kind);
 
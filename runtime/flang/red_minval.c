@@ -58,7 +58,15 @@ CONDFNG(<, minval_real8, __REAL8_T)
 CONDFNG(<, minval_real16, __REAL16_T)
 CONDSTRFNG(<, minval_str, __STR_T)
 
+CONDS1(<, minval_int1, __INT1_T)
+CONDS1(<, minval_int2, __INT2_T)
+CONDS1(<, minval_int4, __INT4_T)
+CONDS1(<, minval_int8, __INT8_T)
+CONDS1(<, minval_real4, __REAL4_T)
+CONDS1(<, minval_real8, __REAL8_T)
+
 static void (*l_minval[4][__NTYPES])() = TYPELIST3LK(l_minval_);
+static void (*s1_minval[__NTYPES])() = TYPELISTS1(s1_minval_);
 static void (*g_minval[__NTYPES])() = TYPELIST3(g_minval_);
 
 /* dim absent */
@@ -80,6 +88,7 @@ void ENTFTN(MINVALS, minvals)(char *rb, char *ab, char *mb, F90_Desc *rs,
     z.lk_shift = GET_DIST_SHIFTS(F90_KIND_G(ms));
   }
   z.l_fn = l_minval[z.lk_shift][z.kind];
+  z.l_s1 = s1_minval[z.kind];
   z.g_fn = g_minval[z.kind];
   z.zb = GET_DIST_MAXS(z.kind);
   if (z.kind == __STR)
@@ -107,6 +116,7 @@ void ENTFTN(MINVAL, minval)(char *rb, char *ab, char *mb, char *db,
     z.lk_shift = GET_DIST_SHIFTS(F90_KIND_G(ms));
   }
   z.l_fn = l_minval[z.lk_shift][z.kind];
+  z.l_s1 = s1_minval[z.kind];
   z.g_fn = g_minval[z.kind];
   z.zb = GET_DIST_MAXS(z.kind);
   if (z.kind == __STR)
@@ -125,7 +125,15 @@ CSUMFNLKN(sum_cplx8, __CPLX8_T, __REAL4_T, 8)
 CSUMFNLKN(sum_cplx16, __CPLX16_T, __REAL8_T, 8)
 CSUMFNLKN(sum_cplx32, __CPLX32_T, __REAL16_T, 8)
 
+ARITHS1(+, sum_int1, __INT1_T, long)
+ARITHS1(+, sum_int2, __INT2_T, long)
+ARITHS1(+, sum_int4, __INT4_T, long)
+ARITHS1(+, sum_int8, __INT8_T, __INT8_T)
+ARITHS1(+, sum_real4, __REAL4_T, __REAL4_T)
+ARITHS1(+, sum_real8, __REAL8_T, __REAL8_T)
+
 static void (*l_sum[4][__NTYPES])() = TYPELIST1LK(l_sum_);
+static void (*s1_sum[__NTYPES])() = TYPELISTS1(s1_sum_);
 void (*I8(__fort_g_sum)[__NTYPES])() = TYPELIST1(g_sum_);
 
 /* dim absent */
@@ -147,6 +155,7 @@ void ENTFTN(SUMS, sums)(char *rb, char *ab, char *mb, DECL_HDR_PTRS(rs),
     z.lk_shift = GET_DIST_SHIFTS(F90_KIND_G(ms));
   }
   z.l_fn = l_sum[z.lk_shift][z.kind];
+  z.l_s1 = s1_sum[z.kind];
   z.g_fn = I8(__fort_g_sum)[z.kind];
   z.zb = GET_DIST_ZED;
   I8(__fort_red_scalar)(&z, rb, ab, mb, rs, as, ms, NULL, __SUM);
@@ -171,6 +180,7 @@ void ENTFTN(SUM, sum)(char *rb, char *ab, char *mb, char *db, DECL_HDR_PTRS(rs),
     z.lk_shift = GET_DIST_SHIFTS(F90_KIND_G(ms));
   }
   z.l_fn = l_sum[z.lk_shift][z.kind];
+  z.l_s1 = s1_sum[z.kind];
   z.g_fn = I8(__fort_g_sum)[z.kind];
   z.zb = GET_DIST_ZED;
   if (ISSCALAR(ms)) {
@@ -66,6 +66,10 @@ static int I8(advance_permuted)(F90_Desc *d, __INT_T *index, int *order,
   return 0;
 }
 
+/* pieces copied per __fort_doit */
+
+#define RESHAPE_BATCH 1024
+
 /* reshape intrinsic */
 
 void ENTFTN(RESHAPE, reshape)(char *resb,     /* result base */
@@ -89,7 +93,7 @@ void ENTFTN(RESHAPE, reshape)(char *resb,     /* result base */
   char *fromb, *tob;
   chdr *ch;
   __INT_T more_res, more_src, more_pad, n;
-  int i, j, k, m, r;
+  int i, j, k, m, r, pieces;
 
 #if defined(DEBUG)
   if (resd == NULL || F90_TAG_G(resd) != __DESC)
@@ -169,8 +173,12 @@ void ENTFTN(RESHAPE, reshape)(char *resb,     /* result base */
     more_pad = 0;
 
   /* loop -- transfer matching column vector sections and advance
-     indices until result array is filled */
+     indices until result array is filled.  The transfers are gathered
+     into one channel and done RESHAPE_BATCH at a time, so that those
+     making up a transpose are copied in tiles. */
 
+  ch = NULL;
+  pieces = 0;
   while (more_res) {
 
     if (more_src) {
@@ -211,12 +219,20 @@ void ENTFTN(RESHAPE, reshape)(char *resb,     /* result base */
     fromb += DIST_SCOFF_G(fromd) * F90_LEN_G(fromd);
     tob = resb + DIST_SCOFF_G(tod) * F90_LEN_G(tod);
 
-    ch = I8(__fort_copy)(tob, fromb, tod, fromd, NULL);
-    __fort_doit(ch);
-    __fort_frechn(ch);
+    ch = I8(__fort_copy_add)(ch, tob, fromb, tod, fromd, NULL);
+    if (++pieces == RESHAPE_BATCH) {
+      __fort_chn_prune(ch);
+      __fort_doit(ch);
+      __fort_frechn(ch);
+      ch = NULL;
+      pieces = 0;
+    }
 
     more_res = I8(advance_permuted)(resd, resx, order, n);
   }
+  __fort_chn_prune(ch);
+  __fort_doit(ch);
+  __fort_frechn(ch);
 }
 
 void ENTFTN(RESHAPECA, reshapeca)(DCHAR(resb),    /* result char base */
@@ -11,6 +11,7 @@
 #include "stdioInterf.h"
 #include "fioMacros.h"
 #include "llcrit.h"
+#include "komp.h"
 
 /*
  * ========================================================================
@@ -35,7 +36,39 @@
 
 #define MASK23 ((unsigned)0x7fffff)
 
-static __INT_T last_i = 0;
+/*
+ * Lagged Fibonacci generator geometry.
+ */
+
+#define NBITS 2
+#define DIGIT ((1 << NBITS) - 1)
+#define NDIGITS ((32 + NBITS - 1) / NBITS)
+
+#define LONG_LAG 17
+#define SHORT_LAG 5
+#define L2CYCLE 6
+#define L2CUTOFF 8
+
+#define CYCLE (1 << L2CYCLE)
+#define MASK (CYCLE - 1)
+#define TOGGLE (CYCLE >> 1)
+
+#define CUTOFF (1 << L2CUTOFF)
+#define CUTMASK (CUTOFF - 1)
+
+/*
+ * Generator state.  RANDOM_NUMBER normally draws from the one program-wide
+ * state, rstate, under sem; with per-thread streams enabled each OpenMP
+ * thread of a parallel region draws from its own (see thread_stream()).
+ */
+
+typedef struct {
+  double seed_lf[CYCLE]; /* lagged Fibonacci values, a ring ending at offset */
+  int offset;
+  double seed_hi, seed_lo; /* NAS parallel benchmarks generator seed */
+  __INT_T last_i;          /* element index of the last value generated */
+  int gen;                 /* rnum_gen when this stream was derived */
+} RNUM_STATE;
 
 #ifdef DEBUG
 
@@ -61,9 +94,6 @@ rnum_abort(const char *file, int line, const char *mesg)
 #define DEFAULT_SEED_HI (R23 * 32.0)
 #define DEFAULT_SEED_LO (R46 * 3392727.0)
 
-static double seed_hi = DEFAULT_SEED_HI;
-static double seed_lo = DEFAULT_SEED_LO;
-
 static double table[32][2] = {
     {4354965.0, T23 * 145.0},     {210105.0, T23 * 6909540.0},
     {3255729.0, T23 * 1196310.0}, {1750113.0, T23 * 3474515.0},
@@ -85,7 +115,7 @@ static double table[32][2] = {
 MP_SEMAPHORE(static, sem);
 
 static double
-advance_seed_npb(__INT_T n)
+advance_seed_npb(RNUM_STATE *s, __INT_T n)
 {
   int itmp;
   double tmp1, tmp2;
@@ -102,22 +132,23 @@ advance_seed_npb(__INT_T n)
   tp = table;
   while (n > 0) {
     if (n & 1) {
-      tmp1 = seed_lo * tp[0][0];
+      tmp1 = s->seed_lo * tp[0][0];
       itmp = T23 * tmp1;
       tmp2 = R23 * itmp;
-      seed_hi = tmp2 + seed_lo * tp[0][1] + seed_hi * tp[0][0];
-      seed_lo = tmp1 - tmp2;
-      itmp = seed_hi;
-      seed_hi -= itmp;
+      s->seed_hi = tmp2 + s->seed_lo * tp[0][1] + s->seed_hi * tp[0][0];
+      s->seed_lo = tmp1 - tmp2;
+      itmp = s->seed_hi;
+      s->seed_hi -= itmp;
     }
     ++tp;
     n >>= 1;
   }
-  return seed_lo + seed_hi;
+  return s->seed_lo + s->seed_hi;
 }
 
-static void I8(prng_loop_d_npb)(__REAL8_T *hb, F90_Desc *harvest, __INT_T li,
-                                int dim, __INT_T section_offset, __INT_T limit)
+static void I8(prng_loop_d_npb)(RNUM_STATE *s, __REAL8_T *hb,
+                                F90_Desc *harvest, __INT_T li, int dim,
+                                __INT_T section_offset, __INT_T limit)
 {
   DECL_DIM_PTRS(hdd);
   DECL_DIM_PTRS(tdd);
@@ -141,7 +172,7 @@ static void I8(prng_loop_d_npb)(__REAL8_T *hb, F90_Desc *harvest, __INT_T li,
       current = F90_DPTR_EXTENT_G(hdd) * section_offset +
                 (il - F90_DPTR_LBOUND_G(hdd));
       for (i = 0; i < n; ++i) {
-        I8(prng_loop_d_npb)(hb, harvest, lo, dim - 1, current + i, limit);
+        I8(prng_loop_d_npb)(s, hb, harvest, lo, dim - 1, current + i, limit);
         lo += F90_DPTR_SSTRIDE_G(hdd) * F90_DPTR_LSTRIDE_G(hdd);
       }
     }
@@ -182,17 +213,17 @@ static void I8(prng_loop_d_npb)(__REAL8_T *hb, F90_Desc *harvest, __INT_T li,
       /*
        * Fill the array with random numbers.
        */
-      hb[lo] = advance_seed_npb(current - last_i);
-      last_i = current + hi - lo;
+      hb[lo] = advance_seed_npb(s, current - s->last_i);
+      s->last_i = current + hi - lo;
       for (i = lo + 1; i <= hi; ++i) {
-        tmp1 = seed_lo * table[0][0];
+        tmp1 = s->seed_lo * table[0][0];
         itmp = T23 * tmp1;
         tmp2 = R23 * itmp;
-        seed_hi = tmp2 + seed_lo * table[0][1] + seed_hi * table[0][0];
-        seed_lo = tmp1 - tmp2;
-        itmp = seed_hi;
-        seed_hi -= itmp;
-        hb[i] = seed_lo + seed_hi;
+        s->seed_hi = tmp2 + s->seed_lo * table[0][1] + s->seed_hi * table[0][0];
+        s->seed_lo = tmp1 - tmp2;
+        itmp = s->seed_hi;
+        s->seed_hi -= itmp;
+        hb[i] = s->seed_lo + s->seed_hi;
       }
     }
   } else {
@@ -205,26 +236,28 @@ static void I8(prng_loop_d_npb)(__REAL8_T *hb, F90_Desc *harvest, __INT_T li,
                  F90_DPTR_LSTRIDE_G(hdd);
         current = F90_DPTR_EXTENT_G(hdd) * section_offset +
                   (il - F90_DPTR_LBOUND_G(hdd));
-        hb[lo] = advance_seed_npb(current - last_i);
+        hb[lo] = advance_seed_npb(s, current - s->last_i);
         for (i = 1; i < n; ++i) {
           lo += F90_DPTR_SSTRIDE_G(hdd) * F90_DPTR_LSTRIDE_G(hdd);
-          tmp1 = seed_lo * table[0][0];
+          tmp1 = s->seed_lo * table[0][0];
           itmp = T23 * tmp1;
           tmp2 = R23 * itmp;
-          seed_hi = tmp2 + seed_lo * table[0][1] + seed_hi * table[0][0];
-          seed_lo = tmp1 - tmp2;
-          itmp = seed_hi;
-          seed_hi -= itmp;
-          hb[lo] = seed_lo + seed_hi;
+          s->seed_hi =
+              tmp2 + s->seed_lo * table[0][1] + s->seed_hi * table[0][0];
+          s->seed_lo = tmp1 - tmp2;
+          itmp = s->seed_hi;
+          s->seed_hi -= itmp;
+          hb[lo] = s->seed_lo + s->seed_hi;
         }
-        last_i = current + n - 1;
+        s->last_i = current + n - 1;
       }
     }
   }
 }
 
-static void I8(prng_loop_r_npb)(__REAL4_T *hb, F90_Desc *harvest, __INT_T li,
-                                int dim, __INT_T section_offset, __INT_T limit)
+static void I8(prng_loop_r_npb)(RNUM_STATE *s, __REAL4_T *hb,
+                                F90_Desc *harvest, __INT_T li, int dim,
+                                __INT_T section_offset, __INT_T limit)
 {
   DECL_DIM_PTRS(hdd);
   DECL_DIM_PTRS(tdd);
@@ -248,7 +281,7 @@ static void I8(prng_loop_r_npb)(__REAL4_T *hb, F90_Desc *harvest, __INT_T li,
       current = F90_DPTR_EXTENT_G(hdd) * section_offset +
                 (il - F90_DPTR_LBOUND_G(hdd));
       for (i = 0; i < n; ++i) {
-        I8(prng_loop_r_npb)(hb, harvest, lo, dim - 1, current + i, limit);
+        I8(prng_loop_r_npb)(s, hb, harvest, lo, dim - 1, current + i, limit);
         lo += F90_DPTR_SSTRIDE_G(hdd) * F90_DPTR_LSTRIDE_G(hdd);
       }
     }
@@ -289,17 +322,17 @@ static void I8(prng_loop_r_npb)(__REAL4_T *hb, F90_Desc *harvest, __INT_T li,
       /*
        * Fill the array with random numbers.
        */
-      hb[lo] = advance_seed_npb(current - last_i);
-      last_i = current + hi - lo;
+      hb[lo] = advance_seed_npb(s, current - s->last_i);
+      s->last_i = current + hi - lo;
       for (i = lo + 1; i <= hi; ++i) {
-        tmp1 = seed_lo * table[0][0];
+        tmp1 = s->seed_lo * table[0][0];
         itmp = T23 * tmp1;
         tmp2 = R23 * itmp;
-        seed_hi = tmp2 + seed_lo * table[0][1] + seed_hi * table[0][0];
-        seed_lo = tmp1 - tmp2;
-        itmp = seed_hi;
-        seed_hi -= itmp;
-        hb[i] = seed_lo + seed_hi;
+        s->seed_hi = tmp2 + s->seed_lo * table[0][1] + s->seed_hi * table[0][0];
+        s->seed_lo = tmp1 - tmp2;
+        itmp = s->seed_hi;
+        s->seed_hi -= itmp;
+        hb[i] = s->seed_lo + s->seed_hi;
       }
     }
   } else {
@@ -312,19 +345,20 @@ static void I8(prng_loop_r_npb)(__REAL4_T *hb, F90_Desc *harvest, __INT_T li,
                  F90_DPTR_LSTRIDE_G(hdd);
         current = F90_DPTR_EXTENT_G(hdd) * section_offset +
                   (il - F90_DPTR_LBOUND_G(hdd));
-        hb[lo] = advance_seed_npb(current - last_i);
+        hb[lo] = advance_seed_npb(s, current - s->last_i);
         for (i = 1; i < n; ++i) {
           lo += F90_DPTR_SSTRIDE_G(hdd) * F90_DPTR_LSTRIDE_G(hdd);
-          tmp1 = seed_lo * table[0][0];
+          tmp1 = s->seed_lo * table[0][0];
           itmp = T23 * tmp1;
           tmp2 = R23 * itmp;
-          seed_hi = tmp2 + seed_lo * table[0][1] + seed_hi * table[0][0];
-          seed_lo = tmp1 - tmp2;
-          itmp = seed_hi;
-          seed_hi -= itmp;
-          hb[lo] = seed_lo + seed_hi;
+          s->seed_hi =
+              tmp2 + s->seed_lo * table[0][1] + s->seed_hi * table[0][0];
+          s->seed_lo = tmp1 - tmp2;
+          itmp = s->seed_hi;
+          s->seed_hi -= itmp;
+          hb[lo] = s->seed_lo + s->seed_hi;
         }
-        last_i = current + n - 1;
+        s->last_i = current + n - 1;
       }
     }
   }
@@ -340,22 +374,6 @@ typedef struct {
   double lo, hi;
 } Seed;
 
-#define NBITS 2
-#define DIGIT ((1 << NBITS) - 1)
-#define NDIGITS ((32 + NBITS - 1) / NBITS)
-
-#define LONG_LAG 17
-#define SHORT_LAG 5
-#define L2CYCLE 6
-#define L2CUTOFF 8
-
-#define CYCLE (1 << L2CYCLE)
-#define MASK (CYCLE - 1)
-#define TOGGLE (CYCLE >> 1)
-
-#define CUTOFF (1 << L2CUTOFF)
-#define CUTMASK (CUTOFF - 1)
-
 /*
  * Implement modulo 2^46 multiplication.
  */
@@ -381,7 +399,7 @@ static time_t start_time;
 
 /*
  * These are used as the default seeds.  They must be identical to the
- * initial values of seed_lf[].
+ * initial values of rstate.seed_lf[].
  */
 
 static const double default_seed_lf[LONG_LAG] = {
@@ -392,17 +410,20 @@ static const double default_seed_lf[LONG_LAG] = {
     1440485417884.0,
 };
 
-static double seed_lf[CYCLE] = {
-    21443106311501.0 / T46, 5197437683097.0 / T46,  3622043880426.0 / T46,
-    53312694480426.0 / T46, 54665542338115.0 / T46, 51292272760733.0 / T46,
-    28013141389639.0 / T46, 6466909594288.0 / T46,  36631377956900.0 / T46,
-    45800305729322.0 / T46, 1486199964658.0 / T46,  1320339397524.0 / T46,
-    42446291962239.0 / T46, 8221323655096.0 / T46,  1104293620992.0 / T46,
-    2988247604277.0 / T46,  1440485417884.0 / T46,
+static RNUM_STATE rstate = {
+    {
+        21443106311501.0 / T46, 5197437683097.0 / T46,  3622043880426.0 / T46,
+        53312694480426.0 / T46, 54665542338115.0 / T46, 51292272760733.0 / T46,
+        28013141389639.0 / T46, 6466909594288.0 / T46,  36631377956900.0 / T46,
+        45800305729322.0 / T46, 1486199964658.0 / T46,  1320339397524.0 / T46,
+        42446291962239.0 / T46, 8221323655096.0 / T46,  1104293620992.0 / T46,
+        2988247604277.0 / T46,  1440485417884.0 / T46,
+    },
+    LONG_LAG - 1,
+    DEFAULT_SEED_HI,
+    DEFAULT_SEED_LO,
 };
 
-static int offset = LONG_LAG - 1;
-
 #define SEED(x, y)                                                             \
   {                                                                            \
     (double) x, T23 *(double)y                                                 \
@@ -5809,7 +5830,7 @@ static const Seed table_lf[NDIGITS][DIGIT][LONG_LAG][LONG_LAG] = {
  */
 
 static double
-advance_seed_lf(__INT_T n)
+advance_seed_lf(RNUM_STATE *s, __INT_T n)
 {
   __INT_T i, j, m, old_offset;
   const Seed *t0;
@@ -5829,11 +5850,11 @@ advance_seed_lf(__INT_T n)
    */
   if (n & CUTMASK)
     for (i = n & CUTMASK; i > 0; --i) {
-      offset = (offset + 1) & MASK;
-      seed_lf[offset] = seed_lf[(offset - SHORT_LAG) & MASK] +
-                        seed_lf[(offset - LONG_LAG) & MASK];
-      if (seed_lf[offset] > 1.0)
-        seed_lf[offset] -= 1.0;
+      s->offset = (s->offset + 1) & MASK;
+      s->seed_lf[s->offset] = s->seed_lf[(s->offset - SHORT_LAG) & MASK] +
+                              s->seed_lf[(s->offset - LONG_LAG) & MASK];
+      if (s->seed_lf[s->offset] > 1.0)
+        s->seed_lf[s->offset] -= 1.0;
     }
   if (n > CUTMASK) {
     n -= n & CUTMASK;
@@ -5841,14 +5862,14 @@ advance_seed_lf(__INT_T n)
      * Adjust to fit.  This way no offsets span the ends of the seed_lf
      * array, and the MASK is not needed below.
      */
-    if (LONG_LAG > (offset & (MASK >> 1))) {
-      old_offset = offset;
-      offset += LONG_LAG - (offset & (MASK >> 1));
-      offset &= MASK;
+    if (LONG_LAG > (s->offset & (MASK >> 1))) {
+      old_offset = s->offset;
+      s->offset += LONG_LAG - (s->offset & (MASK >> 1));
+      s->offset &= MASK;
       for (i = 0; i < LONG_LAG; ++i)
-        seed_lf[offset - i] = seed_lf[(old_offset - i) & MASK];
+        s->seed_lf[s->offset - i] = s->seed_lf[(old_offset - i) & MASK];
     }
-    offset &= MASK;
+    s->offset &= MASK;
     /*
      * Do big jumps by matrix multiplication.
      */
@@ -5861,26 +5882,26 @@ advance_seed_lf(__INT_T n)
        */
       i = n & (DIGIT);
       if (i) {
-        old_offset = offset;
-        offset ^= TOGGLE;
+        old_offset = s->offset;
+        s->offset ^= TOGGLE;
         t0 = table_lf[m][i - 1][0];
-        t1 = seed_lf + old_offset;
+        t1 = s->seed_lf + old_offset;
         i = T23 * *t1;
         yhi = R23 * i;
         ylo = *t1 - yhi;
         for (i = 0; i < LONG_LAG; ++i)
-          seed_lf[offset - i] = mul46(t0++, ylo, yhi);
+          s->seed_lf[s->offset - i] = mul46(t0++, ylo, yhi);
         for (j = 1; j < LONG_LAG; ++j) {
           --t1;
           i = T23 * *t1;
           yhi = R23 * i;
           ylo = *t1 - yhi;
           for (i = 0; i < LONG_LAG; ++i)
-            seed_lf[offset - i] += mul46(t0++, ylo, yhi);
+            s->seed_lf[s->offset - i] += mul46(t0++, ylo, yhi);
         }
         for (i = 0; i < LONG_LAG; ++i) {
-          j = seed_lf[offset - i];
-          seed_lf[offset - i] -= j;
+          j = s->seed_lf[s->offset - i];
+          s->seed_lf[s->offset - i] -= j;
         }
       }
       /*
@@ -5893,7 +5914,51 @@ advance_seed_lf(__INT_T n)
   /*
    * Return new value.
    */
-  return seed_lf[offset];
+  return s->seed_lf[s->offset];
+}
+
+/*
+ * Fill hb[1..n-1] with the values that follow hb[0], the current value.
+ * Once LONG_LAG values are in hb, each new one depends only on the values
+ * SHORT_LAG and LONG_LAG back in hb itself, so the recurrence runs straight
+ * down the array instead of through the seed_lf ring, and the wrap into
+ * [0,1] is done by subtracting a masked 1.0 rather than by a branch, which
+ * mispredicts about half the time.  SHORT_LAG independent chains are then
+ * in flight at once.  The ring is reloaded from the last LONG_LAG values;
+ * the results are exactly those of the loops below.
+ */
+
+#define FILL_MIN 64
+
+static void
+fill_lf(RNUM_STATE *s, __REAL8_T *hb, __INT_T n)
+{
+  union {
+    double d;
+    unsigned long long u;
+  } one, wrap;
+  __INT_T i;
+  double x;
+
+  for (i = 1; i < n && i < LONG_LAG; ++i) {
+    s->offset = (s->offset + 1) & MASK;
+    s->seed_lf[s->offset] = s->seed_lf[(s->offset - SHORT_LAG) & MASK] +
+                            s->seed_lf[(s->offset - LONG_LAG) & MASK];
+    if (s->seed_lf[s->offset] > 1.0)
+      s->seed_lf[s->offset] -= 1.0;
+    hb[i] = s->seed_lf[s->offset];
+  }
+  if (n <= LONG_LAG)
+    return;
+  one.d = 1.0;
+  for (i = LONG_LAG; i < n; ++i) {
+    x = hb[i - SHORT_LAG] + hb[i - LONG_LAG];
+    wrap.u = one.u & -(unsigned long long)(x > 1.0);
+    hb[i] = x - wrap.d;
+  }
+  s->offset = (s->offset + n - LONG_LAG) & MASK;
+  for (i = 0; i < LONG_LAG; ++i)
+    s->seed_lf[(s->offset - i) & MASK] = hb[n - 1 - i];
 }
 
 /*
@@ -5901,8 +5966,9 @@ advance_seed_lf(__INT_T n)
  * Recursive down to last dimension, where work is done.
  */
 
-static void I8(prng_loop_d_lf)(__REAL8_T *hb, F90_Desc *harvest, __INT_T li,
-                               int dim, __INT_T section_offset, __INT_T limit)
+static void I8(prng_loop_d_lf)(RNUM_STATE *s, __REAL8_T *hb,
+                               F90_Desc *harvest, __INT_T li, int dim,
+                               __INT_T section_offset, __INT_T limit)
 {
   DECL_DIM_PTRS(hdd);
   DECL_DIM_PTRS(tdd);
@@ -5924,7 +5990,7 @@ static void I8(prng_loop_d_lf)(__REAL8_T *hb, F90_Desc *harvest, __INT_T li,
       current = F90_DPTR_EXTENT_G(hdd) * section_offset +
                 (il - F90_DPTR_LBOUND_G(hdd));
       for (i = 0; i < n; ++i) {
-        I8(prng_loop_d_lf)(hb, harvest, lo, dim - 1, current + i, limit);
+        I8(prng_loop_d_lf)(s, hb, harvest, lo, dim - 1, current + i, limit);
         lo += F90_DPTR_SSTRIDE_G(hdd) * F90_DPTR_LSTRIDE_G(hdd);
       }
     }
@@ -5965,15 +6031,19 @@ static void I8(prng_loop_d_lf)(__REAL8_T *hb, F90_Desc *harvest, __INT_T li,
       /*
        * Fill the array with random numbers.
        */
-      hb[lo] = advance_seed_lf(current - last_i);
-      last_i = current + hi - lo;
+      hb[lo] = advance_seed_lf(s, current - s->last_i);
+      s->last_i = current + hi - lo;
+      if (hi - lo + 1 >= FILL_MIN) {
+        fill_lf(s, hb + lo, hi - lo + 1);
+        continue;
+      }
       for (i = lo + 1; i <= hi; ++i) {
-        offset = (offset + 1) & MASK;
-        seed_lf[offset] = seed_lf[(offset - SHORT_LAG) & MASK] +
-                          seed_lf[(offset - LONG_LAG) & MASK];
-        if (seed_lf[offset] > 1.0)
-          seed_lf[offset] -= 1.0;
-        hb[i] = seed_lf[offset];
+        s->offset = (s->offset + 1) & MASK;
+        s->seed_lf[s->offset] = s->seed_lf[(s->offset - SHORT_LAG) & MASK] +
+                                s->seed_lf[(s->offset - LONG_LAG) & MASK];
+        if (s->seed_lf[s->offset] > 1.0)
+          s->seed_lf[s->offset] -= 1.0;
+        hb[i] = s->seed_lf[s->offset];
       }
     }
   } else {
@@ -5986,17 +6056,22 @@ static void I8(prng_loop_d_lf)(__REAL8_T *hb, F90_Desc *harvest, __INT_T li,
                  F90_DPTR_LSTRIDE_G(hdd);
         current = F90_DPTR_EXTENT_G(hdd) * section_offset +
                   (il - F90_DPTR_LBOUND_G(hdd));
-        hb[lo] = advance_seed_lf(current - last_i);
+        hb[lo] = advance_seed_lf(s, current - s->last_i);
+        s->last_i = current + n - 1;
+        if (n >= FILL_MIN &&
+            F90_DPTR_SSTRIDE_G(hdd) * F90_DPTR_LSTRIDE_G(hdd) == 1) {
+          fill_lf(s, hb + lo, n);
+          continue;
+        }
         for (i = 1; i < n; ++i) {
           lo += F90_DPTR_SSTRIDE_G(hdd) * F90_DPTR_LSTRIDE_G(hdd);
-          offset = (offset + 1) & MASK;
-          seed_lf[offset] = seed_lf[(offset - SHORT_LAG) & MASK] +
-                            seed_lf[(offset - LONG_LAG) & MASK];
-          if (seed_lf[offset] > 1.0)
-            seed_lf[offset] -= 1.0;
-          hb[lo] = seed_lf[offset];
+          s->offset = (s->offset + 1) & MASK;
+          s->seed_lf[s->offset] = s->seed_lf[(s->offset - SHORT_LAG) & MASK] +
+                                  s->seed_lf[(s->offset - LONG_LAG) & MASK];
+          if (s->seed_lf[s->offset] > 1.0)
+            s->seed_lf[s->offset] -= 1.0;
+          hb[lo] = s->seed_lf[s->offset];
         }
-        last_i = current + n - 1;
       }
     }
   }
@@ -6007,8 +6082,9 @@ static void I8(prng_loop_d_lf)(__REAL8_T *hb, F90_Desc *harvest, __INT_T li,
  * Recursive down to last dimension, where work is done.
  */
 
-static void I8(prng_loop_r_lf)(__REAL4_T *hb, F90_Desc *harvest, __INT_T li,
-                               int dim, __INT_T section_offset, __INT_T limit)
+static void I8(prng_loop_r_lf)(RNUM_STATE *s, __REAL4_T *hb,
+                               F90_Desc *harvest, __INT_T li, int dim,
+                               __INT_T section_offset, __INT_T limit)
 {
   DECL_DIM_PTRS(hdd);
   DECL_DIM_PTRS(tdd);
@@ -6030,7 +6106,7 @@ static void I8(prng_loop_r_lf)(__REAL4_T *hb, F90_Desc *harvest, __INT_T li,
       current = F90_DPTR_EXTENT_G(hdd) * section_offset +
                 (il - F90_DPTR_LBOUND_G(hdd));
       for (i = 0; i < n; ++i) {
-        I8(prng_loop_r_lf)(hb, harvest, lo, dim - 1, current + i, limit);
+        I8(prng_loop_r_lf)(s, hb, harvest, lo, dim - 1, current + i, limit);
         lo += F90_DPTR_SSTRIDE_G(hdd) * F90_DPTR_LSTRIDE_G(hdd);
       }
     }
@@ -6071,15 +6147,15 @@ static void I8(prng_loop_r_lf)(__REAL4_T *hb, F90_Desc *harvest, __INT_T li,
       /*
        * Fill the array with random numbers.
        */
-      hb[lo] = advance_seed_lf(current - last_i);
-      last_i = current + hi - lo;
+      hb[lo] = advance_seed_lf(s, current - s->last_i);
+      s->last_i = current + hi - lo;
       for (i = lo + 1; i <= hi; ++i) {
-        offset = (offset + 1) & MASK;
-        seed_lf[offset] = seed_lf[(offset - SHORT_LAG) & MASK] +
-                          seed_lf[(offset - LONG_LAG) & MASK];
-        if (seed_lf[offset] > 1.0)
-          seed_lf[offset] -= 1.0;
-        hb[i] = seed_lf[offset];
+        s->offset = (s->offset + 1) & MASK;
+        s->seed_lf[s->offset] = s->seed_lf[(s->offset - SHORT_LAG) & MASK] +
+                                s->seed_lf[(s->offset - LONG_LAG) & MASK];
+        if (s->seed_lf[s->offset] > 1.0)
+          s->seed_lf[s->offset] -= 1.0;
+        hb[i] = s->seed_lf[s->offset];
       }
     }
   } else {
@@ -6092,17 +6168,17 @@ static void I8(prng_loop_r_lf)(__REAL4_T *hb, F90_Desc *harvest, __INT_T li,
                  F90_DPTR_LSTRIDE_G(hdd);
         current = F90_DPTR_EXTENT_G(hdd) * section_offset +
                   (il - F90_DPTR_LBOUND_G(hdd));
-        hb[lo] = advance_seed_lf(current - last_i);
+        hb[lo] = advance_seed_lf(s, current - s->last_i);
         for (i = 1; i < n; ++i) {
           lo += F90_DPTR_SSTRIDE_G(hdd) * F90_DPTR_LSTRIDE_G(hdd);
-          offset = (offset + 1) & MASK;
-          seed_lf[offset] = seed_lf[(offset - SHORT_LAG) & MASK] +
-                            seed_lf[(offset - LONG_LAG) & MASK];
-          if (seed_lf[offset] > 1.0)
-            seed_lf[offset] -= 1.0;
-          hb[lo] = seed_lf[offset];
+          s->offset = (s->offset + 1) & MASK;
+          s->seed_lf[s->offset] = s->seed_lf[(s->offset - SHORT_LAG) & MASK] +
+                                  s->seed_lf[(s->offset - LONG_LAG) & MASK];
+          if (s->seed_lf[s->offset] > 1.0)
+            s->seed_lf[s->offset] -= 1.0;
+          hb[lo] = s->seed_lf[s->offset];
         }
-        last_i = current + n - 1;
+        s->last_i = current + n - 1;
       }
     }
   }
@@ -6116,11 +6192,11 @@ static void I8(prng_loop_r_lf)(__REAL4_T *hb, F90_Desc *harvest, __INT_T li,
 
 static int fibonacci = 1;
 
-static double (*advance_seed)(__INT_T) = advance_seed_lf;
-static void (*prng_loop_d)(__REAL8_T *, F90_Desc *, __INT_T, int, __INT_T,
-                           __INT_T) = I8(prng_loop_d_lf);
-static void (*prng_loop_r)(__REAL4_T *, F90_Desc *, __INT_T, int, __INT_T,
-                           __INT_T) = I8(prng_loop_r_lf);
+static double (*advance_seed)(RNUM_STATE *, __INT_T) = advance_seed_lf;
+static void (*prng_loop_d)(RNUM_STATE *, __REAL8_T *, F90_Desc *, __INT_T, int,
+                           __INT_T, __INT_T) = I8(prng_loop_d_lf);
+static void (*prng_loop_r)(RNUM_STATE *, __REAL4_T *, F90_Desc *, __INT_T, int,
+                           __INT_T, __INT_T) = I8(prng_loop_r_lf);
 
 static void
 set_fibonacci(void)
@@ -6140,6 +6216,63 @@ set_npb(void)
   prng_loop_r = I8(prng_loop_r_npb);
 }
 
+/*
+ * Per-thread streams.  When F90_RANDOM_THREADS is set (to yes or to a
+ * nonzero number), RANDOM_NUMBER called in an OpenMP parallel region draws
+ * from a stream belonging to the calling thread number instead of taking
+ * sem.  The stream of thread t is the program-wide stream as it stood when
+ * a region first needed streams after the latest RANDOM_SEED, skipped ahead
+ * by (t + 1) * STREAM_SKIP values; so for a given seed the numbers a thread
+ * gets depend only on its thread number.  Nested regions, active or not,
+ * and threads numbered MAX_STREAMS or more, use the program-wide stream as
+ * before; in an inactive nested region every outer thread is thread 0.
+ */
+
+#define STREAM_SKIP (1 << 30)
+#define MAX_STREAMS 256
+
+static int rnum_threads = -1; /* F90_RANDOM_THREADS, once read */
+static int rnum_gen;          /* bumped when RANDOM_SEED sets the seed */
+static int base_gen = -1;     /* rnum_gen when base was taken */
+static RNUM_STATE base;       /* rstate that the streams are derived from */
+static RNUM_STATE *streams[MAX_STREAMS];
+
+static RNUM_STATE *
+thread_stream(void)
+{
+  RNUM_STATE *s;
+  char *p;
+  int i, t;
+
+  if (rnum_threads < 0) {
+    p = __fort_getenv("F90_RANDOM_THREADS");
+    rnum_threads = p != NULL && (strstr(p, "yes") != NULL || atoi(p) > 0);
+  }
+  if (!rnum_threads || omp_get_active_level() != 1 || omp_get_level() != 1)
+    return NULL;
+  t = omp_get_thread_num();
+  if (t < 0 || t >= MAX_STREAMS)
+    return NULL;
+  s = streams[t];
+  if (s != NULL && s->gen == rnum_gen)
+    return s;
+  MP_P(sem);
+  if (s == NULL) {
+    s = (RNUM_STATE *)__fort_malloc(sizeof(RNUM_STATE));
+    streams[t] = s;
+  }
+  if (base_gen != rnum_gen) {
+    base = rstate;
+    base_gen = rnum_gen;
+  }
+  *s = base;
+  for (i = 0; i <= t; ++i)
+    (void)advance_seed(s, STREAM_SKIP);
+  s->gen = rnum_gen;
+  MP_V(sem);
+  return s;
+}
+
 /*
  * Determine how many dimensions are exactly contained on this processor of
  * this array section.  The stride must be one, the dimension must not be
@@ -6170,56 +6303,70 @@ static int I8(level)(F90_Desc *harvest)
  * Single precision, pseudo-random number generator, RANDOM_NUMBER.
  */
 
-void ENTFTN(RNUM, rnum)(__REAL4_T *hb, F90_Desc *harvest)
+static void I8(rnum_r)(RNUM_STATE *s, __REAL4_T *hb, F90_Desc *harvest)
 {
   __INT_T final, i;
   int itmp;
   double tmp1, tmp2;
 
-  MP_P(sem);
   if (F90_TAG_G(harvest) == __DESC) {
-    if (F90_GSIZE_G(harvest) <= 0) {
-      MP_V(sem);
+    if (F90_GSIZE_G(harvest) <= 0)
       return;
-    }
-    last_i = -1;
+    s->last_i = -1;
     if (~F90_FLAGS_G(harvest) & __OFF_TEMPLATE) {
       I8(__fort_cycle_bounds)(harvest);
       i = I8(level)(harvest);
-      prng_loop_r(hb, harvest, F90_LBASE_G(harvest) - 1, F90_RANK_G(harvest), 0,
-                  i);
+      prng_loop_r(s, hb, harvest, F90_LBASE_G(harvest) - 1,
+                  F90_RANK_G(harvest), 0, i);
     }
     final = F90_GSIZE_G(harvest) - 1;
-    if (last_i < final)
-      (void)advance_seed(final - last_i);
+    if (s->last_i < final)
+      (void)advance_seed(s, final - s->last_i);
 #ifdef DEBUG
-    else if (last_i != final)
+    else if (s->last_i != final)
       rnum_abort(__FILE__, __LINE__,
                  "random_number:  internal error:  last_i != final");
 #endif
   } else {
     if (fibonacci) {
-      offset = (offset + 1) & MASK;
-      seed_lf[offset] = seed_lf[(offset - SHORT_LAG) & MASK] +
-                        seed_lf[(offset - LONG_LAG) & MASK];
-      if (seed_lf[offset] > 1.0)
-        seed_lf[offset] -= 1.0;
-      *hb = seed_lf[offset];
+      s->offset = (s->offset + 1) & MASK;
+      s->seed_lf[s->offset] = s->seed_lf[(s->offset - SHORT_LAG) & MASK] +
+                              s->seed_lf[(s->offset - LONG_LAG) & MASK];
+      if (s->seed_lf[s->offset] > 1.0)
+        s->seed_lf[s->offset] -= 1.0;
+      *hb = s->seed_lf[s->offset];
       if (*hb == (float)1.0) {
         itmp = 0x3F7FFFFF;
         *hb = *(float *)&itmp;
       }
     } else {
-      tmp1 = seed_lo * table[0][0];
+      tmp1 = s->seed_lo * table[0][0];
       itmp = T23 * tmp1;
       tmp2 = R23 * itmp;
-      seed_hi = tmp2 + seed_lo * table[0][1] + seed_hi * table[0][0];
-      seed_lo = tmp1 - tmp2;
-      itmp = seed_hi;
-      seed_hi -= itmp;
-      *hb = seed_lo + seed_hi;
+      s->seed_hi = tmp2 + s->seed_lo * table[0][1] + s->seed_hi * table[0][0];
+      s->seed_lo = tmp1 - tmp2;
+      itmp = s->seed_hi;
+      s->seed_hi -= itmp;
+      *hb = s->seed_lo + s->seed_hi;
     }
   }
+}
+
+/*
+ * Single precision RANDOM_NUMBER: from the calling thread's own stream in a
+ * parallel region if per-thread streams are on, else from rstate under sem.
+ */
+
+void ENTFTN(RNUM, rnum)(__REAL4_T *hb, F90_Desc *harvest)
+{
+  RNUM_STATE *s = thread_stream();
+
+  if (s != NULL) {
+    I8(rnum_r)(s, hb, harvest);
+    return;
+  }
+  MP_P(sem);
+  I8(rnum_r)(&rstate, hb, harvest);
   MP_V(sem);
 }
 
@@ -6227,52 +6374,66 @@ void ENTFTN(RNUM, rnum)(__REAL4_T *hb, F90_Desc *harvest)
  * Double precision, pseudo-random number generator, RANDOM_NUMBER.
  */
 
-void ENTFTN(RNUMD, rnumd)(__REAL8_T *hb, F90_Desc *harvest)
+static void I8(rnum_d)(RNUM_STATE *s, __REAL8_T *hb, F90_Desc *harvest)
 {
   __INT_T final, i;
   int itmp;
   double tmp1, tmp2;
 
-  MP_P(sem);
   if (F90_TAG_G(harvest) == __DESC) {
-    if (F90_GSIZE_G(harvest) <= 0) {
-      MP_V(sem);
+    if (F90_GSIZE_G(harvest) <= 0)
       return;
-    }
-    last_i = -1;
+    s->last_i = -1;
     if (~F90_FLAGS_G(harvest) & __OFF_TEMPLATE) {
       I8(__fort_cycle_bounds)(harvest);
       i = I8(level)(harvest);
-      prng_loop_d(hb, harvest, F90_LBASE_G(harvest) - 1, F90_RANK_G(harvest), 0,
-                  i);
+      prng_loop_d(s, hb, harvest, F90_LBASE_G(harvest) - 1,
+                  F90_RANK_G(harvest), 0, i);
     }
     final = F90_GSIZE_G(harvest) - 1;
-    if (last_i < final)
-      (void)advance_seed(final - last_i);
+    if (s->last_i < final)
+      (void)advance_seed(s, final - s->last_i);
 #ifdef DEBUG
-    else if (last_i != final)
+    else if (s->last_i != final)
       rnum_abort(__FILE__, __LINE__,
                  "random_number:  internal error:  last_i != final");
 #endif
   } else {
     if (fibonacci) {
-      offset = (offset + 1) & MASK;
-      seed_lf[offset] = seed_lf[(offset - SHORT_LAG) & MASK] +
-                        seed_lf[(offset - LONG_LAG) & MASK];
-      if (seed_lf[offset] > 1.0)
-        seed_lf[offset] -= 1.0;
-      *hb = seed_lf[offset];
+      s->offset = (s->offset + 1) & MASK;
+      s->seed_lf[s->offset] = s->seed_lf[(s->offset - SHORT_LAG) & MASK] +
+                              s->seed_lf[(s->offset - LONG_LAG) & MASK];
+      if (s->seed_lf[s->offset] > 1.0)
+        s->seed_lf[s->offset] -= 1.0;
+      *hb = s->seed_lf[s->offset];
     } else {
-      tmp1 = seed_lo * table[0][0];
+      tmp1 = s->seed_lo * table[0][0];
       itmp = T23 * tmp1;
       tmp2 = R23 * itmp;
-      seed_hi = tmp2 + seed_lo * table[0][1] + seed_hi * table[0][0];
-      seed_lo = tmp1 - tmp2;
-      itmp = seed_hi;
-      seed_hi -= itmp;
-      *hb = seed_lo + seed_hi;
+      s->seed_hi = tmp2 + s->seed_lo * table[0][1] + s->seed_hi * table[0][0];
+      s->seed_lo = tmp1 - tmp2;
+      itmp = s->seed_hi;
+      s->seed_hi -= itmp;
+      *hb = s->seed_lo + s->seed_hi;
     }
   }
+}
+
+/*
+ * Double precision RANDOM_NUMBER: from the calling thread's own stream in a
+ * parallel region if per-thread streams are on, else from rstate under sem.
+ */
+
+void ENTFTN(RNUMD, rnumd)(__REAL8_T *hb, F90_Desc *harvest)
+{
+  RNUM_STATE *s = thread_stream();
+
+  if (s != NULL) {
+    I8(rnum_d)(s, hb, harvest);
+    return;
+  }
+  MP_P(sem);
+  I8(rnum_d)(&rstate, hb, harvest);
   MP_V(sem);
 }
 
@@ -6325,9 +6486,10 @@ void ENTFTN(RSEED, rseed)(void *size, __INT_T *putb, __INT_T *getb,
   int list[LONG_LAG][2];
   __INT_T extent, index;
   char *static_seed;
-  
+  int was_fibonacci;
 
   MP_P(sem);
+  was_fibonacci = fibonacci;
   no_args_present = 1;
   vhi = vlo = 0;
   /*
@@ -6348,22 +6510,21 @@ void ENTFTN(RSEED, rseed)(void *size, __INT_T *putb, __INT_T *getb,
 /*
  * SEED_LO:
  */
-      vlo = T46 * seed_lo;
+      vlo = T46 * rstate.seed_lo;
       I8(__fort_store_int_element)(getb, getd, 1, vlo);
 /*
  * SEED_HI:
  */
-      vhi = T23 * seed_hi;
+      vhi = T23 * rstate.seed_hi;
       I8(__fort_store_int_element)(getb, getd, 2, vhi);
 
     } else {
 
       set_fibonacci();
       for (i = 0; i < LONG_LAG; ++i) {
-        vhi = T23 * seed_lf[(offset + (CYCLE - LONG_LAG + 1) + i) & MASK];
-        vlo =
-            T23 *
-            (T23 * seed_lf[(offset + (CYCLE - LONG_LAG + 1) + i) & MASK] - vhi);
+        j = (rstate.offset + (CYCLE - LONG_LAG + 1) + i) & MASK;
+        vhi = T23 * rstate.seed_lf[j];
+        vlo = T23 * (T23 * rstate.seed_lf[j] - vhi);
         I8(__fort_store_int_element)(getb, getd, 2 * i + 1, vlo);
         I8(__fort_store_int_element)(getb, getd, 2 * i + 2, vhi);
       }
@@ -6392,16 +6553,16 @@ void ENTFTN(RSEED, rseed)(void *size, __INT_T *putb, __INT_T *getb,
          * SEED_LO:
          */
         vlo = I8(__fort_fetch_int_element)(putb, putd, 1);
-        seed_lo = R46 * (vlo & MASK23);
+        rstate.seed_lo = R46 * (vlo & MASK23);
         /*
          * SEED_HI:
          */
         vhi = I8(__fort_fetch_int_element)(putb, putd, 2);
-        seed_hi = R23 * (vhi & MASK23);
+        rstate.seed_hi = R23 * (vhi & MASK23);
       } else {
 
         set_fibonacci();
-        offset = LONG_LAG - 1;
+        rstate.offset = LONG_LAG - 1;
         for (i = 0; i < LONG_LAG; ++i)
           for (j = 0; j < 2; ++j) {
             index = F90_DIM_LBOUND_G(putd, 0) + (2 * i + j);
@@ -6409,7 +6570,7 @@ void ENTFTN(RSEED, rseed)(void *size, __INT_T *putb, __INT_T *getb,
             list[i][j] &= 0x7fffff;
           }
         for (i = 0; i < LONG_LAG; ++i) {
-          seed_lf[i] = R23 * (R23 * list[i][0] + list[i][1]);
+          rstate.seed_lf[i] = R23 * (R23 * list[i][0] + list[i][1]);
           vlo |= list[i][0];
           vhi |= list[i][1];
         }
@@ -6423,10 +6584,10 @@ void ENTFTN(RSEED, rseed)(void *size, __INT_T *putb, __INT_T *getb,
       vhi = *putb & MASK23;
       if (fibonacci)
         for (i = 0; i < LONG_LAG; ++i)
-          seed_lf[i] = R23 * (R23 * vlo + vhi);
+          rstate.seed_lf[i] = R23 * (R23 * vlo + vhi);
       else {
-        seed_lo = R46 * vlo;
-        seed_hi = R23 * vhi;
+        rstate.seed_lo = R46 * vlo;
+        rstate.seed_hi = R23 * vhi;
       }
     }
     /*
@@ -6453,9 +6614,9 @@ void ENTFTN(RSEED, rseed)(void *size, __INT_T *putb, __INT_T *getb,
    */
   if (no_args_present) {
     if (fibonacci) {
-      offset = LONG_LAG - 1;
+      rstate.offset = LONG_LAG - 1;
       for (i = 0; i < LONG_LAG; ++i)
-        seed_lf[i] = R46 * default_seed_lf[i];
+        rstate.seed_lf[i] = R46 * default_seed_lf[i];
 
       static_seed = __fort_getenv("STATIC_RANDOM_SEED");
       if (static_seed == NULL || strstr(static_seed, "yes") == 0) {
@@ -6481,12 +6642,17 @@ void ENTFTN(RSEED, rseed)(void *size, __INT_T *putb, __INT_T *getb,
           if (start_time_int < 0)
             start_time = start_time_int & 0x7fffffff;
         }
-        advance_seed_lf(start_time);
+        advance_seed_lf(&rstate, start_time);
       }
     } else {
-      seed_lo = DEFAULT_SEED_LO;
-      seed_hi = DEFAULT_SEED_HI;
+      rstate.seed_lo = DEFAULT_SEED_LO;
+      rstate.seed_hi = DEFAULT_SEED_HI;
     }
   }
+  /*
+   * Per-thread streams are derived afresh from a new seed or generator.
+   */
+  if (ISPRESENT(putb) || no_args_present || fibonacci != was_fibonacci)
+    ++rnum_gen;
   MP_V(sem);
 }
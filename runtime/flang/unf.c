@@ -12,9 +12,14 @@
  */
 
 #include <string.h>
+#ifndef _WIN64
+#include <unistd.h>
+#include <sys/uio.h>
+#endif
 #include "global.h"
 #include "fioMacros.h"
 #include "async.h"
+#include "dirmap.h"
 
 static int __unf_init(bool, bool);
 static int __unf_end(bool);
@@ -24,6 +29,12 @@ extern int __f90io_usw_write(int, long, int, char *, __CLEN_T);
 extern int __f90io_usw_end(void);
 static int skip_to_nextrec(void);
 static bool unf_fwrite(char *, size_t, size_t, FIO_FCB *);
+static int unf_zeropad(FIO_FCB *, long);
+static bool unf_direct(FIO_FCB *, size_t);
+static bool unf_write_direct(FIO_FCB *, char *, size_t, char *, size_t);
+static bool usw_write_direct(FIO_FCB *, char *, size_t, char *, size_t, int,
+                             __CLEN_T);
+static size_t unf_fread(char *, size_t, FIO_FCB *);
 
 /* define a few things for run-time tracing */
 static int dbgflag;
@@ -33,6 +44,12 @@ static int dbgflag;
 #define IOBUFSIZE 4096
 
 #define MAX_REC_SIZE (0x7fffffff - 8) /* -8 to allow for two length words */
+
+/* Contiguous transfers of at least this many bytes go straight between the
+ * program's memory and the file descriptor instead of through stdio.  With
+ * byte swapping the data is swapped in chunks of USW_CHUNK bytes. */
+#define UNF_DIRECT_MIN 65536
+#define USW_CHUNK 65536
 #define CONT_FLAG 0x80000000          /* sign bit is continuation flag */
 #define CONT_FLAG_SW 0x00000080       /* byte-swapped continuation flag */
 #define TO_BE_CONTINUED TRUE
@@ -47,19 +64,19 @@ static int dbgflag;
  * and updated on __f90io_unf_writes and __f90io_unf_reads. All are
  * active till an __f90io_unf_end.  */
 
-static FIO_FCB *Fcb;     /* pointer to the file control block */
-static char *buf_ptr;    /* pointer to current location in buffer */
-static size_t rw_size;   /* size of user-requested items (write only) */
-static int rec_len;      /* record length */
-static bool rec_in_buf;  /* true if variable len record in buffer; false
+static FIO_TLS FIO_FCB *Fcb;     /* pointer to the file control block */
+static FIO_TLS char *buf_ptr;    /* pointer to current location in buffer */
+static FIO_TLS size_t rw_size;   /* size of user-requested items (write only) */
+static FIO_TLS int rec_len;      /* record length */
+static FIO_TLS bool rec_in_buf;  /* true if variable len record in buffer; false
                             if access is direct. */
-static bool read_flag;   /* true if a read, otherwise a write */
-static bool io_transfer; /* indicates that init-end calls were made
+static FIO_TLS bool read_flag;   /* true if a read, otherwise a write */
+static FIO_TLS bool io_transfer; /* indicates that init-end calls were made
                             with no intervening read or write calls */
-static bool continued;   /* data requires multople records */
-static bool async;       /* true if asynch i/o requested */
-static bool actual_init;
-static int has_same_fcb;
+static FIO_TLS bool continued;   /* data requires multople records */
+static FIO_TLS bool async;       /* true if asynch i/o requested */
+static FIO_TLS bool actual_init;
+static FIO_TLS int has_same_fcb;
 
 /*
  * define a structure which can be used to buffer a variable length
@@ -102,7 +119,7 @@ typedef struct {
   int pad;             /* just in case we need trailing count */
 } unf_rec_struct;
 
-static unf_rec_struct unf_rec;
+static FIO_TLS unf_rec_struct unf_rec;
 
 typedef struct {
   FIO_FCB *Fcb;
@@ -120,11 +137,11 @@ typedef struct {
 
 #define GBL_SIZE 5
 
-static G static_gbl[GBL_SIZE];
-static G *gbl = &static_gbl[0];
-static G *gbl_head = &static_gbl[0];
-static int gbl_avl = 0;
-static int gbl_size = GBL_SIZE;
+static FIO_TLS G static_gbl[GBL_SIZE];
+static FIO_TLS G *gbl;      /* set by allocate_new_gbl() */
+static FIO_TLS G *gbl_head;
+static FIO_TLS int gbl_avl = 0;
+static FIO_TLS int gbl_size = GBL_SIZE;
 
 #define WRITE_UNF_LEN (unf_fwrite((char *)&unf_rec.u.s.bytecnt, RCWSZ, 1, Fcb) != TRUE)
 #define WRITE_UNF_REC \
@@ -137,7 +154,9 @@ adjust_fpos(FIO_FCB *cur_file, long offset, int whence)
   int retval;
 
   if (cur_file->asy_rw) {
-    Fio_asy_fseek(cur_file->asyptr, offset, whence);
+    retval = Fio_asy_fseek(cur_file->asyptr, offset, whence);
+  } else if (whence == SEEK_CUR && Fio_map_active(cur_file->mapptr)) {
+    retval = Fio_map_skip(cur_file->mapptr, offset);
   } else {
     retval = __io_fseek(cur_file->fp, offset, whence);
   }
@@ -188,6 +207,8 @@ static void
 allocate_new_gbl()
 {
   G *tmp_gbl;
+  if (gbl_head == NULL) /* first statement on this thread */
+    gbl_head = &static_gbl[0];
   if (gbl_avl >= gbl_size) {
     if (gbl_size == GBL_SIZE) {
       gbl_size = gbl_size + 15;
@@ -234,6 +255,8 @@ unf_fwrite(char *buf, size_t size, size_t num, FIO_FCB *fcb)
   if (fcb->asy_rw) {
     /* Do this write asynchronously. */
     return (Fio_asy_write(fcb->asyptr, buf, size * num) == 0);
+  } else if (Fio_map_active(fcb->mapptr)) {
+    return (Fio_map_write(fcb->mapptr, buf, size * num) == 0);
   } else {
     /* Do this write "normally." */
     return (FWRITE(buf, size, num, fcb->fp) == num);
@@ -241,6 +264,210 @@ unf_fwrite(char *buf, size_t size, size_t num, FIO_FCB *fcb)
   return FALSE;
 }
 
+/** \brief
+ * Write \p len zero bytes; return 0 or an error code.  While async i/o is
+ * active the stream is not positioned, so the zeros are queued instead;
+ * records of a mapped file are cleared in memory.
+ */
+static int
+unf_zeropad(FIO_FCB *fcb, long len)
+{
+  static const char zeros[IOBUFSIZE];
+  long n;
+
+  if (Fio_map_active(fcb->mapptr))
+    return Fio_map_zero(fcb->mapptr, len) == 0 ? 0 : __io_errno();
+  if (!fcb->asy_rw)
+    return __fortio_zeropad(fcb->fp, len);
+  while (len > 0) {
+    n = len < IOBUFSIZE ? len : IOBUFSIZE;
+    if (Fio_asy_write(fcb->asyptr, (char *)zeros, n) == -1)
+      return __io_errno();
+    len -= n;
+  }
+  return 0;
+}
+
+/* ----------------------------------------------------------------------- */
+
+/** \brief
+ * TRUE if a contiguous transfer of \p nbytes should bypass stdio.
+ */
+static bool
+unf_direct(FIO_FCB *fcb, size_t nbytes)
+{
+#ifndef _WIN64
+  return nbytes >= UNF_DIRECT_MIN && !fcb->asy_rw && !fcb->ispipe &&
+         !Fio_map_active(fcb->mapptr);
+#else
+  return FALSE;
+#endif
+}
+
+#ifndef _WIN64
+/* write all of iov[0..cnt-1] to fd */
+static bool
+direct_writev(int fd, struct iovec *iov, int cnt)
+{
+  ssize_t n;
+
+  while (cnt > 0) {
+    n = writev(fd, iov, cnt);
+    if (n == -1) {
+      if (__io_errno() == EINTR)
+        continue;
+      return FALSE;
+    }
+    while (cnt > 0 && (size_t)n >= iov->iov_len) {
+      n -= iov->iov_len;
+      ++iov;
+      --cnt;
+    }
+    if (cnt > 0) {
+      iov->iov_base = (char *)iov->iov_base + n;
+      iov->iov_len -= n;
+    }
+  }
+  return TRUE;
+}
+
+/* Writes went past the stream; tell it where the file now is. */
+static bool
+direct_resync(FIO_FCB *fcb)
+{
+  seekoffx_t pos;
+
+  pos = lseek(__io_getfd(fcb->fp), 0, SEEK_CUR);
+  if (pos == -1)
+    return FALSE;
+  return __io_fseekx(fcb->fp, pos, SEEK_SET) == 0;
+}
+#endif
+
+/** \brief
+ * Write \p buflen bytes at \p buf followed by \p nbytes at \p item with
+ * as few system calls as possible; return TRUE if successful.
+ */
+static bool
+unf_write_direct(FIO_FCB *fcb, char *buf, size_t buflen, char *item,
+                 size_t nbytes)
+{
+#ifndef _WIN64
+  struct iovec iov[2];
+
+  if (__io_fflush(fcb->fp) != 0)
+    return FALSE;
+  iov[0].iov_base = buf;
+  iov[0].iov_len = buflen;
+  iov[1].iov_base = item;
+  iov[1].iov_len = nbytes;
+  if (!direct_writev(__io_getfd(fcb->fp), iov, 2))
+    return FALSE;
+  return direct_resync(fcb);
+#else
+  if (buflen && FWRITE(buf, buflen, 1, fcb->fp) != 1)
+    return FALSE;
+  return FWRITE(item, nbytes, 1, fcb->fp) == 1;
+#endif
+}
+
+/** \brief
+ * Like unf_write_direct(), but the \p nbytes at \p item are byte swapped
+ * on the way out.  The program's data is left alone; each chunk is
+ * swapped in a scratch buffer.
+ */
+static bool
+usw_write_direct(FIO_FCB *fcb, char *buf, size_t buflen, char *item,
+                 size_t nbytes, int type, __CLEN_T item_length)
+{
+  char *chunk;
+  size_t csize, n;
+  bool ok = TRUE;
+
+  csize = USW_CHUNK / item_length * item_length;
+  chunk = (char *)malloc(csize);
+  if (chunk == NULL) {
+    __io_set_errno(FIO_ENOMEM);
+    return FALSE;
+  }
+#ifndef _WIN64
+  {
+    struct iovec iov[2];
+    int cnt;
+
+    if (__io_fflush(fcb->fp) != 0)
+      ok = FALSE;
+    iov[0].iov_base = buf;
+    iov[0].iov_len = buflen;
+    while (ok && nbytes > 0) {
+      n = nbytes < csize ? nbytes : csize;
+      memcpy(chunk, item, n);
+      __fortio_swap_bytes(chunk, type, n / item_length);
+      cnt = 0;
+      if (iov[0].iov_len)
+        ++cnt;
+      iov[cnt].iov_base = chunk;
+      iov[cnt].iov_len = n;
+      ok = direct_writev(__io_getfd(fcb->fp), iov, cnt + 1);
+      iov[0].iov_len = 0;
+      item += n;
+      nbytes -= n;
+    }
+    if (ok)
+      ok = direct_resync(fcb);
+  }
+#else
+  if (buflen && FWRITE(buf, buflen, 1, fcb->fp) != 1)
+    ok = FALSE;
+  while (ok && nbytes > 0) {
+    n = nbytes < csize ? nbytes : csize;
+    memcpy(chunk, item, n);
+    __fortio_swap_bytes(chunk, type, n / item_length);
+    ok = FWRITE(chunk, n, 1, fcb->fp) == 1;
+    item += n;
+    nbytes -= n;
+  }
+#endif
+  free(chunk);
+  return ok;
+}
+
+/** \brief
+ * fread() of one item of \p size bytes; large reads go straight into
+ * \p buf, and records of a mapped file are copied from memory.
+ */
+static size_t
+unf_fread(char *buf, size_t size, FIO_FCB *fcb)
+{
+#ifndef _WIN64
+  seekoffx_t pos;
+  size_t got;
+  ssize_t n;
+
+  if (Fio_map_active(fcb->mapptr))
+    return Fio_map_read(fcb->mapptr, buf, size) == 0;
+  if (unf_direct(fcb, size) && (pos = __io_ftellx(fcb->fp)) != -1) {
+    got = 0;
+    while (got < size) {
+      n = pread(__io_getfd(fcb->fp), buf + got, size - got, pos + got);
+      if (n == -1 && __io_errno() == EINTR)
+        continue;
+      if (n <= 0)
+        break;
+      got += n;
+    }
+    if (__io_fseekx(fcb->fp, pos + got, SEEK_SET) != 0)
+      return 0;
+    if (got == size)
+      return 1;
+    /* let stdio find the end of file or the error */
+    buf += got;
+    size -= got;
+  }
+#endif
+  return __io_fread(buf, size, 1, fcb->fp);
+}
+
 /* initialize asynch i/o, called before Fio_unf_init */
 
 int
@@ -288,7 +515,9 @@ __f90io_unf_init(__INT_T *read,   /* TRUE indicates READ statement. */
     __fortio_errinit03(*unit, *bitv, iostat, "unformatted write");
 
   allocate_new_gbl();
+  fioFcbTbls.asy_write = async && !*read;
   Fcb = __fortio_rwinit(*unit, FIO_UNFORMATTED, rec, 1 - *read);
+  fioFcbTbls.asy_write = FALSE;
 
   if (Fcb == NULL) {
     if (fioFcbTbls.eof)
@@ -419,7 +648,7 @@ ENTF90IO(UNF_INIT, unf_init)
   __fort_status_init(bitv, iostat);
   if (LOCAL_MODE || GET_DIST_LCPU == GET_DIST_IOPROC)
     s = __f90io_unf_init(read, unit, rec, bitv, iostat);
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -497,7 +726,7 @@ unf_read_do_resid:
       }
       return (0);
     }
-    if (__io_fread(item, nbytes, 1, Fcb->fp) != 1) {
+    if (unf_fread(item, nbytes, Fcb) != 1) {
       if (__io_feof(Fcb->fp)) {
         ret_val = __fortio_error(FIO_EEOF);
         if (Fcb->partial) {
@@ -537,7 +766,7 @@ unf_read_do_resid:
             bytes needed to fill the item (item_length - offset) */
     read_length =
         (nbytes < item_length - offset ? nbytes : item_length - offset);
-    if (__io_fread(item + offset, read_length, 1, Fcb->fp) != 1) {
+    if (unf_fread(item + offset, read_length, Fcb) != 1) {
       if (__io_feof(Fcb->fp))
         ret_val = __fortio_error(FIO_EEOF);
       else
@@ -567,9 +796,11 @@ unf_read_do_resid:
 
   return 0;
 unfr_err:
-  free_gbl();
-  restore_gbl();
-  __fortio_errend03();
+  if (__fortio_leaves_stmt(ret_val)) {
+    free_gbl();
+    restore_gbl();
+    __fortio_errend03();
+  }
   return ret_val;
 }
 
@@ -816,32 +1047,53 @@ __f90io_unf_write(int type,   /* data type of data (see above). */
       if (DBGBIT(0x4))
         __io_printf(("unit stride flush, rw_size=%" GBL_SIZE_T_FORMAT ", in_buf:%d\n"), rw_size,
                      rec_in_buf);
-      if (rec_in_buf) {
-        if (!Fcb->binary) {
-          if (WRITE_UNF_REC) {
+      if (unf_direct(Fcb, nbytes)) {
+        /* what is buffered of the record, then the data, in one go */
+        if (DBGBIT(0x4))
+          __io_printf("unit stride direct write, nbytes=%" GBL_SIZE_T_FORMAT "\n", nbytes);
+        if (rec_in_buf && !Fcb->binary) {
+          if (!unf_write_direct(Fcb, (char *)&unf_rec.u.s.bytecnt,
+                                rw_size + RCWSZ, item, nbytes)) {
             ret_val = __fortio_error(__io_errno());
             goto unf_write_err;
           }
+        } else if (!unf_write_direct(Fcb, unf_rec.buf, rw_size, item,
+                                     nbytes)) {
+          ret_val = __fortio_error(__io_errno());
+          goto unf_write_err;
+        }
+        if (rec_in_buf) {
+          rec_in_buf = FALSE;
+          unf_rec.u.s.bcnt = unf_rec.u.s.bytecnt;
+        }
+      } else {
+        if (rec_in_buf) {
+          if (!Fcb->binary) {
+            if (WRITE_UNF_REC) {
+              ret_val = __fortio_error(__io_errno());
+              goto unf_write_err;
+            }
+          } else {
+            if (WRITE_UNF_BUF) {
+              ret_val = __fortio_error(__io_errno());
+              goto unf_write_err;
+            }
+          }
+          rec_in_buf = FALSE;
+          unf_rec.u.s.bcnt = unf_rec.u.s.bytecnt;
         } else {
           if (WRITE_UNF_BUF) {
             ret_val = __fortio_error(__io_errno());
             goto unf_write_err;
           }
         }
-        rec_in_buf = FALSE;
-        unf_rec.u.s.bcnt = unf_rec.u.s.bytecnt;
-      } else {
-        if (WRITE_UNF_BUF) {
+        if (DBGBIT(0x4))
+          __io_printf("unit stride write, nbytes=%" GBL_SIZE_T_FORMAT "\n", nbytes);
+        if (unf_fwrite(item, nbytes, 1, Fcb) != TRUE) {
           ret_val = __fortio_error(__io_errno());
           goto unf_write_err;
         }
       }
-      if (DBGBIT(0x4))
-        __io_printf("unit stride write, nbytes=%" GBL_SIZE_T_FORMAT "\n", nbytes);
-      if (unf_fwrite(item, nbytes, 1, Fcb) != TRUE) {
-        ret_val = __fortio_error(__io_errno());
-        goto unf_write_err;
-      }
       rw_size = 0;
       buf_ptr = unf_rec.buf;
       if (resid > 0) {
@@ -944,9 +1196,11 @@ __f90io_unf_write(int type,   /* data type of data (see above). */
   return 0;
 
 unf_write_err:
-  free_gbl();
-  restore_gbl();
-  __fortio_errend03();
+  if (__fortio_leaves_stmt(ret_val)) {
+    free_gbl();
+    restore_gbl();
+    __fortio_errend03();
+  }
   return ret_val;
 }
 
@@ -1170,9 +1424,9 @@ __unf_end(bool to_be_continued)
        * items.
        */
       if (Fcb->acc != FIO_DIRECT)
-        ret_err = __io_fseek(Fcb->fp, (seekoffx_t)rec_len + RCWSZ, SEEK_CUR);
+        ret_err = adjust_fpos(Fcb, (seekoffx_t)rec_len + RCWSZ, SEEK_CUR);
       else
-        ret_err = __io_fseek(Fcb->fp, (seekoffx_t)rec_len, SEEK_CUR);
+        ret_err = adjust_fpos(Fcb, (seekoffx_t)rec_len, SEEK_CUR);
       if (ret_err)
         UNF_ERR(__io_errno());
       Fcb->coherent = 0;
@@ -1213,7 +1467,7 @@ __unf_end(bool to_be_continued)
     if (Fcb->acc != FIO_DIRECT) { /* write 0 length record */
       if (Fcb->binary)
         return 0;
-      ret_err = __fortio_zeropad(Fcb->fp, RCWSZ << 1);
+      ret_err = unf_zeropad(Fcb, RCWSZ << 1);
       if (ret_err != 0)
         UNF_ERR(ret_err);
       return 0;
@@ -1284,7 +1538,7 @@ __unf_end(bool to_be_continued)
       UNF_ERR(__io_errno());
   } else if (Fcb->reclen > unf_rec.u.s.bytecnt) {
     /*  pad record for direct-access file: */
-    ret_err = __fortio_zeropad(Fcb->fp, Fcb->reclen - unf_rec.u.s.bytecnt);
+    ret_err = unf_zeropad(Fcb, Fcb->reclen - unf_rec.u.s.bytecnt);
     if (ret_err != 0)
       UNF_ERR(ret_err);
   }
@@ -1310,7 +1564,7 @@ skip_to_nextrec(void)
     }
   } else if (unf_rec.u.s.bytecnt < rec_len) {
     Fcb->coherent = 0;
-    if (__io_fseek(Fcb->fp, (seekoffx_t)(rec_len - unf_rec.u.s.bytecnt),
+    if (adjust_fpos(Fcb, (seekoffx_t)(rec_len - unf_rec.u.s.bytecnt),
                     SEEK_CUR) != 0)
       return (__io_errno());
   }
@@ -1378,7 +1632,9 @@ __f90io_usw_init(__INT_T *read,   /* TRUE indicates READ statement. */
     __fortio_errinit(*unit, *bitv, iostat, "unformatted write");
 
   allocate_new_gbl();
+  fioFcbTbls.asy_write = async && !*read;
   Fcb = __fortio_rwinit(*unit, FIO_UNFORMATTED, rec, 1 - *read);
+  fioFcbTbls.asy_write = FALSE;
   if (Fcb == NULL) {
     if (fioFcbTbls.eof)
       return EOF_FLAG;
@@ -1406,7 +1662,7 @@ ENTF90IO(USW_INIT, usw_init)
   __fort_status_init(bitv, iostat);
   if (LOCAL_MODE || GET_DIST_LCPU == GET_DIST_IOPROC)
     s = __f90io_usw_init(read, unit, rec, bitv, iostat);
-  if (s != 0) {
+  if (s != 0 && __fortio_leaves_stmt(s)) {
     free_gbl();
     restore_gbl();
     __fortio_errend03();
@@ -1476,7 +1732,7 @@ usw_read_do_resid:
   /* read directly into item if possible  (consecutive items) */
 
   if (stride == item_length) {
-    if (__io_fread(item_ptr, nbytes, 1, Fcb->fp) != 1) {
+    if (unf_fread(item_ptr, nbytes, Fcb) != 1) {
       if (__io_feof(Fcb->fp))
         ret_val = __fortio_error(FIO_EEOF);
       else
@@ -1550,9 +1806,11 @@ usw_read_do_resid:
 
   return 0;
 uswr_err:
-  free_gbl();
-  restore_gbl();
-  __fortio_errend03();
+  if (__fortio_leaves_stmt(ret_val)) {
+    free_gbl();
+    restore_gbl();
+    __fortio_errend03();
+  }
   return ret_val;
 }
 
@@ -1725,6 +1983,34 @@ __f90io_usw_write(int type,   /* data type of data (see above). */
       nbytes -= resid;
     } else
       resid = 0;
+    if (resid == 0 && type != __STR && type != __NCHAR &&
+        unf_direct(Fcb, nbytes)) {
+      /* swap a chunk at a time on the way out, not byte by byte */
+      if (DBGBIT(0x4))
+        __io_printf("unit stride direct write, nbytes=%" GBL_SIZE_T_FORMAT "\n", nbytes);
+      unf_rec.u.s.bytecnt += nbytes;
+      if (rec_in_buf && !Fcb->binary) {
+        /* the length word goes just before the buffered data */
+        bs_tmp = unf_rec.u.s.bytecnt;
+        __fortio_swap_bytes((char *)&bs_tmp, __INT, 1);
+        if (FWRITE(&bs_tmp, RCWSZ, 1, Fcb->fp) != 1) {
+          ret_val = __fortio_error(__io_errno());
+          goto unf_write_err;
+        }
+      }
+      if (!usw_write_direct(Fcb, unf_rec.buf, rw_size, item, nbytes, type,
+                            item_length)) {
+        ret_val = __fortio_error(__io_errno());
+        goto unf_write_err;
+      }
+      if (rec_in_buf) {
+        rec_in_buf = FALSE;
+        unf_rec.u.s.bcnt = unf_rec.u.s.bytecnt;
+      }
+      rw_size = 0;
+      buf_ptr = unf_rec.buf;
+      return 0;
+    }
     if (rw_size + nbytes > IOBUFSIZE || resid > 0) {
       if (DBGBIT(0x4))
         __io_printf("unit stride flush, rw_size=%" GBL_SIZE_T_FORMAT ", in_buf:%d\n", rw_size,
@@ -1853,9 +2139,11 @@ nonunit_cp:
   return 0;
 
 unf_write_err:
-  free_gbl();
-  restore_gbl();
-  __fortio_errend03();
+  if (__fortio_leaves_stmt(ret_val)) {
+    free_gbl();
+    restore_gbl();
+    __fortio_errend03();
+  }
   return ret_val;
 }
 
@@ -2012,9 +2300,9 @@ __usw_end(bool to_be_continued)
        * items.
        */
       if (Fcb->acc != FIO_DIRECT)
-        ret_err = __io_fseek(Fcb->fp, (seekoffx_t)rec_len + RCWSZ, SEEK_CUR);
+        ret_err = adjust_fpos(Fcb, (seekoffx_t)rec_len + RCWSZ, SEEK_CUR);
       else
-        ret_err = __io_fseek(Fcb->fp, (seekoffx_t)rec_len, SEEK_CUR);
+        ret_err = adjust_fpos(Fcb, (seekoffx_t)rec_len, SEEK_CUR);
       if (ret_err)
         UNF_ERR(__io_errno());
       Fcb->coherent = 0;
@@ -2059,7 +2347,7 @@ __usw_end(bool to_be_continued)
     if (Fcb->acc != FIO_DIRECT) { /* write 0 length record */
       if (Fcb->binary)
         return 0;
-      ret_err = __fortio_zeropad(Fcb->fp, RCWSZ << 1);
+      ret_err = unf_zeropad(Fcb, RCWSZ << 1);
       if (ret_err != 0)
         UNF_ERR(ret_err);
       return 0;
@@ -2121,7 +2409,7 @@ __usw_end(bool to_be_continued)
       UNF_ERR(__io_errno());
   } else if (Fcb->reclen > unf_rec.u.s.bytecnt) {
     /*  pad record for direct-access file: */
-    ret_err = __fortio_zeropad(Fcb->fp, Fcb->reclen - unf_rec.u.s.bytecnt);
+    ret_err = unf_zeropad(Fcb, Fcb->reclen - unf_rec.u.s.bytecnt);
     if (ret_err != 0)
       UNF_ERR(ret_err);
   }
@@ -18,11 +18,13 @@
 #include "wintimes.h"
 #endif
 #include <errno.h>
+#include <stddef.h>
 #include "global.h"
 #include "open_close.h"
 #include "stdioInterf.h"
 #include "fioMacros.h"
 #include "async.h"
+#include "dirmap.h"
 
 /* --------------------------------------------------------------- */
 
@@ -88,11 +90,16 @@ __fortio_fiofcb_next(FIO_FCB *f)
 extern FIO_FCB *
 __fortio_alloc_fcb(void)
 {
-  FIO_FCB *p;
-
-  if (fcb_avail) { /* return item from avail list */
-    p = fcb_avail;
-    fcb_avail = p->next;
+  FIO_FCB *p, **q;
+
+  __fortio_lock_fcbs();
+  /* the statement connecting the unit keeps its FCB locked; pass over
+   * any that a thread which waited for their old unit has locked still */
+  for (q = &fcb_avail; *q && !__fortio_trylock_fcb(*q); q = &(*q)->next)
+    ;
+  if (*q) { /* return item from avail list */
+    p = *q;
+    *q = p->next;
   } else { /* call malloc for some new space */
     int i;
     p = (FIO_FCB *)malloc(CHUNKSZ * sizeof(FIO_FCB));
@@ -104,29 +111,38 @@ __fortio_alloc_fcb(void)
      */
     for (i = 2; i < CHUNKSZ - 1; i++) /* create avail list */
       p[i].next = &p[i + 1];
-    p[CHUNKSZ - 1].next = NULL; /* end of avail list */
+    p[CHUNKSZ - 1].next = fcb_avail; /* FCBs passed over above, if any */
     fcb_avail = &p[2];
+    for (i = 1; i < CHUNKSZ; i++) {
+      omp_init_nest_lock(&p[i].lock);
+      p[i].gen = 0;
+      p[i].owner = NULL;
+    }
 
     p[0].next = fcb_chunks;
     fcb_chunks = p;
 
     p++;
+    __fortio_trylock_fcb(p);
   }
 
-  memset(p, 0, sizeof(FIO_FCB));
-  p[0].next = fioFcbTbls.fcbs; /* add new FCB to front of list */
-  fioFcbTbls.fcbs = p;
+  memset(p, 0, offsetof(FIO_FCB, lock));
+  p[0].next = fioFcbs; /* add new FCB to front of list */
+  fioFcbs = p;
+  __fortio_unlock_fcbs();
   return p;
 }
 
 extern void
 __fortio_free_fcb(FIO_FCB *p)
 {
-  if (fioFcbTbls.fcbs == p) /* delete p from list */
-    fioFcbTbls.fcbs = p->next;
+  /* nobody else may connect the unit until this statement is done */
+  __fortio_hold_fcbs();
+  if (fioFcbs == p) /* delete p from list */
+    fioFcbs = p->next;
   else {
     FIO_FCB *q;
-    for (q = fioFcbTbls.fcbs; q; q = q->next) /* find predecessor of p */
+    for (q = fioFcbs; q; q = q->next) /* find predecessor of p */
       if (q->next == p)
         break;
     assert(q != NULL); /* trying to free unallocated block */
@@ -135,14 +151,19 @@ __fortio_free_fcb(FIO_FCB *p)
 
   p->next = fcb_avail; /* add to front of avail list */
   fcb_avail = p;
+  ++p->gen;
+  __fortio_unlock_fcb(p);
 }
 
 extern void
 __fortio_cleanup_fcb()
 {
   FIO_FCB *p, *p_next;
+  int i;
   for (p = fcb_chunks; p; p = p_next) {
     p_next = p->next;
+    for (i = 1; i < CHUNKSZ; i++)
+      omp_destroy_nest_lock(&p[i].lock);
     free(p);
   }
   fcb_avail = NULL;
@@ -177,6 +198,8 @@ extern FIO_FCB *__fortio_rwinit(
   }
 
   f = __fortio_find_unit(unit);
+  if (f == NULL && fioFcbTbls.error)
+    return NULL;
   if (f == NULL) { /* unit not connected */
     int status = FIO_UNKNOWN;
 
@@ -216,9 +239,14 @@ extern FIO_FCB *__fortio_rwinit(
     }
   } else { /* unit is already connected: */
 
-    /* check for outstanding async i/o */
+    /* check for outstanding async i/o.  Another asynchronous write that
+       just continues where the last one ended leaves it running; the
+       transfers stay queued behind each other. */
 
-    if (f->asy_rw) { /* stop any async i/o */
+    if (f->asy_rw &&
+        !(fioFcbTbls.asy_write && !f->truncflag &&
+          (f->acc == FIO_SEQUENTIAL ||
+           (f->acc == FIO_STREAM && !fioFcbTbls.pos_present)))) {
       f->asy_rw = 0;
       if (Fio_asy_disable(f->asyptr) == -1) {
         return (NULL);
@@ -269,6 +297,15 @@ extern FIO_FCB *__fortio_rwinit(
         rec = f->nextrec;
       else if (rec < 1)
         ERR(FIO_EDIRECT);
+      if (f->mapptr && form == FIO_UNFORMATTED && optype != 2 &&
+          !f->byte_swap && !f->asyptr && Fio_map_seek(f, rec, optype == 1)) {
+        /* the record is in the mapping; stdio is not involved */
+        f->nextrec = rec + 1;
+        if (rec > f->maxrec)
+          f->maxrec = rec;
+        f->skip = 0;
+        return f;
+      }
       if (optype == 0 && rec > f->maxrec) {
         seekoffx_t len;
         seekoffx_t sav_pos;
@@ -431,12 +468,41 @@ __fortio_find_unit(
     int unit)
 {
   FIO_FCB *p;
+  unsigned int gen;
+  int locked;
+
+  p = __fortio_held_unit(unit);
+  if (p != NULL)
+    return p;
 
-  for (p = fioFcbTbls.fcbs; p; p = p->next)
-    if (p->unit == unit)
+  for (;;) {
+    __fortio_lock_fcbs();
+    for (p = fioFcbs; p; p = p->next)
+      if (p->unit == unit)
+        break;
+    if (p == NULL) {
+      /* not connected; keep others from connecting it until we're done */
+      __fortio_hold_fcbs();
+      __fortio_unlock_fcbs();
+      return NULL; /* not found */
+    }
+    gen = p->gen;
+    __fortio_unlock_fcbs();
+
+    locked = __fortio_lock_fcb(p);
+    if (locked < 0) {
+      /* p's holder waits, maybe through others, for a unit that this
+         thread's statements hold: fail the statement, or abort if it has
+         no IOSTAT= or ERR=, rather than wait forever */
+      (void)__fortio_error(FIO_EDEADLOCK);
+      return NULL;
+    }
+    if (!locked || p->gen == gen)
       return p;
 
-  return NULL; /* not found */
+    /* the unit was closed while waiting for it */
+    __fortio_unlock_fcb(p);
+  }
 }
 
 /* ---------------------------------------------------------------- */
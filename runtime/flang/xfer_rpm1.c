@@ -28,13 +28,32 @@ struct ents *e;
   __fort_abort("__fort_esend: not implemented");
 }
 
-/* bcopy data items */
+/* byte range touched by nv vectors of e, vector k at e[k].adr */
+
+static void
+erange(e, nv, del, lo, hi) struct ent *e;
+long nv, del;
+char **lo, **hi;
+{
+  long a, b;
+
+  a = (e->cnt - 1) * e->str * e->ilen;
+  b = (nv - 1) * del;
+  *lo = e->adr + (a < 0 ? a : 0) + (b < 0 ? b : 0);
+  *hi = e->adr + (a > 0 ? a : 0) + (b > 0 ? b : 0) + e->ilen;
+}
+
+/* bcopy data items.  A run of items whose vectors have the same length and
+   strides, and start at evenly spaced addresses on both sides, is copied
+   by one __fort_bcopys2d when its source and destination do not overlap. */
 
 void __fort_ebcopys(ed, es) struct ents *ed;
 struct ents *es;
 {
   struct ent *p;
   struct ent *q;
+  char *dlo, *dhi, *slo, *shi;
+  long nv, rd, sd;
 
   p = es->beg;
   q = ed->beg;
@@ -49,11 +68,31 @@ struct ents *es;
     if (p->ilen != q->ilen)
       __fort_abort("ebcopys: inconsistent item length");
 #endif
-    __DIST_ENTRY_COPY(p->len);
-    __fort_bcopysl(q->adr, p->adr, q->cnt, q->str, p->str, q->ilen);
+    nv = 1;
+    if (q + 1 < ed->avl) {
+      rd = q[1].adr - q->adr;
+      sd = p[1].adr - p->adr;
+      while (q + nv < ed->avl && q[nv].cnt == q->cnt &&
+             q[nv].str == q->str && p[nv].str == p->str &&
+             q[nv].ilen == q->ilen && q[nv].adr - q[nv - 1].adr == rd &&
+             p[nv].adr - p[nv - 1].adr == sd)
+        ++nv;
+      if (nv > 1) {
+        erange(q, nv, rd, &dlo, &dhi);
+        erange(p, nv, sd, &slo, &shi);
+        if (dlo < shi && slo < dhi)
+          nv = 1;
+      }
+    }
+    __DIST_ENTRY_COPY(nv * p->len);
+    if (nv > 1)
+      __fort_bcopys2d(q->adr, p->adr, q->cnt, q->str, p->str, nv, rd, sd,
+                      q->ilen);
+    else
+      __fort_bcopysl(q->adr, p->adr, q->cnt, q->str, p->str, q->ilen);
     __DIST_ENTRY_COPY_DONE();
-    p++;
-    q++;
+    p += nv;
+    q += nv;
   }
 }
 
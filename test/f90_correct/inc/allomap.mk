@@ -0,0 +1,29 @@
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+
+########## Make rule for test allomap  ########
+
+
+allomap: run
+FFLAGS += -mp
+	
+
+build:  $(SRC)/allomap.f90
+	-$(RM) allomap.$(EXESUFFIX) core *.d *.mod FOR*.DAT FTN* ftn* fort.*
+	@echo ------------------------------------ building test $@
+	-$(CC) -c $(CFLAGS) $(SRC)/check.c -o check.$(OBJX)
+	-$(FC) -c $(FFLAGS) $(LDFLAGS) $(SRC)/allomap.f90 -o allomap.$(OBJX)
+	-$(FC) $(FFLAGS) $(LDFLAGS) allomap.$(OBJX) check.$(OBJX) $(LIBS) -o allomap.$(EXESUFFIX)
+
+
+run:
+	@echo ------------------------------------ executing test allomap
+	F90_ALLOC_LARGE=1m F90_ALLOC_NUMA=interleave allomap.$(EXESUFFIX)
+
+verify: ;
+
+allomap.run: run
+
@@ -0,0 +1,29 @@
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+
+########## Make rule for test allothr  ########
+
+
+allothr: run
+FFLAGS += -mp
+	
+
+build:  $(SRC)/allothr.f90
+	-$(RM) allothr.$(EXESUFFIX) core *.d *.mod FOR*.DAT FTN* ftn* fort.*
+	@echo ------------------------------------ building test $@
+	-$(CC) -c $(CFLAGS) $(SRC)/check.c -o check.$(OBJX)
+	-$(FC) -c $(FFLAGS) $(LDFLAGS) $(SRC)/allothr.f90 -o allothr.$(OBJX)
+	-$(FC) $(FFLAGS) $(LDFLAGS) allothr.$(OBJX) check.$(OBJX) $(LIBS) -o allothr.$(EXESUFFIX)
+
+
+run:
+	@echo ------------------------------------ executing test allothr
+	allothr.$(EXESUFFIX)
+
+verify: ;
+
+allothr.run: run
+
@@ -0,0 +1,28 @@
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+
+########## Make rule for test async_3  ########
+
+
+async_3: run
+	
+
+build:  $(SRC)/async_3.f90
+	-$(RM) async_3.$(EXESUFFIX) core *.d *.mod FOR*.DAT FTN* ftn* fort.*
+	@echo ------------------------------------ building test $@
+	-$(CC) -c $(CFLAGS) $(SRC)/check.c -o check.$(OBJX)
+	-$(FC) -c $(FFLAGS) $(LDFLAGS) $(SRC)/async_3.f90 -o async_3.$(OBJX)
+	-$(FC) $(FFLAGS) $(LDFLAGS) async_3.$(OBJX) check.$(OBJX) $(LIBS) -o async_3.$(EXESUFFIX)
+
+
+run:
+	@echo ------------------------------------ executing test async_3
+	async_3.$(EXESUFFIX)
+
+verify: ;
+
+async_3.run: run
+
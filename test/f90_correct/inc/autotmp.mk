@@ -0,0 +1,29 @@
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+
+########## Make rule for test autotmp  ########
+
+
+autotmp: run
+FFLAGS += -mp
+	
+
+build:  $(SRC)/autotmp.f90
+	-$(RM) autotmp.$(EXESUFFIX) core *.d *.mod FOR*.DAT FTN* ftn* fort.*
+	@echo ------------------------------------ building test $@
+	-$(CC) -c $(CFLAGS) $(SRC)/check.c -o check.$(OBJX)
+	-$(FC) -c $(FFLAGS) $(LDFLAGS) $(SRC)/autotmp.f90 -o autotmp.$(OBJX)
+	-$(FC) $(FFLAGS) $(LDFLAGS) autotmp.$(OBJX) check.$(OBJX) $(LIBS) -o autotmp.$(EXESUFFIX)
+
+
+run:
+	@echo ------------------------------------ executing test autotmp
+	autotmp.$(EXESUFFIX)
+
+verify: ;
+
+autotmp.run: run
+
@@ -0,0 +1,28 @@
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+
+########## Make rule for test copysect  ########
+
+
+copysect: run
+	
+
+build:  $(SRC)/copysect.f90
+	-$(RM) copysect.$(EXESUFFIX) core *.d *.mod FOR*.DAT FTN* ftn* fort.*
+	@echo ------------------------------------ building test $@
+	-$(CC) -c $(CFLAGS) $(SRC)/check.c -o check.$(OBJX)
+	-$(FC) -c $(FFLAGS) $(LDFLAGS) $(SRC)/copysect.f90 -o copysect.$(OBJX)
+	-$(FC) $(FFLAGS) $(LDFLAGS) copysect.$(OBJX) check.$(OBJX) $(LIBS) -o copysect.$(EXESUFFIX)
+
+
+run:
+	@echo ------------------------------------ executing test copysect
+	copysect.$(EXESUFFIX)
+
+verify: ;
+
+copysect.run: run
+
@@ -0,0 +1,28 @@
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+
+########## Make rule for test dirmap  ########
+
+
+dirmap: run
+	
+
+build:  $(SRC)/dirmap.f90
+	-$(RM) dirmap.$(EXESUFFIX) core *.d *.mod FOR*.DAT FTN* ftn* fort.*
+	@echo ------------------------------------ building test $@
+	-$(CC) -c $(CFLAGS) $(SRC)/check.c -o check.$(OBJX)
+	-$(FC) -c $(FFLAGS) $(LDFLAGS) $(SRC)/dirmap.f90 -o dirmap.$(OBJX)
+	-$(FC) $(FFLAGS) $(LDFLAGS) dirmap.$(OBJX) check.$(OBJX) $(LIBS) -o dirmap.$(EXESUFFIX)
+
+
+run:
+	@echo ------------------------------------ executing test dirmap
+	F90_DIRECT_MMAP=1 dirmap.$(EXESUFFIX)
+
+verify: ;
+
+dirmap.run: run
+
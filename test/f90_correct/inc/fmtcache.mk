@@ -0,0 +1,28 @@
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+
+########## Make rule for test fmtcache  ########
+
+
+fmtcache: run
+	
+
+build:  $(SRC)/fmtcache.f90
+	-$(RM) fmtcache.$(EXESUFFIX) core *.d *.mod FOR*.DAT FTN* ftn* fort.*
+	@echo ------------------------------------ building test $@
+	-$(CC) -c $(CFLAGS) $(SRC)/check.c -o check.$(OBJX)
+	-$(FC) -c $(FFLAGS) $(LDFLAGS) $(SRC)/fmtcache.f90 -o fmtcache.$(OBJX)
+	-$(FC) $(FFLAGS) $(LDFLAGS) fmtcache.$(OBJX) check.$(OBJX) $(LIBS) -o fmtcache.$(EXESUFFIX)
+
+
+run:
+	@echo ------------------------------------ executing test fmtcache
+	fmtcache.$(EXESUFFIX)
+
+verify: ;
+
+fmtcache.run: run
+
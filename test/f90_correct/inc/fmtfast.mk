@@ -0,0 +1,28 @@
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+
+########## Make rule for test fmtfast  ########
+
+
+fmtfast: run
+	
+
+build:  $(SRC)/fmtfast.f90
+	-$(RM) fmtfast.$(EXESUFFIX) core *.d *.mod FOR*.DAT FTN* ftn* fort.*
+	@echo ------------------------------------ building test $@
+	-$(CC) -c $(CFLAGS) $(SRC)/check.c -o check.$(OBJX)
+	-$(FC) -c $(FFLAGS) $(LDFLAGS) $(SRC)/fmtfast.f90 -o fmtfast.$(OBJX)
+	-$(FC) $(FFLAGS) $(LDFLAGS) fmtfast.$(OBJX) check.$(OBJX) $(LIBS) -o fmtfast.$(EXESUFFIX)
+
+
+run:
+	@echo ------------------------------------ executing test fmtfast
+	fmtfast.$(EXESUFFIX)
+
+verify: ;
+
+fmtfast.run: run
+
@@ -0,0 +1,29 @@
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+
+########## Make rule for test iothr  ########
+
+
+iothr: run
+FFLAGS += -mp
+	
+
+build:  $(SRC)/iothr.f90
+	-$(RM) iothr.$(EXESUFFIX) core *.d *.mod FOR*.DAT FTN* ftn* fort.*
+	@echo ------------------------------------ building test $@
+	-$(CC) -c $(CFLAGS) $(SRC)/check.c -o check.$(OBJX)
+	-$(FC) -c $(FFLAGS) $(LDFLAGS) $(SRC)/iothr.f90 -o iothr.$(OBJX)
+	-$(FC) $(FFLAGS) $(LDFLAGS) iothr.$(OBJX) check.$(OBJX) $(LIBS) -o iothr.$(EXESUFFIX)
+
+
+run:
+	@echo ------------------------------------ executing test iothr
+	iothr.$(EXESUFFIX)
+
+verify: ;
+
+iothr.run: run
+
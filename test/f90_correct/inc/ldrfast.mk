@@ -0,0 +1,28 @@
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+
+########## Make rule for test ldrfast  ########
+
+
+ldrfast: run
+	
+
+build:  $(SRC)/ldrfast.f90
+	-$(RM) ldrfast.$(EXESUFFIX) core *.d *.mod FOR*.DAT FTN* ftn* fort.*
+	@echo ------------------------------------ building test $@
+	-$(CC) -c $(CFLAGS) $(SRC)/check.c -o check.$(OBJX)
+	-$(FC) -c $(FFLAGS) $(LDFLAGS) $(SRC)/ldrfast.f90 -o ldrfast.$(OBJX)
+	-$(FC) $(FFLAGS) $(LDFLAGS) ldrfast.$(OBJX) check.$(OBJX) $(LIBS) -o ldrfast.$(EXESUFFIX)
+
+
+run:
+	@echo ------------------------------------ executing test ldrfast
+	ldrfast.$(EXESUFFIX)
+
+verify: ;
+
+ldrfast.run: run
+
@@ -0,0 +1,28 @@
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+
+########## Make rule for test mmulblk  ########
+
+
+mmulblk: run
+	
+
+build:  $(SRC)/mmulblk.f90
+	-$(RM) mmulblk.$(EXESUFFIX) core *.d *.mod FOR*.DAT FTN* ftn* fort.*
+	@echo ------------------------------------ building test $@
+	-$(CC) -c $(CFLAGS) $(SRC)/check.c -o check.$(OBJX)
+	-$(FC) -c $(FFLAGS) $(LDFLAGS) $(SRC)/mmulblk.f90 -o mmulblk.$(OBJX)
+	-$(FC) $(FFLAGS) $(LDFLAGS) mmulblk.$(OBJX) check.$(OBJX) $(LIBS) -o mmulblk.$(EXESUFFIX)
+
+
+run:
+	@echo ------------------------------------ executing test mmulblk
+	mmulblk.$(EXESUFFIX)
+
+verify: ;
+
+mmulblk.run: run
+
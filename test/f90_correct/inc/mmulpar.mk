@@ -0,0 +1,29 @@
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+
+########## Make rule for test mmulpar  ########
+
+
+mmulpar: run
+FFLAGS += -mp
+	
+
+build:  $(SRC)/mmulpar.f90
+	-$(RM) mmulpar.$(EXESUFFIX) core *.d *.mod FOR*.DAT FTN* ftn* fort.*
+	@echo ------------------------------------ building test $@
+	-$(CC) -c $(CFLAGS) $(SRC)/check.c -o check.$(OBJX)
+	-$(FC) -c $(FFLAGS) $(LDFLAGS) $(SRC)/mmulpar.f90 -o mmulpar.$(OBJX)
+	-$(FC) $(FFLAGS) $(LDFLAGS) mmulpar.$(OBJX) check.$(OBJX) $(LIBS) -o mmulpar.$(EXESUFFIX)
+
+
+run:
+	@echo ------------------------------------ executing test mmulpar
+	F90_MATMUL_THREADS=4 mmulpar.$(EXESUFFIX)
+
+verify: ;
+
+mmulpar.run: run
+
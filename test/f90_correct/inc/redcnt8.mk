@@ -0,0 +1,28 @@
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+
+########## Make rule for test redcnt8  ########
+
+
+redcnt8: run
+	
+
+build:  $(SRC)/redcnt8.f90
+	-$(RM) redcnt8.$(EXESUFFIX) core *.d *.mod FOR*.DAT FTN* ftn* fort.*
+	@echo ------------------------------------ building test $@
+	-$(CC) -c $(CFLAGS) $(SRC)/check.c -o check.$(OBJX)
+	-$(FC) -c -i8 -Mx,47,0x80 $(FFLAGS) $(LDFLAGS) $(SRC)/redcnt8.f90 -o redcnt8.$(OBJX)
+	-$(FC) $(FFLAGS) $(LDFLAGS) redcnt8.$(OBJX) check.$(OBJX) $(LIBS) -o redcnt8.$(EXESUFFIX)
+
+
+run:
+	@echo ------------------------------------ executing test redcnt8
+	F90_MATMUL_THREADS=4 redcnt8.$(EXESUFFIX)
+
+verify: ;
+
+redcnt8.run: run
+
@@ -0,0 +1,28 @@
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+
+########## Make rule for test redsimd  ########
+
+
+redsimd: run
+	
+
+build:  $(SRC)/redsimd.f90
+	-$(RM) redsimd.$(EXESUFFIX) core *.d *.mod FOR*.DAT FTN* ftn* fort.*
+	@echo ------------------------------------ building test $@
+	-$(CC) -c $(CFLAGS) $(SRC)/check.c -o check.$(OBJX)
+	-$(FC) -c $(FFLAGS) $(LDFLAGS) $(SRC)/redsimd.f90 -o redsimd.$(OBJX)
+	-$(FC) $(FFLAGS) $(LDFLAGS) redsimd.$(OBJX) check.$(OBJX) $(LIBS) -o redsimd.$(EXESUFFIX)
+
+
+run:
+	@echo ------------------------------------ executing test redsimd
+	redsimd.$(EXESUFFIX)
+
+verify: ;
+
+redsimd.run: run
+
@@ -0,0 +1,29 @@
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+
+########## Make rule for test rnumthr  ########
+
+
+rnumthr: run
+FFLAGS += -mp
+	
+
+build:  $(SRC)/rnumthr.f90
+	-$(RM) rnumthr.$(EXESUFFIX) core *.d *.mod FOR*.DAT FTN* ftn* fort.*
+	@echo ------------------------------------ building test $@
+	-$(CC) -c $(CFLAGS) $(SRC)/check.c -o check.$(OBJX)
+	-$(FC) -c $(FFLAGS) $(LDFLAGS) $(SRC)/rnumthr.f90 -o rnumthr.$(OBJX)
+	-$(FC) $(FFLAGS) $(LDFLAGS) rnumthr.$(OBJX) check.$(OBJX) $(LIBS) -o rnumthr.$(EXESUFFIX)
+
+
+run:
+	@echo ------------------------------------ executing test rnumthr
+	F90_RANDOM_THREADS=yes rnumthr.$(EXESUFFIX)
+
+verify: ;
+
+rnumthr.run: run
+
@@ -0,0 +1,28 @@
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+
+########## Make rule for test unfdirect  ########
+
+
+unfdirect: run
+	
+
+build:  $(SRC)/unfdirect.f90
+	-$(RM) unfdirect.$(EXESUFFIX) core *.d *.mod FOR*.DAT FTN* ftn* fort.*
+	@echo ------------------------------------ building test $@
+	-$(CC) -c $(CFLAGS) $(SRC)/check.c -o check.$(OBJX)
+	-$(FC) -c $(FFLAGS) $(LDFLAGS) $(SRC)/unfdirect.f90 -o unfdirect.$(OBJX)
+	-$(FC) $(FFLAGS) $(LDFLAGS) unfdirect.$(OBJX) check.$(OBJX) $(LIBS) -o unfdirect.$(EXESUFFIX)
+
+
+run:
+	@echo ------------------------------------ executing test unfdirect
+	unfdirect.$(EXESUFFIX)
+
+verify: ;
+
+unfdirect.run: run
+
@@ -0,0 +1,115 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+! Test large ALLOCATE blocks and automatic arrays with F90_ALLOC_LARGE
+! set, so that the runtime maps them with its huge page and NUMA policy:
+! the arrays hold their values, can be freed, allocated again and moved,
+! and blocks below the threshold still work alongside them.
+!
+! Run with a size in MB as its argument, e.g. "allomap 4096", this also
+! serves as a benchmark: 8 threads fill an array of that size and sweep it
+! ten times, and it reports the bandwidth.  F90_ALLOC_STATS=1 reports the
+! policy applied to each large block.
+
+module allomap_mod
+contains
+  ! sum of a large automatic array
+  real*8 function autosum(n)
+    integer :: n
+    real*8 :: w(n)
+    integer :: k
+    !$omp parallel do num_threads(4)
+    do k = 1, n
+      w(k) = k
+    end do
+    autosum = sum(w)
+  end function
+end module
+
+program allomap
+  use allomap_mod
+  integer, parameter :: n = 5, m = 1000000
+  real*8, allocatable :: a(:), b(:, :), s(:)
+  integer*8, allocatable :: big(:)
+  integer :: res(n), expect(n)
+  integer :: i, k, good
+  integer*8 :: mb, j, t0, t1, rate
+  real*8 :: t
+  character(len=32) :: arg
+
+  res = 0
+  expect = 1
+
+  ! large and small blocks side by side, filled from several threads
+  allocate(a(m), s(100), b(1000, 1000))
+  !$omp parallel do num_threads(4)
+  do i = 1, m
+    a(i) = i
+  end do
+  s = 1
+  b = 2
+  if (all(a == (/ (dble(i), i = 1, m) /)) .and. all(s == 1) .and. &
+      all(b == 2)) res(1) = 1
+
+  ! freed and allocated again, over and over
+  good = 1
+  do k = 1, 20
+    deallocate(a)
+    allocate(a(m + k * 100000))
+    a(1) = k
+    a(size(a)) = -k
+    if (a(1) /= k .or. a(size(a)) /= -k) good = 0
+  end do
+  res(2) = good
+  deallocate(a, b, s)
+
+  ! a block moved to another array keeps its values
+  allocate(a(m))
+  a = 3
+  call move_alloc(a, s)
+  if (.not. allocated(a) .and. size(s) == m .and. all(s == 3)) res(3) = 1
+  deallocate(s)
+
+  ! large automatic arrays
+  good = 1
+  do k = 1, 5
+    i = m * k / 2
+    if (autosum(i) /= dble(i) * (i + 1) / 2) good = 0
+  end do
+  res(4) = good
+
+  ! a large array with an odd size, touched at both ends
+  allocate(big(3 * m + 7))
+  big = 0
+  big(1) = 1
+  big(3 * m + 7) = 1
+  if (sum(big) == 2) res(5) = 1
+  deallocate(big)
+
+  call check(res, expect, n)
+
+  if (command_argument_count() > 0) then
+    call get_command_argument(1, arg)
+    read(arg, *) mb
+    allocate(big(mb * 131072))
+    call system_clock(t0, rate)
+    !$omp parallel do num_threads(8)
+    do j = 1, size(big, kind=8)
+      big(j) = j
+    end do
+    do k = 1, 10
+      !$omp parallel do num_threads(8)
+      do j = 1, size(big, kind=8)
+        big(j) = big(j) + 1
+      end do
+    end do
+    call system_clock(t1)
+    t = dble(t1 - t0) / dble(rate)
+    if (t > 0 .and. big(1) == 11) then
+      print '(i0,a,f10.3,a)', mb, ' MB on 8 threads, ', &
+        21 * mb / 1024d0 / t, ' GB/s'
+    end if
+  end if
+end program
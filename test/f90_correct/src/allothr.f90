@@ -0,0 +1,127 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+! Test ALLOCATE/DEALLOCATE of temporaries from many OpenMP threads, with
+! blocks allocated on one thread and deallocated on another, which the
+! runtime's per-thread block cache has to handle.
+!
+! Run with a count as its argument, e.g. "allothr 1000000", this also
+! serves as a benchmark: 64 threads allocate and free that many
+! temporaries between them and it reports the rate.  F90_ALLOC_STATS=1
+! prints the runtime's allocation counters at exit.
+
+module allothr_mod
+  type blk
+    real*8, allocatable :: v(:)
+  end type
+contains
+  ! allocate a temporary, fill it, and return its checksum
+  integer function use_temp(i, n)
+    integer :: i, n
+    real*8, allocatable :: t(:)
+    integer :: k
+    allocate(t(n))
+    do k = 1, n
+      t(k) = i + k
+    end do
+    use_temp = 0
+    if (t(1) == i + 1 .and. t(n) == i + n) use_temp = 1
+    deallocate(t)
+  end function
+
+  ! the same, touching only the ends, to time ALLOCATE itself
+  integer function touch_temp(i, n)
+    integer :: i, n
+    real*8, allocatable :: t(:)
+    allocate(t(n))
+    t(1) = i
+    t(n) = i
+    touch_temp = 0
+    if (t(1) == t(n)) touch_temp = 1
+    deallocate(t)
+  end function
+end module
+
+program allothr
+  use allothr_mod
+  integer, parameter :: nb = 512, n = 5
+  type(blk) :: b(nb)
+  integer :: res(n), expect(n)
+  integer :: i, k, sz, good, bad
+  integer*8 :: cnt, j, t0, t1, rate
+  character(len=32) :: arg
+
+  res = 0
+  expect = (/ 4000, nb, nb, 1, 1 /)
+
+  ! temporaries of sizes from a few bytes to a few MB on every thread
+  good = 0
+  !$omp parallel do num_threads(8) reduction(+:good) schedule(dynamic,7)
+  do i = 1, 4000
+    good = good + use_temp(i, 1 + mod(i * 37, 5) * 10 ** mod(i, 6))
+  end do
+  res(1) = good
+
+  ! allocate on one set of threads ...
+  !$omp parallel do num_threads(8) private(sz, k) schedule(static,1)
+  do i = 1, nb
+    sz = 100 + mod(i * 131, 70000)
+    allocate(b(i)%v(sz))
+    do k = 1, sz
+      b(i)%v(k) = i
+    end do
+  end do
+
+  ! ... check and free on others
+  good = 0
+  !$omp parallel do num_threads(8) reduction(+:good) schedule(static,3)
+  do i = nb, 1, -1
+    if (all(b(i)%v == i)) good = good + 1
+    deallocate(b(i)%v)
+  end do
+  res(2) = good
+
+  ! and again, so that the blocks now come out of the caches
+  good = 0
+  !$omp parallel do num_threads(8) private(sz) reduction(+:good)
+  do i = 1, nb
+    sz = 100 + mod(i * 131, 70000)
+    allocate(b(i)%v(sz))
+    b(i)%v = -i
+    if (b(i)%v(sz) == -i) good = good + 1
+  end do
+  res(3) = good
+  bad = 0
+  do i = 1, nb
+    if (any(b(i)%v /= -i)) bad = bad + 1
+    deallocate(b(i)%v)
+  end do
+  if (bad == 0) res(4) = 1
+
+  ! many threads at once, a few of them with large blocks
+  cnt = 20000
+  if (command_argument_count() > 0) then
+    call get_command_argument(1, arg)
+    read(arg, *) cnt
+  end if
+  good = 0
+  call system_clock(t0, rate)
+  !$omp parallel do num_threads(64) private(sz) reduction(+:good) &
+  !$omp schedule(static)
+  do j = 1, cnt
+    sz = 16 + int(mod(j * 7, 5000_8))
+    if (mod(j, 16_8) == 0) sz = sz + 200000
+    good = good + touch_temp(int(mod(j, 1000_8)), sz)
+  end do
+  call system_clock(t1)
+  if (good == cnt) res(5) = 1
+
+  call check(res, expect, n)
+
+  if (command_argument_count() > 0 .and. t1 > t0) then
+    print '(i0,a,f10.3,a)', cnt, ' temporaries on 64 threads, ', &
+      dble(cnt) / (dble(t1 - t0) / dble(rate)) / 1d6, ' M/s'
+  end if
+end program
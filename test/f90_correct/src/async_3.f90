@@ -0,0 +1,148 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+! Test many asynchronous unformatted writes queued behind each other
+! before a single WAIT, with work done while they are pending, and
+! asynchronous reads of the data back.  Records of various sizes, empty
+! records, direct and stream access are covered.
+
+program async_3
+  implicit none
+  integer, parameter :: nrec = 40, big = 20000, n = 10
+  integer :: res(n), expect(n)
+  real(8), asynchronous :: a(big, nrec)
+  real(8), asynchronous :: b(big, nrec)
+  integer, asynchronous :: s(3, nrec), t(3, nrec)
+  integer :: sizes(nrec), i, j, k, ios
+  real(8) :: work
+  character(len=8), asynchronous :: c(4), d(4)
+
+  res = 0
+  expect = 1
+
+  do i = 1, nrec
+    sizes(i) = mod(i * 7919, big) + 1
+    if (mod(i, 5) == 0) sizes(i) = mod(i, 7) + 1
+    do j = 1, big
+      a(j, i) = i * 100000.0d0 + j
+    end do
+    s(:, i) = (/ i, -i, sizes(i) /)
+  end do
+
+  ! sequential: queue all the writes, compute, then wait once
+  open(10, file='async_3.dat', form='unformatted', access='sequential', &
+       asynchronous='yes', status='replace')
+  do i = 1, nrec
+    write(10, asynchronous='yes') s(:, i), a(1:sizes(i), i)
+    if (mod(i, 10) == 0) write(10, asynchronous='yes')
+  end do
+  work = 0.0d0
+  do k = 1, 1000
+    work = work + sqrt(dble(k))
+  end do
+  wait(10, iostat=ios)
+  if (ios == 0 .and. work > 0.0d0) res(1) = 1
+
+  ! read back synchronously
+  rewind(10)
+  b = 0.0d0
+  k = 0
+  do i = 1, nrec
+    read(10) t(:, i), b(1:sizes(i), i)
+    if (all(t(:, i) == s(:, i)) .and. &
+        all(b(1:sizes(i), i) == a(1:sizes(i), i))) k = k + 1
+    if (mod(i, 10) == 0) read(10)
+  end do
+  if (k == nrec) res(2) = 1
+  read(10, iostat=ios)
+  if (ios < 0) res(3) = 1
+
+  ! and asynchronously
+  rewind(10)
+  b = 0.0d0
+  t = 0
+  do i = 1, nrec
+    read(10, asynchronous='yes') t(:, i), b(1:sizes(i), i)
+    if (mod(i, 10) == 0) read(10, asynchronous='yes')
+  end do
+  wait(10)
+  k = 0
+  do i = 1, nrec
+    if (all(t(:, i) == s(:, i)) .and. &
+        all(b(1:sizes(i), i) == a(1:sizes(i), i))) k = k + 1
+  end do
+  if (k == nrec) res(4) = 1
+
+  ! reopen to append, then close with the writes still pending
+  close(10)
+  open(10, file='async_3.dat', form='unformatted', access='sequential', &
+       asynchronous='yes', position='append')
+  write(10, asynchronous='yes') a(:, 1)
+  write(10, asynchronous='yes') s(:, 2)
+  close(10)
+  open(10, file='async_3.dat', form='unformatted', access='sequential')
+  do i = 1, nrec + 4
+    read(10)
+  end do
+  b(:, 1) = 0.0d0
+  read(10) b(:, 1)
+  read(10) t(:, 2)
+  if (all(b(:, 1) == a(:, 1)) .and. all(t(:, 2) == s(:, 2))) res(5) = 1
+  close(10, status='delete')
+
+  ! direct access, records written out of order
+  open(11, file='async_3.dir', form='unformatted', access='direct', &
+       recl=8 * big, asynchronous='yes', status='replace')
+  do i = 1, 8
+    write(11, rec=9 - i, asynchronous='yes') a(:, 9 - i)
+  end do
+  write(11, rec=9, asynchronous='yes') a(1:10, 9)
+  wait(11)
+  b = 0.0d0
+  k = 0
+  do i = 1, 8
+    read(11, rec=i, asynchronous='yes') b(:, i)
+    wait(11)
+    if (all(b(:, i) == a(:, i))) k = k + 1
+  end do
+  b(:, 9) = -1.0d0
+  read(11, rec=9) b(:, 9)
+  if (all(b(1:10, 9) == a(1:10, 9)) .and. all(b(11:, 9) == 0.0d0)) k = k + 1
+  if (k == 9) res(6) = 1
+  close(11, status='delete')
+
+  ! stream access
+  c = (/ 'alpha   ', 'beta    ', 'gamma   ', 'delta   ' /)
+  open(12, file='async_3.str', form='unformatted', access='stream', &
+       asynchronous='yes', status='replace')
+  do i = 1, 4
+    write(12, asynchronous='yes') c(i)
+  end do
+  write(12, asynchronous='yes') s(:, 1)
+  wait(12)
+  d = ' '
+  read(12, pos=1, asynchronous='yes') d
+  wait(12)
+  if (all(c == d)) res(7) = 1
+  t(:, 1) = 0
+  read(12, pos=33) t(:, 1)
+  if (all(t(:, 1) == s(:, 1))) res(8) = 1
+  inquire(12, size=k)
+  if (k == 32 + 12) res(9) = 1
+  close(12, status='delete')
+
+  ! a large record written in pieces larger than the runtime's buffer
+  open(13, file='async_3.big', form='unformatted', asynchronous='yes', &
+       status='replace')
+  write(13, asynchronous='yes') (a(:, i), i = 1, nrec)
+  rewind(13)
+  b = 0.0d0
+  read(13, asynchronous='yes') b
+  wait(13)
+  if (all(a == b)) res(10) = 1
+  close(13, status='delete')
+
+  call check(res, expect, n)
+end program async_3
@@ -0,0 +1,107 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+! Test automatic arrays and array expression temporaries made over and
+! over by a time-step loop, serially and from OpenMP threads, which the
+! runtime serves from its per-thread block cache.
+!
+! Run with a count as its argument, e.g. "autotmp 100000", this also
+! serves as a benchmark: that many time steps are taken on arrays of
+! 160KB, past the point where malloc hands out fresh pages, and it
+! reports the time per step.  F90_ALLOC_STATS=1 prints the runtime's
+! allocation counters, including the cache hit rate, at exit.
+
+module autotmp_mod
+contains
+  ! one time step: an automatic work array and two overlapping
+  ! assignments that need temporaries
+  subroutine step(a, n)
+    integer :: n
+    real*8 :: a(n)
+    real*8 :: w(n)
+    w = a + 1
+    a(2:n) = 0.5d0 * (w(1:n - 1) - a(1:n - 1) + a(2:n))
+    a(1:n - 1) = a(n:2:-1)
+  end subroutine
+
+  ! fill an automatic array and return its sum
+  real*8 function zsum(n)
+    integer :: n
+    real*8 :: z(n)
+    z = n
+    zsum = sum(z)
+  end function
+
+  ! the same steps on a private copy, compared with the serial answer
+  integer function same(a0, ref, n, nsteps)
+    integer :: n, nsteps
+    real*8 :: a0(n), ref(n)
+    real*8 :: a(n)
+    integer :: k
+    a = a0
+    do k = 1, nsteps
+      call step(a, n)
+    end do
+    same = 0
+    if (all(a == ref)) same = 1
+  end function
+end module
+
+program autotmp
+  use autotmp_mod
+  integer, parameter :: n = 3, m = 5000, nsteps = 50
+  real*8 :: a0(m), a(m), b(m), c(4 * m)
+  integer :: res(n), expect(n)
+  integer :: i, k, good
+  integer*8 :: cnt, j, t0, t1, rate
+  character(len=32) :: arg
+
+  res = 0
+  expect = (/ 1, 200, 64 /)
+
+  ! the steps give the same answer as doing them by hand
+  a0 = (/ (mod(i * 7, 13), i = 1, m) /)
+  a = a0
+  b = a0
+  do k = 1, nsteps
+    call step(a, m)
+    b(2:m) = 0.5d0 * (b(1:m - 1) + 1 - b(1:m - 1) + b(2:m))
+    b(1:m - 1) = b(m:2:-1)
+  end do
+  if (all(a == b)) res(1) = 1
+
+  ! automatic arrays of changing sizes
+  good = 0
+  do i = 1, 200
+    k = 100 + mod(i * 37, 7) * 1000
+    if (zsum(k) == dble(k) * k) good = good + 1
+  end do
+  res(2) = good
+
+  ! and the same from many threads at once
+  good = 0
+  !$omp parallel do num_threads(8) reduction(+:good) schedule(dynamic)
+  do i = 1, 64
+    good = good + same(a0, a, m, nsteps)
+  end do
+  res(3) = good
+
+  call check(res, expect, n)
+
+  if (command_argument_count() > 0) then
+    call get_command_argument(1, arg)
+    read(arg, *) cnt
+    c = 0
+    call system_clock(t0, rate)
+    do j = 1, cnt
+      call step(c, 4 * m)
+    end do
+    call system_clock(t1)
+    if (t1 > t0 .and. c(1) == c(1)) then
+      print '(i0,a,f10.3,a)', cnt, ' time steps, ', &
+        dble(t1 - t0) / dble(rate) / dble(cnt) * 1d6, ' us per step'
+    end if
+  end if
+end program
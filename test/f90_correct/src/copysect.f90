@@ -0,0 +1,137 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+! Test the runtime's section copies where they are used for RESHAPE with
+! ORDER: transposed copies, which go in tiles, items of several sizes,
+! strided sources, PAD, and more pieces than the runtime copies at one
+! time.
+!
+! Run with a size as its argument, e.g. "copysect 2000", this also serves
+! as a benchmark: it times a RESHAPE with ORDER=(/2,1/) of a square
+! REAL*8 array of that size against the same transpose as a DO loop.
+
+program copysect
+  integer, parameter :: n = 8
+  integer :: res(n), expect(n)
+  real*8, allocatable :: a(:,:), b(:,:), c(:,:), d(:,:)
+  integer*2 :: h(37, 45), hr(45, 37)
+  character(len=3) :: ch(30, 20), chr(20, 30)
+  complex*16 :: z(3, 4, 5), zr(5, 3, 4)
+  integer :: p(2, 3000), pr(3000, 2), q(7), qr(5, 3)
+  real*4 :: y(6, 70, 80), yr(80, 70, 6)
+  integer :: i, j, k, m, good
+  integer*8 :: t0, t1, t2, rate
+  character(len=32) :: arg
+
+  res = 0
+  expect = 1
+
+  ! REAL*8 transpose of a non-square array
+  allocate(a(300, 170), b(170, 300), c(170, 300))
+  do j = 1, 170
+    do i = 1, 300
+      a(i, j) = i + 1000 * j
+    end do
+  end do
+  b = reshape(a, (/ 170, 300 /), order=(/ 2, 1 /))
+  do j = 1, 300
+    do i = 1, 170
+      c(i, j) = a(j, i)
+    end do
+  end do
+  if (all(b == c)) res(1) = 1
+
+  ! two-byte and three-byte items
+  do j = 1, 45
+    do i = 1, 37
+      h(i, j) = i + 37 * (j - 1)
+    end do
+  end do
+  hr = reshape(h, (/ 45, 37 /), order=(/ 2, 1 /))
+  if (all(hr == transpose(h))) res(2) = 1
+  do j = 1, 20
+    do i = 1, 30
+      write(ch(i, j), '(i3.3)') i + 30 * (j - 1)
+    end do
+  end do
+  chr = reshape(ch, (/ 20, 30 /), order=(/ 2, 1 /))
+  if (all(chr == transpose(ch))) res(3) = 1
+
+  ! rank 3, sixteen-byte items
+  z = reshape((/ (cmplx(i, -i, 8), i = 1, 60) /), (/ 3, 4, 5 /))
+  zr = reshape(z, (/ 5, 3, 4 /), order=(/ 2, 3, 1 /))
+  good = 1
+  do k = 1, 5
+    do j = 1, 4
+      do i = 1, 3
+        if (zr(k, i, j) /= z(i, j, k)) good = 0
+      end do
+    end do
+  end do
+  res(4) = good
+
+  ! thousands of two-item pieces
+  p = reshape((/ (i, i = 1, 6000) /), (/ 2, 3000 /))
+  pr = reshape(p, (/ 3000, 2 /), order=(/ 2, 1 /))
+  if (all(pr(:, 1) == (/ (2 * i - 1, i = 1, 3000) /)) .and. &
+      all(pr(:, 2) == (/ (2 * i, i = 1, 3000) /))) res(5) = 1
+
+  ! PAD
+  q = (/ (i, i = 1, 7) /)
+  qr = reshape(q, (/ 5, 3 /), pad=(/ -1, -2 /), order=(/ 2, 1 /))
+  if (all(qr(1, :) == (/ 1, 2, 3 /)) .and. all(qr(3, :) == (/ 7, -1, -2 /)) &
+      .and. all(qr(5, :) == (/ -2, -1, -2 /))) res(6) = 1
+
+  ! a strided section as the source
+  allocate(d(169, 150))
+  d = reshape(a(1:300:2, 2:170), (/ 169, 150 /), order=(/ 2, 1 /))
+  good = 1
+  do j = 1, 150
+    do i = 1, 169
+      if (d(i, j) /= a(2 * j - 1, i + 1)) good = 0
+    end do
+  end do
+  res(7) = good
+
+  ! rank 3 reversed, four-byte items
+  y = reshape((/ (real(i), i = 1, 6 * 70 * 80) /), (/ 6, 70, 80 /))
+  yr = reshape(y, (/ 80, 70, 6 /), order=(/ 3, 2, 1 /))
+  good = 1
+  do k = 1, 80
+    do j = 1, 70
+      do i = 1, 6
+        if (yr(k, j, i) /= y(i, j, k)) good = 0
+      end do
+    end do
+  end do
+  res(8) = good
+
+  call check(res, expect, n)
+
+  if (command_argument_count() > 0) then
+    call get_command_argument(1, arg)
+    read(arg, *) m
+    deallocate(a, b, c, d)
+    allocate(a(m, m), b(m, m))
+    call random_number(a)
+    b = 0
+    call system_clock(t0, rate)
+    do k = 1, 10
+      b = reshape(a, (/ m, m /), order=(/ 2, 1 /))
+    end do
+    call system_clock(t1)
+    do k = 1, 10
+      do j = 1, m
+        do i = 1, m
+          b(i, j) = a(j, i)
+        end do
+      end do
+    end do
+    call system_clock(t2)
+    print '(a,f10.3,a,f10.3,a)', 'transpose by RESHAPE ', &
+      dble(t1 - t0) / dble(rate) * 1d2, ' ms, by DO loop ', &
+      dble(t2 - t1) / dble(rate) * 1d2, ' ms'
+  end if
+end program
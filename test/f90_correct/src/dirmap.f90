@@ -0,0 +1,90 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+! Test direct access unformatted files with F90_DIRECT_MMAP set, so that
+! records inside the file are read and written through a mapping: random
+! reads, updates in place, records appended and read back, partial and
+! strided records, FLUSH, and errors for missing records
+
+program dirmap
+  implicit none
+  integer, parameter :: nrec = 500, n = 8, ntests = 8
+  integer :: res(ntests), expect(ntests)
+  integer :: a(n), b(n), c(2 * n), i, k, r, ios
+  integer(1) :: bytes(4)
+  logical :: ok
+
+  res = 0
+  expect = 1
+
+  open(10, file='dirmap.dat', form='unformatted', access='direct', &
+       recl=4 * n, status='replace')
+  do i = 1, nrec
+    a = (/ (i * 100 + k, k = 1, n) /)
+    write(10, rec=i) a
+  end do
+  close(10)
+
+  open(10, file='dirmap.dat', form='unformatted', access='direct', &
+       recl=4 * n, status='old')
+
+  ! random reads
+  ok = .true.
+  r = 1
+  do i = 1, 2000
+    r = mod(r * 37 + 11, nrec) + 1
+    read(10, rec=r) b
+    if (any(b /= (/ (r * 100 + k, k = 1, n) /))) ok = .false.
+  end do
+  if (ok) res(1) = 1
+
+  ! update in place, then read back
+  a = -7
+  write(10, rec=250) a(1:3)
+  read(10, rec=249) b
+  ok = all(b == (/ (249 * 100 + k, k = 1, n) /))
+  read(10, rec=250) b
+  if (ok .and. all(b(1:3) == -7) .and. all(b(4:) == 0)) res(2) = 1
+
+  ! append records past the end and read them back
+  do i = nrec + 1, nrec + 20
+    a = (/ (i * 100 + k, k = 1, n) /)
+    write(10, rec=i) a
+  end do
+  ok = .true.
+  do i = nrec + 20, 1, -7
+    read(10, rec=i) b
+    if (i /= 250 .and. any(b /= (/ (i * 100 + k, k = 1, n) /))) ok = .false.
+  end do
+  if (ok) res(3) = 1
+
+  ! part of a record, strided, and no items at all
+  c = 0
+  read(10, rec=3) c(1:2 * n:2)
+  read(10, rec=4)
+  read(10, rec=5) b(1:2)
+  if (all(c(1:2 * n:2) == (/ (300 + k, k = 1, n) /)) .and. &
+      b(1) == 501 .and. b(2) == 502) res(4) = 1
+
+  ! records that are not there
+  read(10, rec=nrec + 100, iostat=ios) b
+  if (ios /= 0) res(5) = 1
+  read(10, rec=2, iostat=ios) c
+  if (ios /= 0) res(6) = 1
+
+  flush(10)
+  close(10)
+
+  ! the updates reached the file
+  open(11, file='dirmap.dat', form='unformatted', access='stream', &
+       status='old')
+  read(11, pos=249 * 4 * n + 1) bytes
+  if (all(bytes == -7 .or. bytes == -1)) res(7) = 1
+  inquire(11, size=k)
+  if (k == (nrec + 20) * 4 * n) res(8) = 1
+  close(11, status='delete')
+
+  call check(res, expect, ntests)
+end program dirmap
@@ -0,0 +1,59 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+! Test formats built at runtime and used over and over, which the runtime
+! encodes once and then takes from its cache of encoded formats
+
+program fmtcache
+  integer, parameter :: n = 7
+  integer :: res(n), expect(n)
+  character(len=16) :: f1, f2, f3, bad
+  character(len=32) :: f1long, fvar
+  character(len=32) :: line, ref
+  integer :: i, k
+
+  f1 = '(i4,1x,a3)'
+  f2 = '(2(i3,:,","))'
+  write(f3, '(a,i0,a)') '(f', 7, '.2)'
+  f1long = f1
+  bad = '(i3'
+
+  res = 0
+  expect = 100
+  do i = 1, 100
+    write(line, f1) i, 'abc'
+    write(ref, '(i4,1x,a3)') i, 'abc'
+    if (line == ref) res(1) = res(1) + 1
+
+    ! same format text, different length of the variable holding it
+    write(line, f1long) -i, 'xyz'
+    write(ref, '(i4,1x,a3)') -i, 'xyz'
+    if (line == ref) res(2) = res(2) + 1
+
+    ! format reversion and colon editing
+    write(line, f2) i, -i
+    write(ref, '(2(i3,:,","))') i, -i
+    if (line == ref) res(3) = res(3) + 1
+    write(line, f2) i
+    write(ref, '(2(i3,:,","))') i
+    if (line == ref) res(4) = res(4) + 1
+
+    write(line, f3) i * 0.5
+    write(ref, '(f7.2)') i * 0.5
+    if (line == ref) res(5) = res(5) + 1
+
+    ! a format that changes every iteration
+    write(fvar, '(a,i0,a)') '(i', 4 + mod(i, 3), ')'
+    write(line, fvar) i
+    if (len_trim(line) == 4 + mod(i, 3)) res(6) = res(6) + 1
+
+    ! a bad format must be diagnosed every time
+    k = 0
+    write(line, bad, iostat=k) i
+    if (k /= 0) res(7) = res(7) + 1
+  end do
+
+  call check(res, expect, n)
+end program
@@ -0,0 +1,136 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+! Test E/EN and list-directed output of REAL*8 values, whose leading
+! digits the runtime takes from its 128-bit integer fast path.
+!
+! Run with a count as its argument, e.g. "fmtfast 100000000", this also
+! serves as a benchmark: it writes that many doubles list-directed to a
+! scratch file and reports the rate in MB/s.
+
+program fmtfast
+  integer, parameter :: nv = 15, n = 6
+  real*8 :: v(nv) = (/ 1d0/3d0, 2d0/3d0, 0.125d0, 0.5d-5, &
+    1.2345678901234567d17, 0.99999999999999995d0, 2.5d0, 1d22, 1d-14, &
+    -7d-300, 1.7976931348623157d308, -1234.5d0, 0d0, 4.35d0, 1d-5 /)
+  character(len=24), parameter :: e24(nv) = (/ &
+    '  0.3333333333333333E+00', &
+    '  0.6666666666666666E+00', &
+    '  0.1250000000000000E+00', &
+    '  0.5000000000000000E-05', &
+    '  0.1234567890123457E+18', &
+    '  0.1000000000000000E+01', &
+    '  0.2500000000000000E+01', &
+    '  0.1000000000000000E+23', &
+    '  0.1000000000000000E-13', &
+    ' -0.7000000000000000-299', &
+    '  0.1797693134862316+309', &
+    ' -0.1234500000000000E+04', &
+    '  0.0000000000000000E+00', &
+    '  0.4350000000000000E+01', &
+    '  0.1000000000000000E-04' /)
+  character(len=12), parameter :: en(nv) = (/ &
+    ' 333.333E-03', &
+    ' 666.667E-03', &
+    ' 125.000E-03', &
+    '   5.000E-06', &
+    ' 123.457E+15', &
+    '   1.000E+00', &
+    '   2.500E+00', &
+    '  10.000E+21', &
+    '  10.000E-15', &
+    '  -7.000-300', &
+    ' 179.769+306', &
+    '  -1.235E+03', &
+    '   0.000E+00', &
+    '   4.350E+00', &
+    '  10.000E-06' /)
+  character(len=10), parameter :: rn(nv) = (/ &
+    '  0.33E+00', &
+    '  0.67E+00', &
+    '  0.12E+00', &
+    '  0.50E-05', &
+    '  0.12E+18', &
+    '  0.10E+01', &
+    '  0.25E+01', &
+    '  0.10E+23', &
+    '  0.10E-13', &
+    ' -0.70-299', &
+    '  0.18+309', &
+    ' -0.12E+04', &
+    '  0.00E+00', &
+    '  0.43E+01', &
+    '  0.10E-04' /)
+  character(len=12), parameter :: ru(nv) = (/ &
+    '  0.3334E+00', &
+    '  0.6667E+00', &
+    '  0.1250E+00', &
+    '  0.5001E-05', &
+    '  0.1235E+18', &
+    '  0.1000E+01', &
+    '  0.2500E+01', &
+    '  0.1000E+23', &
+    '  0.1000E-13', &
+    ' -0.7000-299', &
+    '  0.1798+309', &
+    ' -0.1234E+04', &
+    '  0.0000E+00', &
+    '  0.4350E+01', &
+    '  0.1001E-04' /)
+  integer :: res(n), expect(n)
+  character(len=32) :: line, arg
+  real*8 :: x, y
+  integer*8 :: i, cnt, t0, t1, rate
+  integer :: j, k
+
+  res = 0
+  expect = (/ nv, nv, nv, nv, 1000, 1000 /)
+  do j = 1, nv
+    write(line, '(e24.16)') v(j)
+    if (line(1:24) == e24(j)) res(1) = res(1) + 1
+    write(line, '(en12.3)') v(j)
+    if (line(1:12) == en(j)) res(2) = res(2) + 1
+    write(line, '(rn,e10.2)') v(j)
+    if (line(1:10) == rn(j)) res(3) = res(3) + 1
+    write(line, '(ru,e12.4)') v(j)
+    if (line(1:12) == ru(j)) res(4) = res(4) + 1
+  end do
+
+  ! list-directed output has 16 significant digits, ES23.16 has 17 and
+  ! must read back as the same value
+  x = 0.7d0
+  do k = 1, 1000
+    x = 4d0 * x * (1d0 - x)
+    y = x * 10d0 ** (mod(k, 41) - 20)
+    write(line, *) y
+    read(line, *) x
+    if (abs(x - y) <= 1d-15 * abs(y)) res(5) = res(5) + 1
+    write(line, '(es23.16)') y
+    read(line, *) x
+    if (x == y) res(6) = res(6) + 1
+    x = y / 10d0 ** (mod(k, 41) - 20)
+  end do
+
+  call check(res, expect, n)
+
+  if (command_argument_count() > 0) then
+    call get_command_argument(1, arg)
+    read(arg, *) cnt
+    open(10, status='scratch', form='formatted')
+    x = 0.7d0
+    call system_clock(t0, rate)
+    do i = 1, cnt
+      x = 4d0 * x * (1d0 - x)
+      write(10, *) x
+    end do
+    call system_clock(t1)
+    inquire(10, size=i)
+    close(10)
+    if (t1 > t0 .and. i > 0) then
+      print '(i0,a,f10.1,a)', cnt, ' doubles written, ', &
+        (dble(i) / 1d6) / (dble(t1 - t0) / dble(rate)), ' MB/s'
+    end if
+  end if
+end program
@@ -0,0 +1,111 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+! Test i/o statements on different units from concurrent OpenMP threads,
+! including statements whose I/O lists write to the unit that the other
+! thread is writing to at the same time.  Such a nested write may fail
+! with IOSTAT set rather than deadlock, but a record is never broken up by
+! a record from the other thread.
+
+module iothr_mod
+contains
+  integer function logto(u, i)
+    integer :: u, i, ios
+    write(u, *, iostat=ios) 'nested', i
+    if (ios == 0) then
+      logto = i
+    else
+      logto = -i
+    end if
+  end function
+end module
+
+program iothr
+  use iothr_mod
+  integer, parameter :: nu = 4, nl = 500
+  integer :: res(nu + 3), expect(nu + 3)
+  integer :: i, j, k, u, v(3), ios, nested(2), passed(2)
+  character(len=16) :: fname
+  character(len=80) :: line, ref
+  character(len=6) :: tag
+
+  expect = nl
+  expect(nu + 1 : nu + 2) = 4 * nl
+  expect(nu + 3) = 1
+  res = 0
+  !$omp parallel do private(j, k, u, v, ios, fname) num_threads(nu)
+  do i = 1, nu
+    write(fname, '(a,i0,a)') 'iothr', i, '.dat'
+    open(newunit=u, file=fname, status='replace', action='readwrite')
+    do j = 1, nl
+      write(u, *) i, j, 7 * j
+    end do
+    rewind(u)
+    k = 0
+    do j = 1, nl
+      read(u, *, iostat=ios) v
+      if (ios == 0 .and. v(1) == i .and. v(2) == j .and. v(3) == 7 * j) &
+        k = k + 1
+    end do
+    close(u, status='delete')
+    res(i) = k
+  end do
+  !$omp end parallel do
+
+  ! each thread writes to one unit from a function in the I/O list of a
+  ! statement on the other, after an item of the outer record
+  open(21, file='iothr21.dat', status='replace')
+  open(22, file='iothr22.dat', status='replace')
+  !$omp parallel do private(j) num_threads(2)
+  do i = 1, 2
+    do j = 1, 4 * nl
+      if (i == 1) then
+        write(21, *) 'outer', j, logto(22, j)
+      else
+        write(22, *) 'outer', j, logto(21, j)
+      end if
+    end do
+  end do
+  !$omp end parallel do
+  ! every line is a whole record: the outer records in order, each with the
+  ! result of its nested write, and the nested records that succeeded
+  res(nu + 3) = 1
+  do i = 1, 2
+    rewind(20 + i)
+    k = 0
+    nested(i) = 0
+    passed(i) = 0
+    do
+      read(20 + i, '(a)', iostat=ios) line
+      if (ios /= 0) exit
+      read(line, *, iostat=ios) tag
+      if (ios == 0 .and. tag == 'outer') then
+        read(line, *, iostat=ios) tag, j, u
+        write(ref, *) 'outer', j, u
+        if (ios == 0 .and. line == ref .and. j == k + 1 .and. abs(u) == j) then
+          k = k + 1
+          if (u > 0) passed(i) = passed(i) + 1
+        else
+          res(nu + 3) = 0
+        end if
+      else if (ios == 0 .and. tag == 'nested') then
+        read(line, *, iostat=ios) tag, j
+        write(ref, *) 'nested', j
+        if (ios == 0 .and. line == ref) then
+          nested(i) = nested(i) + 1
+        else
+          res(nu + 3) = 0
+        end if
+      else
+        res(nu + 3) = 0
+      end if
+    end do
+    close(20 + i, status='delete')
+    res(nu + i) = k
+  end do
+  if (nested(1) /= passed(2) .or. nested(2) /= passed(1)) res(nu + 3) = 0
+
+  call check(res, expect, nu + 3)
+end program
@@ -0,0 +1,82 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+! Test list-directed and F/E formatted input of plain numbers, which the
+! runtime converts without strtod, mixed with the forms it does not
+
+program ldrfast
+  integer, parameter :: n = 11, m = 1000
+  integer :: res(n), expect(n)
+  character(len=80) :: line
+  character(len=25*m) :: big
+  integer :: i4(6), k
+  integer*8 :: i8(3)
+  real :: r4(4)
+  real*8 :: r8(8), x(m), y(m), z(m)
+
+  res = 0
+  expect = 1
+  expect(9:10) = m
+
+  line = ' 12, -7 ,,3*5  +42'
+  i4 = -1
+  read(line, *) i4
+  if (all(i4 == (/ 12, -7, -1, 5, 5, 5 /))) res(1) = 1
+
+  line = '2147483647 -9876543210123 0'
+  read(line, *) i8
+  if (all(i8 == (/ 2147483647_8, -9876543210123_8, 0_8 /))) res(2) = 1
+
+  line = '1 2.5 -.25e1 1d2 /'
+  r4 = 9
+  read(line, *) r4
+  if (all(r4 == (/ 1.0, 2.5, -2.5, 100.0 /))) res(3) = 1
+
+  line = '0.1, 1.0000000000000002 123456789012345678 4.9406564584124654d-324'
+  read(line, *) r8(1:4)
+  if (r8(1) == 0.1d0 .and. r8(2) == 1.0000000000000002d0 .and. &
+      r8(3) == 123456789012345678d0 .and. r8(4) == 4.9406564584124654d-324) &
+    res(4) = 1
+
+  ! more digits than fit in 64 bits, then a slash
+  line = '0.30000000000000001665334536937734810635 1/ 5'
+  r8 = 7
+  read(line, *) r8(1:3)
+  if (r8(1) == 0.3d0 .and. r8(2) == 1d0 .and. r8(3) == 7d0) res(5) = 1
+
+  line = '-0.0 1e22 1e23 8.98846567431158e307'
+  read(line, *) r8(1:4)
+  if (transfer(r8(1), 0_8) < 0 .and. r8(2) == 1d22 .and. r8(3) == 1d23 .and. &
+      r8(4) == 8.98846567431158d307) res(6) = 1
+
+  line = '   1.5  -2.5E+3   12345  1.5D-2'
+  read(line, '(4f8.2)') r8(1:4)
+  if (all(r8(1:4) == (/ 1.5d0, -2.5d3, 123.45d0, 1.5d-2 /))) res(7) = 1
+
+  line = ' 1 5  2.0e1 3.0+1'
+  read(line, '(bz,f6.1,f5.0,f6.0)') r8(1:3)
+  if (all(r8(1:3) == (/ 1050d0, 20d0, 30d0 /))) res(8) = 1
+
+  ! exponents too long for an int, and leading zeros that are not
+  line = '1e99999999999 5e-99999999999 1.5e00000000000000000001'
+  read(line, *) r8(1:3)
+  if (r8(1) > huge(r8) .and. r8(2) == 0d0 .and. r8(3) == 15d0) res(11) = 1
+
+  ! values written with 17 significant digits read back exactly
+  x(1) = 0.7d0
+  do k = 2, m
+    x(k) = 4d0 * x(k - 1) * (1d0 - x(k - 1))
+  end do
+  do k = 1, m
+    x(k) = x(k) * 10d0 ** (mod(k, 61) - 30)
+  end do
+  write(big, '(1000es25.16e3)') x
+  read(big, *) y
+  read(big, '(1000e25.0)') z
+  res(9) = count(x == y)
+  res(10) = count(x == z)
+
+  call check(res, expect, n)
+end program
@@ -0,0 +1,166 @@
+!** Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+!** See https://llvm.org/LICENSE.txt for license information.
+!** SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+!* Tests for the cache-blocked runtime MATMUL path, taken for contiguous
+!* operands once n*m*k reaches the blocking threshold.  Integer-valued
+!* data keeps every partial sum exact, so the blocked and the reference
+!* results must agree exactly.  The second set of operands has an inner
+!* extent larger than the blocking factor, so later blocks along it are
+!* added into the partial result already in c.
+
+program p
+
+  parameter(n_extent=70)
+  parameter(m_extent=45)
+  parameter(k_extent=50)
+  parameter(n2_extent=20)
+  parameter(m2_extent=300)
+  parameter(k2_extent=30)
+  parameter(NbrCases=6)
+  parameter(NbrTests1=NbrCases*n_extent*k_extent)
+  parameter(NbrTests=NbrTests1+NbrCases*n2_extent*k2_extent)
+
+  REAL*8, dimension(n_extent,m_extent) :: a8
+  REAL*8, dimension(m_extent,k_extent) :: b8
+  REAL*8, dimension(n_extent+3,k_extent) :: c8
+  REAL*4, dimension(n_extent,m_extent) :: a4
+  REAL*4, dimension(m_extent,k_extent) :: b4
+  REAL*4, dimension(n_extent,k_extent) :: c4
+  COMPLEX*16, dimension(n_extent,m_extent) :: az16
+  COMPLEX*16, dimension(m_extent,k_extent) :: bz16
+  COMPLEX*16, dimension(n_extent,k_extent) :: cz16
+  COMPLEX*8, dimension(n_extent,m_extent) :: az8
+  COMPLEX*8, dimension(m_extent,k_extent) :: bz8
+  COMPLEX*8, dimension(n_extent,k_extent) :: cz8
+
+  REAL*8, dimension(n_extent,k_extent) :: refr, refi
+
+  REAL*8, dimension(n2_extent,m2_extent) :: d8
+  REAL*8, dimension(m2_extent,k2_extent) :: e8
+  REAL*8, dimension(n2_extent,k2_extent) :: f8
+  REAL*4, dimension(n2_extent,m2_extent) :: d4
+  REAL*4, dimension(m2_extent,k2_extent) :: e4
+  REAL*4, dimension(n2_extent,k2_extent) :: f4
+  COMPLEX*16, dimension(n2_extent,m2_extent) :: dz16
+  COMPLEX*16, dimension(m2_extent,k2_extent) :: ez16
+  COMPLEX*16, dimension(n2_extent,k2_extent) :: fz16
+  COMPLEX*8, dimension(n2_extent,m2_extent) :: dz8
+  COMPLEX*8, dimension(m2_extent,k2_extent) :: ez8
+  COMPLEX*8, dimension(n2_extent,k2_extent) :: fz8
+  REAL*8, dimension(n2_extent,k2_extent) :: ref2r, ref2i
+  integer :: expect(NbrTests)
+  integer :: results(NbrTests)
+  integer :: i, j, l, t
+
+  do j = 1, m_extent
+    do i = 1, n_extent
+      a8(i,j) = mod(i*3 + j*7, 10)
+      az16(i,j) = cmplx(a8(i,j), mod(i + j*5, 7), 8)
+    end do
+  end do
+  do j = 1, k_extent
+    do i = 1, m_extent
+      b8(i,j) = mod(i*5 + j*11, 9)
+      bz16(i,j) = cmplx(b8(i,j), mod(i*2 + j, 6), 8)
+    end do
+  end do
+  a4 = a8
+  b4 = b8
+  az8 = az16
+  bz8 = bz16
+
+  refr = 0
+  refi = 0
+  do j = 1, k_extent
+    do l = 1, m_extent
+      do i = 1, n_extent
+        refr(i,j) = refr(i,j) + dble(az16(i,l))*dble(bz16(l,j)) &
+                              - dimag(az16(i,l))*dimag(bz16(l,j))
+        refi(i,j) = refi(i,j) + dble(az16(i,l))*dimag(bz16(l,j)) &
+                              + dimag(az16(i,l))*dble(bz16(l,j))
+      end do
+    end do
+  end do
+
+  c8 = 0
+  c8(1:n_extent,:) = matmul(a8, b8)
+  c4 = matmul(a4, b4)
+  cz16 = matmul(az16, bz16)
+  cz8 = matmul(az8, bz8)
+
+  t = 0
+  do j = 1, k_extent
+    do i = 1, n_extent
+      t = t + 1
+      expect(t) = nint(sum(a8(i,:) * b8(:,j)))
+      results(t) = nint(c8(i,j))
+      expect(t + n_extent*k_extent) = expect(t)
+      results(t + n_extent*k_extent) = nint(c4(i,j))
+      expect(t + 2*n_extent*k_extent) = nint(refr(i,j))
+      results(t + 2*n_extent*k_extent) = nint(dble(cz16(i,j)))
+      expect(t + 3*n_extent*k_extent) = nint(refi(i,j))
+      results(t + 3*n_extent*k_extent) = nint(dimag(cz16(i,j)))
+      expect(t + 4*n_extent*k_extent) = nint(refr(i,j))
+      results(t + 4*n_extent*k_extent) = nint(real(cz8(i,j)))
+      expect(t + 5*n_extent*k_extent) = nint(refi(i,j))
+      results(t + 5*n_extent*k_extent) = nint(aimag(cz8(i,j)))
+    end do
+  end do
+
+  do j = 1, m2_extent
+    do i = 1, n2_extent
+      d8(i,j) = mod(i*7 + j*3, 9)
+      dz16(i,j) = cmplx(d8(i,j), mod(i*3 + j, 5), 8)
+    end do
+  end do
+  do j = 1, k2_extent
+    do i = 1, m2_extent
+      e8(i,j) = mod(i*2 + j*5, 8)
+      ez16(i,j) = cmplx(e8(i,j), mod(i + j*3, 7), 8)
+    end do
+  end do
+  d4 = d8
+  e4 = e8
+  dz8 = dz16
+  ez8 = ez16
+
+  ref2r = 0
+  ref2i = 0
+  do j = 1, k2_extent
+    do l = 1, m2_extent
+      do i = 1, n2_extent
+        ref2r(i,j) = ref2r(i,j) + dble(dz16(i,l))*dble(ez16(l,j)) &
+                                - dimag(dz16(i,l))*dimag(ez16(l,j))
+        ref2i(i,j) = ref2i(i,j) + dble(dz16(i,l))*dimag(ez16(l,j)) &
+                                + dimag(dz16(i,l))*dble(ez16(l,j))
+      end do
+    end do
+  end do
+
+  f8 = matmul(d8, e8)
+  f4 = matmul(d4, e4)
+  fz16 = matmul(dz16, ez16)
+  fz8 = matmul(dz8, ez8)
+
+  t = NbrTests1
+  do j = 1, k2_extent
+    do i = 1, n2_extent
+      t = t + 1
+      expect(t) = nint(sum(d8(i,:) * e8(:,j)))
+      results(t) = nint(f8(i,j))
+      expect(t + n2_extent*k2_extent) = expect(t)
+      results(t + n2_extent*k2_extent) = nint(f4(i,j))
+      expect(t + 2*n2_extent*k2_extent) = nint(ref2r(i,j))
+      results(t + 2*n2_extent*k2_extent) = nint(dble(fz16(i,j)))
+      expect(t + 3*n2_extent*k2_extent) = nint(ref2i(i,j))
+      results(t + 3*n2_extent*k2_extent) = nint(dimag(fz16(i,j)))
+      expect(t + 4*n2_extent*k2_extent) = nint(ref2r(i,j))
+      results(t + 4*n2_extent*k2_extent) = nint(real(fz8(i,j)))
+      expect(t + 5*n2_extent*k2_extent) = nint(ref2i(i,j))
+      results(t + 5*n2_extent*k2_extent) = nint(aimag(fz8(i,j)))
+    end do
+  end do
+
+  call check(results, expect, NbrTests)
+end program
@@ -0,0 +1,129 @@
+!** Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+!** See https://llvm.org/LICENSE.txt for license information.
+!** SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+!* Tests for the threaded runtime MATMUL, which splits a product over
+!* several threads once n*m*k is at least twice the per-thread minimum.
+!* The cases cover column and row slicing of the blocked engine, the
+!* transposed kernels, and a product inside a parallel region, which
+!* must stay serial.  Integer-valued data keeps every partial sum exact,
+!* so each result must agree exactly with a serial loop reference; each
+!* test counts the elements that differ.
+
+program p
+  parameter(n1=256, m1=300, k1=200)
+  parameter(n2=4000, m2=600, k2=4)
+  parameter(n3=220, m3=240, k3=180)
+  parameter(NbrTests=7)
+
+  REAL*8, dimension(n1,m1) :: a8
+  REAL*8, dimension(m1,k1) :: b8
+  REAL*8, dimension(n1,k1) :: c8, r8
+  REAL*8, dimension(n2,m2) :: d8
+  REAL*8, dimension(m2,k2) :: e8
+  REAL*8, dimension(n2,k2) :: f8, s8
+  REAL*4, dimension(m3,n3) :: ta4
+  REAL*4, dimension(m3,k3) :: b4
+  REAL*4, dimension(n3,k3) :: c4
+  COMPLEX*16, dimension(m3,n3) :: taz
+  COMPLEX*16, dimension(m3,k3) :: bz
+  COMPLEX*16, dimension(n3,k3) :: cz
+  REAL*8, dimension(n3,k3) :: r3, rzr, rzi
+  REAL*8, dimension(n1,k1,2) :: cp
+
+  integer :: expect(NbrTests)
+  integer :: results(NbrTests)
+  integer :: i, j, l, t
+
+  expect = 0
+  results = 0
+
+  do j = 1, m1
+    do i = 1, n1
+      a8(i,j) = mod(i*3 + j*7, 10)
+    end do
+  end do
+  do j = 1, k1
+    do i = 1, m1
+      b8(i,j) = mod(i*5 + j*11, 9)
+    end do
+  end do
+  r8 = 0
+  do j = 1, k1
+    do l = 1, m1
+      do i = 1, n1
+        r8(i,j) = r8(i,j) + a8(i,l)*b8(l,j)
+      end do
+    end do
+  end do
+
+  ! enough columns for every thread: sliced on columns of c
+  c8 = matmul(a8, b8)
+  results(1) = count(c8 /= r8)
+
+  ! too few columns: sliced on rows of c
+  do j = 1, m2
+    do i = 1, n2
+      d8(i,j) = mod(i + j*3, 7)
+    end do
+  end do
+  do j = 1, k2
+    do i = 1, m2
+      e8(i,j) = mod(i*2 + j*5, 8)
+    end do
+  end do
+  s8 = 0
+  do j = 1, k2
+    do l = 1, m2
+      do i = 1, n2
+        s8(i,j) = s8(i,j) + d8(i,l)*e8(l,j)
+      end do
+    end do
+  end do
+  f8 = matmul(d8, e8)
+  results(2) = count(f8 /= s8)
+
+  ! transposed first operand
+  do j = 1, n3
+    do i = 1, m3
+      ta4(i,j) = mod(i*7 + j*3, 9)
+      taz(i,j) = cmplx(ta4(i,j), mod(i*3 + j, 5), 8)
+    end do
+  end do
+  do j = 1, k3
+    do i = 1, m3
+      b4(i,j) = mod(i*2 + j*5, 8)
+      bz(i,j) = cmplx(b4(i,j), mod(i + j*3, 7), 8)
+    end do
+  end do
+  r3 = 0
+  rzr = 0
+  rzi = 0
+  do j = 1, k3
+    do i = 1, n3
+      do l = 1, m3
+        r3(i,j) = r3(i,j) + ta4(l,i)*b4(l,j)
+        rzr(i,j) = rzr(i,j) + dble(taz(l,i))*dble(bz(l,j)) &
+                            - dimag(taz(l,i))*dimag(bz(l,j))
+        rzi(i,j) = rzi(i,j) + dble(taz(l,i))*dimag(bz(l,j)) &
+                            + dimag(taz(l,i))*dble(bz(l,j))
+      end do
+    end do
+  end do
+  c4 = matmul(transpose(ta4), b4)
+  results(3) = count(c4 /= r3)
+  cz = matmul(transpose(taz), bz)
+  results(4) = count(dble(cz) /= rzr)
+  results(5) = count(dimag(cz) /= rzi)
+
+  ! inside a parallel region every product runs on its own thread
+  !$omp parallel do num_threads(2)
+  do t = 1, 2
+    cp(:,:,t) = matmul(a8, b8)
+  end do
+  !$omp end parallel do
+  results(6) = count(cp(:,:,1) /= r8)
+  results(7) = count(cp(:,:,2) /= r8)
+
+  call check(results, expect, NbrTests)
+end program
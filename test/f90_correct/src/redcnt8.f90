@@ -0,0 +1,40 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+! Test COUNT and SUM of arrays large enough for the runtime to split them
+! across threads, compiled with -i8 so that the runtime's descriptors and
+! default integers are eight bytes.  Covers logicals of every kind.  Built
+! with -Mx,47,0x80 so that the reductions are not inlined.
+
+program redcnt8
+  implicit none
+  integer, parameter :: n = 6000001, ntests = 6
+  integer :: res(ntests), expect(ntests)
+  logical(1), allocatable :: l1(:)
+  logical(2), allocatable :: l2(:)
+  logical(4), allocatable :: l4(:)
+  logical, allocatable :: l8(:)
+  integer, allocatable :: ia(:)
+  integer :: i, c, isum
+
+  allocate(l1(n), l2(n), l4(n), l8(n), ia(n))
+  c = 0
+  isum = 0
+  do i = 1, n
+    l8(i) = mod(i * 7, 11) < 4
+    l1(i) = l8(i)
+    l2(i) = l8(i)
+    l4(i) = l8(i)
+    if (l8(i)) c = c + 1
+    ia(i) = mod(i, 1000) - 300
+    isum = isum + ia(i)
+  end do
+
+  res = (/ count(l1), count(l2), count(l4), count(l8), &
+           count(l8(2:n)), sum(ia) /)
+  expect = (/ c, c, c, c, c - merge(1, 0, l8(1)), isum /)
+
+  call check(res, expect, ntests)
+end program
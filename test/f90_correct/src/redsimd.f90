@@ -0,0 +1,131 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+! Test SUM, MAXVAL, MINVAL, MAXLOC, MINLOC and COUNT of contiguous arrays
+! without a mask, which the runtime reduces with stride 1 kernels, against
+! explicit loops.  Covers whole arrays, sections, DIM, BACK, ties, NaNs and
+! lengths that are not a multiple of the kernels' unrolling.
+
+program redsimd
+  use ieee_arithmetic
+  implicit none
+  integer, parameter :: n = 1003, m = 37, ntests = 16
+  integer :: res(ntests), expect(ntests)
+  real(8) :: a(n, m), s, e(n), smax(m)
+  integer :: ia(n, m), isum, imax, i, j, k, loc(2), eloc(2), ml(m), eml(m)
+  integer(8) :: kloc(2)
+  logical :: l(n, m), ok
+  real(4) :: f(21)
+
+  do j = 1, m
+    do i = 1, n
+      a(i, j) = mod(i * 7919 + j * 104729, 1009) - 500
+      ia(i, j) = mod(i * 31 + j * 17, 1000) - 400
+      l(i, j) = mod(i + j, 3) == 0
+    end do
+  end do
+  a(5, 1) = 1000.0d0
+  a(n - 2, m) = 1000.0d0
+  a(17, 1) = -1000.0d0
+  a(200, 4) = -1000.0d0
+  res = 0
+  expect = 1
+
+  ! whole array
+  s = 0
+  isum = 0
+  imax = -huge(imax)
+  do j = 1, m
+    do i = 1, n
+      s = s + a(i, j)
+      isum = isum + ia(i, j)
+      imax = max(imax, ia(i, j))
+    end do
+  end do
+  if (sum(a) == s .and. sum(ia) == isum) res(1) = 1
+  if (maxval(a) == 1000.0d0 .and. minval(a) == -1000.0d0 .and. &
+      maxval(ia) == imax) res(2) = 1
+  loc = maxloc(a)
+  if (all(loc == (/ 5, 1 /))) res(3) = 1
+  loc = maxloc(a, back=.true.)
+  if (all(loc == (/ n - 2, m /))) res(4) = 1
+  loc = minloc(a)
+  if (all(loc == (/ 17, 1 /))) res(5) = 1
+  loc = minloc(a, back=.true.)
+  if (all(loc == (/ 200, 4 /))) res(6) = 1
+  kloc = maxloc(a, kind=8)
+  if (all(kloc == (/ 5_8, 1_8 /))) res(7) = 1
+  k = 0
+  do j = 1, m
+    do i = 1, n
+      if (l(i, j)) k = k + 1
+    end do
+  end do
+  if (count(l) == k) res(8) = 1
+
+  ! a section whose columns are contiguous
+  loc = maxloc(a(2:n - 1, 2:m))
+  if (all(loc == (/ n - 3, m - 1 /))) res(9) = 1
+  if (minval(a(20:n, :)) == -1000.0d0 .and. &
+      all(minloc(a(20:n, :)) == (/ 181, 4 /))) res(10) = 1
+
+  ! DIM
+  ok = .true.
+  do j = 1, m
+    s = 0
+    smax(j) = -huge(s)
+    eml(j) = 0
+    do i = 1, n
+      s = s + a(i, j)
+      if (a(i, j) > smax(j)) then
+        smax(j) = a(i, j)
+        eml(j) = i
+      end if
+    end do
+    e(j) = s
+  end do
+  if (any(sum(a, dim=1) /= e(1:m))) ok = .false.
+  if (any(maxval(a, dim=1) /= smax)) ok = .false.
+  ml = maxloc(a, dim=1)
+  if (any(ml /= eml)) ok = .false.
+  if (ok) res(11) = 1
+
+  ! ties, all equal
+  a = 2.5d0
+  if (all(maxloc(a) == (/ 1, 1 /)) .and. &
+      all(minloc(a, back=.true.) == (/ n, m /)) .and. &
+      sum(a) == 2.5d0 * n * m) res(12) = 1
+
+  ! NaNs are never the maximum
+  a = ieee_value(1.0d0, ieee_quiet_nan)
+  if (.not. (maxval(a(1:n, 1)) > 0)) res(13) = 1
+  a(9, 3) = 4.0d0
+  a(n, m) = 4.0d0
+  if (maxval(a) == 4.0d0 .and. all(maxloc(a) == (/ 9, 3 /)) .and. &
+      all(maxloc(a, back=.true.) == (/ n, m /))) res(14) = 1
+
+  ! short vectors
+  do i = 1, 21
+    f(i) = mod(i * 5, 11)
+  end do
+  if (sum(f) == 110.0 .and. maxval(f) == 10.0 .and. maxloc(f, 1) == 2 .and. &
+      minloc(f, 1) == 11 .and. minloc(f, 1, back=.true.) == 11) res(15) = 1
+
+  ! a mask still takes the general path
+  eloc = (/ 0, 0 /)
+  imax = -huge(imax)
+  do j = 1, m
+    do i = 1, n
+      if (l(i, j) .and. ia(i, j) > imax) then
+        imax = ia(i, j)
+        eloc = (/ i, j /)
+      end if
+    end do
+  end do
+  if (all(maxloc(ia, mask=l) == eloc) .and. maxval(ia, mask=l) == imax) &
+    res(16) = 1
+
+  call check(res, expect, ntests)
+end program redsimd
@@ -0,0 +1,127 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+! Test RANDOM_NUMBER from OpenMP threads with F90_RANDOM_THREADS set, so
+! that each thread draws from its own stream: the streams differ, they
+! repeat exactly after the same RANDOM_SEED, they carry on from one
+! parallel region to the next, and they leave the program-wide stream
+! alone.  A region nested inside one of those, even an inactive one, draws
+! from the program-wide stream.
+!
+! Run with a count as its argument, e.g. "rnumthr 10000000", this also
+! serves as a benchmark: 8 threads each draw that many numbers, one at a
+! time and in arrays, and it reports the rate.
+
+program rnumthr
+  implicit none
+  integer, parameter :: nt = 4, m = 1000, ntests = 7
+  real*8 :: a(m, nt), b(m, nt), c(m, nt), x1, x2, s
+  real*4 :: r(100, nt)
+  real*8, allocatable :: big(:)
+  integer :: res(ntests), expect(ntests)
+  integer :: seed(34), t, k, good, omp_get_thread_num
+  integer*8 :: cnt, j, t0, t1, rate
+  character(len=32) :: arg
+
+  res = 0
+  expect = 1
+  seed = (/ (1009 * k + 17, k = 1, 34) /)
+
+  call random_seed(put=seed)
+  !$omp parallel num_threads(nt) private(t, k)
+  t = omp_get_thread_num() + 1
+  call random_number(a(1:m / 2, t))
+  do k = m / 2 + 1, m
+    call random_number(a(k, t))
+  end do
+  call random_number(r(:, t))
+  !$omp end parallel
+  call random_number(x1)
+
+  ! values are in range and every thread has a stream of its own
+  if (all(a >= 0d0 .and. a < 1d0) .and. all(r >= 0 .and. r <= 1)) res(1) = 1
+  good = 1
+  do t = 2, nt
+    if (any(a(:, t) == a(:, 1))) good = 0
+  end do
+  res(2) = good
+
+  ! the same seed gives the same numbers on each thread
+  call random_seed(put=seed)
+  !$omp parallel num_threads(nt) private(t)
+  t = omp_get_thread_num() + 1
+  call random_number(b(:, t))
+  !$omp end parallel
+  if (all(b == a)) res(3) = 1
+
+  ! a second region carries on where the first one stopped
+  !$omp parallel num_threads(nt) private(t)
+  t = omp_get_thread_num() + 1
+  call random_number(c(:, t))
+  !$omp end parallel
+  good = 1
+  do t = 1, nt
+    if (any(c(:, t) == b(:, t))) good = 0
+  end do
+  res(4) = good
+
+  ! the program-wide stream is not used up by the threads
+  call random_seed(put=seed)
+  call random_number(x2)
+  if (x1 == x2) res(5) = 1
+
+  ! large arrays in a region agree with the same draws made in pieces
+  call random_seed(put=seed)
+  allocate(big(4 * m))
+  !$omp parallel num_threads(nt) private(t, k)
+  t = omp_get_thread_num() + 1
+  if (t == 2) then
+    call random_number(big)
+  end if
+  !$omp end parallel
+  if (all(big(1:m) == a(:, 2)) .and. all(big(m + 1:2 * m) == c(:, 2))) &
+    res(6) = 1
+
+  ! in an inactive nested region every outer thread is thread 0; each one
+  ! must take whole arrays from the program-wide stream under its lock
+  call random_seed(put=seed)
+  !$omp parallel num_threads(nt) private(t)
+  t = omp_get_thread_num() + 1
+  !$omp parallel num_threads(1)
+  call random_number(b(:, t))
+  !$omp end parallel
+  !$omp end parallel
+  call random_seed(put=seed)
+  call random_number(c)
+  good = 1
+  do k = 1, nt
+    if (count((/ (all(b(:, t) == c(:, k)), t = 1, nt) /)) /= 1) good = 0
+  end do
+  res(7) = good
+
+  call check(res, expect, ntests)
+
+  if (command_argument_count() > 0) then
+    call get_command_argument(1, arg)
+    read(arg, *) cnt
+    call system_clock(t0, rate)
+    !$omp parallel num_threads(8) private(j, x1, a) reduction(+:s)
+    s = 0
+    do j = 1, cnt / 2
+      call random_number(x1)
+      s = s + x1
+    end do
+    do j = 1, cnt / 2, m
+      call random_number(a(:, 1))
+      s = s + a(1, 1)
+    end do
+    !$omp end parallel
+    call system_clock(t1)
+    if (t1 > t0) then
+      print '(i0,a,f10.3,a)', 8 * cnt, ' random numbers on 8 threads, ', &
+        8 * dble(cnt) / (dble(t1 - t0) / dble(rate)) / 1d6, ' M/s'
+    end if
+  end if
+end program
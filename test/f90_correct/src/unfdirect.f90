@@ -0,0 +1,99 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+! Test unformatted transfers of large contiguous arrays, which the runtime
+! moves straight between the array and the file, mixed with small and
+! strided items, with and without byte swapping
+
+program unfdirect
+  implicit none
+  integer, parameter :: n = 200000, ntests = 8
+  integer :: res(ntests), expect(ntests)
+  real(8) :: a(n), b(n)
+  integer :: ia(n), ib(n), hdr(3), hdr2(3), i, k
+  integer(1) :: bytes(8)
+  character(len=5) :: tag, tag2
+  logical :: ok
+
+  do i = 1, n
+    a(i) = i * 0.5d0
+    ia(i) = 3 * i - n
+  end do
+  hdr = (/ 7, 8, 9 /)
+  tag = 'check'
+  res = 0
+  expect = 1
+
+  ! native sequential: small items buffered ahead of big ones, strided data
+  open(10, file='unfdirect.nat', form='unformatted', status='replace')
+  write(10) hdr, a
+  write(10) a, ia(1:n:2), tag
+  write(10) ia
+  rewind(10)
+  b = 0.0d0
+  hdr2 = 0
+  read(10) hdr2, b
+  if (all(hdr2 == hdr) .and. all(b == a)) res(1) = 1
+  b = 0.0d0
+  ib = 0
+  tag2 = ' '
+  read(10) b, ib(1:n / 2), tag2
+  ok = .true.
+  do i = 1, n / 2
+    if (ib(i) /= ia(2 * i - 1)) ok = .false.
+  end do
+  if (ok .and. all(b == a) .and. tag2 == tag) res(2) = 1
+  ib = 0
+  read(10) ib
+  if (all(ib == ia)) res(3) = 1
+  close(10, status='delete')
+
+  ! byte swapped
+  open(11, file='unfdirect.big', form='unformatted', status='replace', &
+       convert='big_endian')
+  write(11) hdr, a
+  write(11) ia(1:n:3), ia
+  close(11)
+  open(11, file='unfdirect.big', form='unformatted', status='old', &
+       convert='big_endian')
+  b = 0.0d0
+  hdr2 = 0
+  read(11) hdr2, b
+  if (all(hdr2 == hdr) .and. all(b == a)) res(4) = 1
+  ib = 0
+  read(11) ib(1:(n + 2) / 3), ib
+  if (all(ib == ia)) res(5) = 1
+  close(11)
+
+  ! the data in the file really is big endian, and the program's copy of
+  ! it was not touched while it was swapped
+  open(12, file='unfdirect.big', form='unformatted', access='stream', &
+       status='old')
+  read(12, pos=17) bytes
+  k = 0
+  if (bytes(1) == 63 .and. bytes(2) == -32) k = 1
+  do i = 3, 8
+    if (bytes(i) /= 0) k = 0
+  end do
+  res(6) = k
+  if (a(1) == 0.5d0 .and. ia(2) == 6 - n) res(7) = 1
+  close(12, status='delete')
+
+  ! direct access records split between buffered and direct parts
+  open(13, file='unfdirect.dir', form='unformatted', access='direct', &
+       recl=8 * n + 12, status='replace')
+  write(13, rec=2) hdr, a
+  write(13, rec=1) a(n:1:-1), hdr
+  b = 0.0d0
+  hdr2 = 0
+  read(13, rec=1) b, hdr2
+  ok = all(hdr2 == hdr) .and. all(b(n:1:-1) == a)
+  b = 0.0d0
+  read(13, rec=2) hdr2, b
+  if (ok .and. all(hdr2 == hdr) .and. all(b == a)) res(8) = 1
+  close(13, status='delete')
+
+  call check(res, expect, ntests)
+end program unfdirect
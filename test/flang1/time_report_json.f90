@@ -0,0 +1,28 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+
+! -ftime-report-json should write a well formed report from each compiler,
+! with one record per routine.
+! RUN: %flang1 %s -output %t.ilm -ftime-report-json %t1.json
+! RUN: %flang2 %t.ilm -asm %t.ll -ftime-report-json %t2.json
+! RUN: %python -c "import json, sys; d = json.load(open(sys.argv[1])); print(d['compiler'], [r['name'] for r in d['routines']])" %t1.json | FileCheck %s --check-prefix=FLANG1
+! RUN: %python -c "import json, sys; d = json.load(open(sys.argv[1])); print(d['compiler'], [r['name'] for r in d['routines']])" %t2.json | FileCheck %s --check-prefix=FLANG2
+
+! FLANG1: flang1 ['tr_sub', 'tr_prog']
+! FLANG2: flang2 ['tr_sub', 'tr_prog']
+
+subroutine tr_sub(a, n)
+  integer :: n
+  real :: a(n)
+  a = a + 1.0
+end subroutine
+
+program tr_prog
+  real :: a(10)
+  a = 0
+  call tr_sub(a, 10)
+  print *, a(1)
+end program
@@ -11,6 +11,9 @@
  */
 
 #include "gbldefs.h"
+#ifndef HOST_WIN
+#include <sys/stat.h>
+#endif
 #include "global.h"
 #include "error.h"
 #include "symtab.h"
@@ -109,7 +112,6 @@ typedef struct {          /* info on data type read from encoded file */
   int ty;                 /* type of dtype, TY_PTR, etc.  */
   int new_id;             /* dtype number for this compilation */
   LOGICAL dtypeinstalled; /* set if dtype complete */
-  int hashnext;           /* in hash table linked list */
 } DITEM;
 
 typedef struct symitem {/* info on symbol read from encoded mod file */
@@ -126,7 +128,6 @@ typedef struct symitem {/* info on symbol read from encoded mod file */
   char name[MAXIDLEN + 1]; /* symbol name (only certain stypes) */
   char *strptr;            /* pointer to char string (constant) */
   struct symitem *next;
-  struct symitem *hashnext; /* next item from hash table */
   int socptr;               /* overlap region pointer */
   int shadowptr;            /* new shadow region pointer */
 } SYMITEM;
@@ -152,7 +153,6 @@ typedef struct {/* info on ast read from mod file */
   int type;     /* A_TYPE(ast) */
   AST a;        /* AST data */
   int new_ast, old_ast;
-  int link; /* link to next ast in hash table */
   int list, flags, shape;
 } ASTITEM;
 
@@ -232,11 +232,6 @@ static struct {  /* table of asts read from mod file   */
   int sz;
 } astz;
 
-/* hash size is 1024 entries = 2^10, so HASHMASK has 10 lower-order bits on */
-#define ASTZHASHSIZE 1024
-#define ASTZHASHMASK 0x03ff
-static int astzhash[ASTZHASHSIZE];
-
 static struct {/* table of stds read from file */
   STDITEM *base;
   int avl;
@@ -277,10 +272,23 @@ static SYMITEM *symbol_list; /* list of symbols read from mod file  */
 static ALNITEM *align_list;  /* list of align descrs read from mod file */
 static DSTITEM *dist_list;   /* list of dist descrs read from mod file */
 
-#define SYMHASHSIZE 521
-static SYMITEM *symhash[SYMHASHSIZE];
-#define DTHASHSIZE 521
-static int dthash[DTHASHSIZE];
+/* The symbol, data type and ast numbers in a module file are those of the
+ * compilation that wrote it, and are dense.  These tables map them directly
+ * to what was read; 'hi' is the highest number set by the current import,
+ * so that only that much has to be cleared for the next one.
+ */
+static struct {
+  SYMITEM **base; /* old symbol -> its item */
+  int sz, hi;
+} symx;
+static struct {
+  int *base; /* old data type -> 1 + its index in dtz, or 0 */
+  int sz, hi;
+} dtx;
+static struct {
+  int *base; /* old ast -> 1 + its index in astz, or 0 */
+  int sz, hi;
+} astx;
 
 #define BUFF_LEN 4096
 static char *buff = NULL;
@@ -361,6 +369,111 @@ import_fini(void)
   imported_modules.size = 0;
 } /* import_fini */
 
+/* Module files are opened again for every program unit that uses them and
+ * for every nested USE that names them.  Keep the text of each one read by
+ * this compilation, and serve later opens from memory for as long as the
+ * file's inode, size and modification time are unchanged.  The time is
+ * compared to the nanosecond where stat reports it, so that a module file
+ * rewritten within the same second is not mistaken for the one already read.
+ */
+#if defined(__APPLE__)
+#define MTIME_NSEC(st) ((long)(st).st_mtimespec.tv_nsec)
+#elif defined(__linux__) || defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200809L
+#define MTIME_NSEC(st) ((long)(st).st_mtim.tv_nsec)
+#else
+#define MTIME_NSEC(st) 0L
+#endif
+
+typedef struct modfile {
+  char *name;
+  char *text;
+  size_t len;
+#ifndef HOST_WIN
+  ino_t ino;
+  time_t mtime;
+  long mtime_nsec;
+#endif
+  struct modfile *next;
+} MODFILE;
+
+static MODFILE *modfile_list = NULL;
+
+/** \brief Open a module file for reading, from memory if it has already
+ * been read and has not changed since.
+ */
+FILE *
+open_module_file(const char *name)
+{
+#ifndef HOST_WIN
+  struct stat st;
+  MODFILE *mf;
+  FILE *fd;
+
+  if (stat(name, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0)
+    return fopen(name, "r");
+  for (mf = modfile_list; mf; mf = mf->next) {
+    if (strcmp(mf->name, name) == 0)
+      break;
+  }
+  if (mf && mf->text &&
+      (mf->len != (size_t)st.st_size || mf->ino != st.st_ino ||
+       mf->mtime != st.st_mtime || mf->mtime_nsec != MTIME_NSEC(st))) {
+    FREE(mf->text);
+    mf->text = NULL;
+  }
+  if (mf == NULL) {
+    NEW(mf, MODFILE, 1);
+    NEW(mf->name, char, strlen(name) + 1);
+    strcpy(mf->name, name);
+    mf->text = NULL;
+    mf->next = modfile_list;
+    modfile_list = mf;
+  }
+  if (mf->text == NULL) {
+    fd = fopen(name, "r");
+    if (fd == NULL)
+      return NULL;
+    NEW(mf->text, char, st.st_size);
+    if (fread(mf->text, 1, st.st_size, fd) != (size_t)st.st_size) {
+      /* changing under us; read it the ordinary way */
+      FREE(mf->text);
+      mf->text = NULL;
+      rewind(fd);
+      return fd;
+    }
+    fclose(fd);
+    mf->len = st.st_size;
+    mf->ino = st.st_ino;
+    mf->mtime = st.st_mtime;
+    mf->mtime_nsec = MTIME_NSEC(st);
+  }
+#if DEBUG
+  else if (DBGBIT(0, 0x10000))
+    fprintf(gbl.dbgfil, "Module file from memory: %s\n", name);
+#endif
+  fd = fmemopen(mf->text, mf->len, "r");
+  if (fd)
+    return fd;
+#endif
+  return fopen(name, "r");
+} /* open_module_file */
+
+/** \brief Forget the saved module file text; called before this compilation
+ * writes a module file, which may replace one already read.
+ */
+void
+forget_module_files(void)
+{
+  MODFILE *mf;
+
+  for (mf = modfile_list; mf; mf = mf->next) {
+    if (mf->text) {
+      FREE(mf->text);
+      mf->text = NULL;
+    }
+  }
+} /* forget_module_files */
+
 static void
 add_imported(int modulesym)
 {
@@ -1159,7 +1272,7 @@ do_nested_uses(WantPrivates wantPrivates)
     if (DBGBIT(0, 0x10000))
       fprintf(gbl.dbgfil, "Open nested module file: %s\n", il->fullfilename);
 #endif
-    fd = fopen(il->fullfilename, "r");
+    fd = open_module_file(il->fullfilename);
     if (fd == NULL) {
       error(4, 0, gbl.lineno, "Unable to open MODULE file", il->modulefilename);
       continue;
@@ -1220,7 +1333,7 @@ do_nested_uses(WantPrivates wantPrivates)
       if (DBGBIT(0, 0x10000))
         fprintf(gbl.dbgfil, "Do nested use: %s\n", il->fullfilename);
 #endif
-      fd = fopen(il->fullfilename, "r");
+      fd = open_module_file(il->fullfilename);
       if (fd == NULL)
         continue;
       module_sym = import_mk_newsym(il->modulename, ST_MODULE);
@@ -1783,61 +1896,66 @@ static int module_base = 0; /* base symbol for modules */
 static void
 inithash(void)
 {
-  int i;
-  for (i = 0; i < SYMHASHSIZE; ++i) {
-    symhash[i] = NULL;
-  }
-  for (i = 0; i < DTHASHSIZE; ++i) {
-    dthash[i] = 0;
-  }
+  if (symx.sz)
+    BZERO(symx.base, SYMITEM *, symx.hi + 1);
+  if (dtx.sz)
+    BZERO(dtx.base, int, dtx.hi + 1);
+  if (astx.sz)
+    BZERO(astx.base, int, astx.hi + 1);
+  symx.hi = dtx.hi = astx.hi = 0;
 } /* inithash */
 
 static void
 inserthash(int sptr, SYMITEM *ps)
 {
-  int h;
-  h = sptr % SYMHASHSIZE;
-  ps->hashnext = symhash[h];
-  symhash[h] = ps;
+  if (sptr < 0)
+    return;
+  NEEDB(sptr + 1, symx.base, SYMITEM *, symx.sz, sptr + symx.sz + 1024);
+  symx.base[sptr] = ps;
+  if (sptr > symx.hi)
+    symx.hi = sptr;
 } /* inserthash */
 
 static SYMITEM *
 findhash(int sptr)
 {
-  int h;
-  SYMITEM *ps;
-  h = sptr % SYMHASHSIZE;
-  for (ps = symhash[h]; ps; ps = ps->hashnext) {
-    if (ps->sptr == sptr)
-      return ps;
-  }
-  return NULL;
+  if (sptr < 0 || sptr >= symx.sz)
+    return NULL;
+  return symx.base[sptr];
 } /* findhash */
 
 static void
 insertdthash(int old_dt, int d)
 {
-  int h;
-  h = old_dt % DTHASHSIZE;
-  dtz.base[d].hashnext = dthash[h];
-  dthash[h] = d + 1; /* offset hash links by one, since zero is legal */
+  if (old_dt < 0)
+    return;
+  NEEDB(old_dt + 1, dtx.base, int, dtx.sz, old_dt + dtx.sz + 1024);
+  dtx.base[old_dt] = d + 1; /* offset by one, since zero is legal */
+  if (old_dt > dtx.hi)
+    dtx.hi = old_dt;
 } /* insertdthash */
 
 static DITEM *
 finddthash(int old_dt)
 {
-  int h;
   int d;
-  h = old_dt % SYMHASHSIZE;
-  for (d = dthash[h]; d; d = dtz.base[d - 1].hashnext) {
-    DITEM *pd;
-    pd = dtz.base + (d - 1);
-    if (pd->id == old_dt)
-      return pd;
-  }
-  return NULL;
+  if (old_dt < 0 || old_dt >= dtx.sz)
+    return NULL;
+  d = dtx.base[old_dt];
+  return d ? dtz.base + (d - 1) : NULL;
 } /* finddthash */
 
+static void
+insertasthash(int old_ast, int a)
+{
+  if (old_ast < 0)
+    return;
+  NEEDB(old_ast + 1, astx.base, int, astx.sz, old_ast + astx.sz + 1024);
+  astx.base[old_ast] = a; /* 1 + index into astz */
+  if (old_ast > astx.hi)
+    astx.hi = old_ast;
+} /* insertasthash */
+
 /*
  * \brief Adjust type code for IVSN < 34
  * had inserted TY_HALF and TY_HCMPLX
@@ -1939,7 +2057,6 @@ import(lzhandle *fdlz, WantPrivates wantPrivates, int ivsn)
   char module_name[MAXIDLEN + 1], rename_name[MAXIDLEN + 1],
       idname[MAXIDLEN + 1], scope_name[MAXIDLEN + 1];
   int module_sym, scope_sym, rename_sym, offset, scope_stype;
-  int hash;
   int first_ast;
   int currrout = 0;
 
@@ -1967,7 +2084,6 @@ import(lzhandle *fdlz, WantPrivates wantPrivates, int ivsn)
   astz.sz = 64;
   NEW(astz.base, ASTITEM, astz.sz);
   astz.avl = 0;
-  BZERO(astzhash, int, ASTZHASHSIZE);
 
   stdz.sz = 64;
   NEW(stdz.base, STDITEM, stdz.sz);
@@ -2059,9 +2175,7 @@ import(lzhandle *fdlz, WantPrivates wantPrivates, int ivsn)
         sptr = getsymbol(idname);
         pa->a.w4 = sptr;
       }
-      hash = pa->old_ast & ASTZHASHMASK;
-      pa->link = astzhash[hash];
-      astzhash[hash] = astz.avl;
+      insertasthash(pa->old_ast, astz.avl);
       if (!first_ast) {
         if (astb.firstuast == 12 && pa->old_ast < 12) {
           /* older versions of the compiler reserved ASTs numbered
@@ -3298,6 +3412,28 @@ get_num(int radix)
   chp = currp;
   while (*currp != ' ' && *currp != '\n' && *currp != '\0' && *currp != ':')
     currp++;
+  if (currp - chp <= 15 && (radix == 10 || radix == 16)) {
+    /* Nearly every number in a module file is short; convert those here
+     * rather than through the 64-bit routines.  A leading '-' or anything
+     * that is not a digit goes the long way.
+     */
+    char *p;
+    for (p = chp; p < currp; ++p) {
+      int d;
+      if (*p >= '0' && *p <= '9')
+        d = *p - '0';
+      else if (radix == 16 && *p >= 'a' && *p <= 'f')
+        d = *p - 'a' + 10;
+      else if (radix == 16 && *p >= 'A' && *p <= 'F')
+        d = *p - 'A' + 10;
+      else
+        break;
+      val = val * radix + d;
+    }
+    if (p == currp)
+      return val;
+    val = 0;
+  }
   /*
    * atoxi64  will 'fail' if it doesn't find a number in which case
    * num is not set; need to ensure that val remains 0.
@@ -4820,14 +4956,9 @@ static int
 new_ast(int old_ast)
 {
   ASTITEM *pa;
-  int hash, s;
+  int s;
 
-  hash = old_ast & ASTZHASHMASK;
-  for (s = astzhash[hash]; s; s = pa->link) {
-    pa = astz.base + (s - 1);
-    if (pa->old_ast == old_ast)
-      break;
-  }
+  s = old_ast >= 0 && old_ast < astx.sz ? astx.base[old_ast] : 0;
   if (!s) {
     if (old_ast < BASEast) {
       return old_ast;
@@ -4836,6 +4967,7 @@ new_ast(int old_ast)
     interr("incomplete interface file, missing AST", old_ast, 3);
     error(4, 0, gbl.lineno, "incomplete IPA file, missing AST ", "");
   }
+  pa = astz.base + (s - 1);
   if (pa->new_ast)
     return pa->new_ast;
   return fill_ast(pa);
@@ -64,6 +64,8 @@ void export_append_host_sym(int);
 void export_host_subprogram(FILE *, int, int, int, int);
 void export_module_subprogram(FILE *, int, int, int, int);
 int get_module_file_name(char *modulename, char *filename, int len);
+FILE *open_module_file(const char *name);
+void forget_module_files(void);
 
 /*  getitem area for USE statement temp storage; pick an area not used by
  *  semant.
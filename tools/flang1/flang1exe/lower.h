@@ -132,9 +132,17 @@
  *              pass elemental field for subprogram when emitting ST_ENTRY.
  *
  *              For ST_PROC, pass IS_PROC_PTR_IFACE flag.
+ *
+ * 21.1         -- 1.56
+ *              All of 1.55 +
+ *              write the ILMs as binary records (ILMB_OPNAME, ILMB_ILM).
  */
 #define VersionMajor 1
-#define VersionMinor 55
+#define VersionMinor 56
+
+/* tags of the binary records in the ILM section; see lowerilm.c */
+#define ILMB_OPNAME 1
+#define ILMB_ILM 2
 
 void lower(int);
 void lower_end_contains(void);
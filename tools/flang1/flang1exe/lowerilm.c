@@ -61,6 +61,138 @@ extern void setrefsymbol(int symbol);
 #undef USE_LARGE_SIZE
 #define USE_LARGE_SIZE
 
+/*
+ * The ILMs written by plower() are normally binary records rather than
+ * text lines, which saves the back end from parsing operation names and
+ * decimal numbers.  The other lines of the ILM section stay text.  A record
+ * is a tag byte followed by native 32-bit integers:
+ *   ILMB_OPNAME index length, then the 'length' characters of the name
+ *     of an operation, defining 'index' for the ILMB_ILM records that follow
+ *     in the same output file;
+ *   ILMB_ILM ilm-number operation-index n, then the n operand values, then
+ *     their n operand letters ('i', 's', 'l', 't' or 'n') as bytes.
+ * Text ILMs are written when the file is meant to be read (-q 47 or
+ * -x 50 0x10), when -x 50 0x80 is set, and for host subprograms, whose
+ * output lower_end_contains() copies line by line.
+ */
+static struct {
+  bool on;          /* writing binary ILM records for this subprogram */
+  int *val;         /* operands of the record being built */
+  char *letter;     /* and their letters */
+  int size, lsize;  /* allocated size of val and letter */
+  int avl;          /* number of operands */
+  int ilm, op;      /* ILM number and operation index of the record */
+  char **name;      /* operation names defined so far, by index */
+  int namesize, nameavl;
+  int *hash;        /* open hash table of 1 + index in name, or 0 */
+  int hashsize;
+} bilm;
+
+static int
+bilm_hashname(const char *name)
+{
+  unsigned h = 0;
+  while (*name)
+    h = h * 31 + (unsigned char)*name++;
+  return h & (bilm.hashsize - 1);
+} /* bilm_hashname */
+
+/* return the index of operation name 'op', defining it if it is new */
+static int
+bilm_opindex(const char *op)
+{
+  int h, x, len;
+
+  if (bilm.nameavl * 2 >= bilm.hashsize) {
+    /* (re)build the hash table at twice the size */
+    bilm.hashsize = bilm.hashsize ? bilm.hashsize * 2 : 2048;
+    if (bilm.hash)
+      FREE(bilm.hash);
+    NEW(bilm.hash, int, bilm.hashsize);
+    BZERO(bilm.hash, int, bilm.hashsize);
+    for (x = 0; x < bilm.nameavl; ++x) {
+      for (h = bilm_hashname(bilm.name[x]); bilm.hash[h];
+           h = (h + 1) & (bilm.hashsize - 1))
+        ;
+      bilm.hash[h] = x + 1;
+    }
+  }
+  for (h = bilm_hashname(op); bilm.hash[h]; h = (h + 1) & (bilm.hashsize - 1)) {
+    if (strcmp(bilm.name[bilm.hash[h] - 1], op) == 0)
+      return bilm.hash[h] - 1;
+  }
+  x = bilm.nameavl++;
+  NEED(bilm.nameavl, bilm.name, char *, bilm.namesize, bilm.namesize + 1024);
+  len = strlen(op);
+  NEW(bilm.name[x], char, len + 1);
+  strcpy(bilm.name[x], op);
+  bilm.hash[h] = x + 1;
+
+  fputc(ILMB_OPNAME, lower_ilm_file);
+  fwrite(&x, sizeof(int), 1, lower_ilm_file);
+  fwrite(&len, sizeof(int), 1, lower_ilm_file);
+  fwrite(op, 1, len, lower_ilm_file);
+  return x;
+} /* bilm_opindex */
+
+/* write the binary record built for the current ILM */
+static void
+bilm_flush(void)
+{
+  int hdr[3];
+
+  if (bilm.op < 0)
+    return;
+  hdr[0] = bilm.ilm;
+  hdr[1] = bilm.op;
+  hdr[2] = bilm.avl;
+  fputc(ILMB_ILM, lower_ilm_file);
+  fwrite(hdr, sizeof(int), 3, lower_ilm_file);
+  fwrite(bilm.val, sizeof(int), bilm.avl, lower_ilm_file);
+  fwrite(bilm.letter, 1, bilm.avl, lower_ilm_file);
+  bilm.op = -1;
+} /* bilm_flush */
+
+/* put out the start of an ILM: operation 'op' numbered 'ilm' */
+static void
+put_operation(int ilm, char *op)
+{
+  if (!bilm.on) {
+    fprintf(lower_ilm_file, "i%d: %s", ilm, op);
+    return;
+  }
+  bilm_flush();
+  bilm.op = bilm_opindex(op);
+  bilm.ilm = ilm;
+  bilm.avl = 0;
+} /* put_operation */
+
+/* put out an operand of the current ILM */
+static void
+put_operand(int letter, int d)
+{
+  if (!bilm.on) {
+    fprintf(lower_ilm_file, " %c%d", letter, d);
+    return;
+  }
+  NEED(bilm.avl + 1, bilm.val, int, bilm.size, bilm.size + 32);
+  NEED(bilm.avl + 1, bilm.letter, char, bilm.lsize, bilm.lsize + 32);
+  bilm.val[bilm.avl] = d;
+  bilm.letter[bilm.avl] = letter;
+  ++bilm.avl;
+} /* put_operand */
+
+/* end the current ILM */
+static void
+put_ilmend(void)
+{
+  if (!bilm.on) {
+    fprintf(lower_ilm_file, "\n");
+    return;
+  }
+  bilm_flush();
+} /* put_ilmend */
+
 void
 lower_ilm_header(void)
 {
@@ -71,6 +203,12 @@ lower_ilm_header(void)
   }
   fprintf(lower_ilm_file, "AST2ILM version %d/%d\n", VersionMajor,
           VersionMinor);
+  bilm.on = lowersym.lowerfile == gbl.outfil && !XBIT(50, 0x90) &&
+            !DBGBIT(47, 31) && !DBGBIT(47, 8);
+#ifdef TARGET_WIN
+  bilm.on = FALSE; /* the output file is opened in text mode */
+#endif
+  bilm.op = -1;
 
 } /* lower_ilm_header */
 
@@ -79,14 +217,17 @@ lower_ilm_finish(void)
 {
 #define LOWERBUFSIZ 10000
   char buffer[LOWERBUFSIZ];
+  size_t n;
   int nw;
+  if (bilm.on)
+    bilm_flush();
   fprintf(lower_ilm_file, "end\n");
   /* append ilm file to sym file */
   nw = fseek(lower_ilm_file, 0, SEEK_SET);
   if (nw == -1)
     perror("lower_ilm_finish - fseek on lower_ilm_file");
-  while (fgets(buffer, LOWERBUFSIZ, lower_ilm_file) != NULL) {
-    fputs(buffer, lowersym.lowerfile);
+  while ((n = fread(buffer, 1, LOWERBUFSIZ, lower_ilm_file)) > 0) {
+    fwrite(buffer, 1, n, lowersym.lowerfile);
   }
   fclose(lower_ilm_file);
   lower_ilm_file = NULL;
@@ -139,7 +280,7 @@ plower(char *fmt, ...)
       pcount = -1;
     }
     opcount = ++pcount;
-    fprintf(lower_ilm_file, "i%d: %s", opcount, op);
+    put_operation(opcount, op);
     if (op[0] == '-' && op[1] == '-' && op[2] != '-') {
       lerror("unsupported %s", op);
     }
@@ -162,7 +303,7 @@ plower(char *fmt, ...)
     } else if (chf == 'e') {
       /* end of statement, should be last */
       va_end(argptr);
-      fprintf(lower_ilm_file, "\n");
+      put_ilmend();
       return opcount;
     }
 
@@ -174,7 +315,7 @@ plower(char *fmt, ...)
         fprintf(lower_ilm_file, " i-%d", opcount - d);
       } else
 #endif
-        fprintf(lower_ilm_file, " i%d", d);
+        put_operand('i', d);
 #if DEBUG
       if (d <= 0 || d > pcount) {
         lerror("bad ilm link %d", d);
@@ -195,7 +336,7 @@ plower(char *fmt, ...)
         }
       } else
 #endif
-        fprintf(lower_ilm_file, " s%d", d);
+        put_operand('s', d);
 #if DEBUG
       if (d < 0 || d > stb.stg_avail) {
         lerror("bad sym link %d", d);
@@ -221,7 +362,7 @@ plower(char *fmt, ...)
         fprintf(lower_ilm_file, " %s", getprint(d));
       } else
 #endif
-        fprintf(lower_ilm_file, " s%d", d);
+        put_operand('s', d);
 #if DEBUG
       if (d <= 0 || d > stb.stg_avail) {
         lerror("bad sym link %d", d);
@@ -247,7 +388,7 @@ plower(char *fmt, ...)
         fprintf(lower_ilm_file, " s%d	;%s", d, getprint(d));
       } else
 #endif
-        fprintf(lower_ilm_file, " s%d", d);
+        put_operand('s', d);
 #if DEBUG
       if (d <= 0 || d > stb.stg_avail) {
         lerror("bad sym link %d", d);
@@ -270,7 +411,7 @@ plower(char *fmt, ...)
         fprintf(lower_ilm_file, " s%d	;%s", d, getprint(d));
       } else
 #endif
-        fprintf(lower_ilm_file, " s%d", d);
+        put_operand('s', d);
 #if DEBUG
       if (d <= 0 || d > stb.stg_avail) {
         lerror("bad sym link %d", d);
@@ -294,7 +435,7 @@ plower(char *fmt, ...)
       /* don't increment pcount */
       break;
     case 'l':
-      fprintf(lower_ilm_file, " l%d", d);
+      put_operand('l', d);
       ++pcount;
       break;
     case 'd':
@@ -314,7 +455,7 @@ plower(char *fmt, ...)
         fprintf(lower_ilm_file, " t%d", (int)DTY(d));
       } else
 #endif
-        fprintf(lower_ilm_file, " t%d", d);
+        put_operand('t', d);
       ++pcount;
       if (chf == 'd')
         lower_use_datatype(d, 1);
@@ -322,12 +463,12 @@ plower(char *fmt, ...)
         lower_use_datatype(d, 2);
       break;
     case 'n':
-      fprintf(lower_ilm_file, " n%d", d);
+      put_operand('n', d);
       ++pcount;
       break;
     case 'a':
     case 'A':
-      fprintf(lower_ilm_file, " i%d", d);
+      put_operand('i', d);
 #if DEBUG
       if (d <= 0 || d > pcount) {
         lerror("bad ilm link %d", d);
@@ -350,13 +491,13 @@ plower(char *fmt, ...)
         fprintf(lower_ilm_file, " t%d", (int)DTY(d));
       } else
 #endif
-        fprintf(lower_ilm_file, " t%d", d);
+        put_operand('t', d);
       ++pcount;
       break;
     }
   }
   va_end(argptr);
-  fprintf(lower_ilm_file, "\n");
+  put_ilmend();
   return opcount;
 } /* plower */
 
@@ -37,6 +37,7 @@
 #include "commopt.h"
 #include "scan.h"
 #include "hlvect.h"
+#include "phasetime.h"
 
 #define IPA_ENABLED                  0
 #define IPA_NO_ASM                   0
@@ -48,6 +49,7 @@
 /* static prototypes */
 
 static void reptime(void);
+static void phase_done(const char *);
 static void add_debuglist(char *phasearg, char *dumparg);
 static void do_debug(char *phase);
 static void cleanup(void);
@@ -189,6 +191,7 @@ main(int argc, char *argv[])
         dodebug = 0;
     }
 #endif
+    phasetime_routine_begin();
     reinit();
     errini();
     if (ipa_export_file && ipa_import_mode && gbl.func_count == 0) {
@@ -199,6 +202,7 @@ main(int argc, char *argv[])
       ipa_export_highpoint();
     }
     xtimes[0] += get_rutime();
+    phase_done("init");
     if (ipa_export_file && ipa_import_mode) {
       ipa_import();
       if (gbl.eof_flag & 2)
@@ -228,6 +232,7 @@ main(int argc, char *argv[])
     }
     TR1("- after semant");
     xtimes[1] += get_rutime();
+    phase_done("parser");
     DUMP("parser");
     if (gbl.rutype == RU_BDATA) {
       /* a module? */
@@ -296,6 +301,7 @@ main(int argc, char *argv[])
 
         TR(DNAME " BBLOCK begins\n");
         has_accel_code |= bblock();
+        phase_done("bblock");
         TR1("- after bblock");
         DUMP("bblock");
         if (flg.inliner) {
@@ -304,6 +310,7 @@ main(int argc, char *argv[])
           if (flg.x[29] == 0 || flg.x[29] == gbl.func_count)
 #endif
             inliner();
+          phase_done("inliner");
           DUMP("inliner");
           TR1("- after inliner");
         }
@@ -364,6 +371,7 @@ main(int argc, char *argv[])
         if (!XBIT(49, 1)) {
           TR(DNAME " TRANSFORMER begins\n");
           transform();
+          phase_done("transform");
           DUMP("transform");
           TR1("- after transform");
 
@@ -409,6 +417,7 @@ main(int argc, char *argv[])
 
           TR(DNAME " CONVERT_OUTPUT begins\n");
           convert_output();
+          phase_done("convert");
           TR1("- after convert_output");
           DUMP("convert-output");
         }
@@ -439,6 +448,7 @@ main(int argc, char *argv[])
         if (flg.opt >= 2 && !XBIT(47, 0x1000)) {
           TR(DNAME " OPTIMIZER begins\n");
           optimize(0);
+          phase_done("optimize");
           DUMP("optimize");
           TR1("- after optimize");
         }
@@ -490,6 +500,7 @@ main(int argc, char *argv[])
       }
       DUMP("before-output");
       lower(0);
+      phase_done("lower");
       if (gbl.internal == 1) {
         save_host_state(0x2 + (ipa_import_mode ? 0x20 : 0));
       }
@@ -512,9 +523,11 @@ main(int argc, char *argv[])
     if (flg.xref) {
       xref(); /* write cross reference map */
       xtimes[7] += get_rutime();
+      phase_done("xref");
     }
     skip_compile:
     (void)summary(FALSE, FALSE);
+    phasetime_routine_end(gbl.currsub ? SYMNAME(gbl.currsub) : "");
     errini();
 
     if (gbl.internal == 1) {
@@ -639,6 +652,7 @@ init(int argc, char *argv[])
   int val_follows;
   LOGICAL dbgflg;
   char *dbgfile = NULL;
+  char *time_report_file = NULL;
   LOGICAL errflg;
   FILE *fd;
   int exlib_flag = 0;
@@ -751,6 +765,9 @@ init(int argc, char *argv[])
   register_string_arg(arg_parser, "modexport", &modexport_val, NULL);
   register_string_arg(arg_parser, "modindex", &modindex_val, NULL);
   register_string_arg(arg_parser, "qfile", &dbgfile, NULL);
+  /* JSON compile time report */
+  register_string_arg(arg_parser, "ftime-report-json", &time_report_file,
+                      NULL);
 
   /* Optimization level */
   register_integer_arg(arg_parser, "opt", &(flg.opt), 1);
@@ -805,6 +822,7 @@ init(int argc, char *argv[])
 
   /* Set values form command line arguments */
   parse_arguments(arg_parser, argc, argv);
+  phasetime_init(time_report_file, "flang1");
 
   /* Direct debug output */
   if (was_value_set(arg_parser, &(flg.dbg)) ||
@@ -1266,6 +1284,17 @@ reptime(void)
   fprintf(stderr, "%s\n", buf);
 }
 
+/* Close a phase in the -ftime-report-json report, sampling the table
+ * sizes first. */
+static void
+phase_done(const char *name)
+{
+  phasetime_table("symbols", stb.stg_avail);
+  phasetime_table("asts", astb.stg_avail);
+  phasetime_table("stds", astb.std.stg_avail);
+  phasetime_phase(name);
+}
+
 static void
 datastructure_reinit(void)
 {
@@ -1421,6 +1450,7 @@ finish(void)
       fclose(fp);
   }
 
+  phasetime_fini();
   if (!flg.es) {
     reptime();
     maxfilsev = summary(TRUE, FALSE);
@@ -569,7 +569,7 @@ apply_use(MODULE_ID m_id)
 
   if (DBGBIT(0, 0x10000))
     fprintf(gbl.dbgfil, "Open module file: %s\n", use_file_name);
-  use_fd = fopen(use_file_name, "r");
+  use_fd = open_module_file(use_file_name);
   /* -M option:  Print list of include files to stdout */
   /* -MD option:  Print list of include files to file <program>.d */
   if (sem.which_pass == 0 && ((XBIT(123, 2) || XBIT(123, 8)))) {
@@ -636,10 +636,9 @@ apply_use(MODULE_ID m_id)
    
     /* mark syms that are not accessible based on the USE ONLY list */
     /* step2: reverse NOT_IN_USEONLYP flag to 0 for syms on the USE ONLY list*/
-    for (sptr = stb.firstusym; sptr < stb.stg_avail; ++sptr) {
-      if (sptr == newglobal && SCOPEG(sptr) == used->module)
-        NOT_IN_USEONLYP(sptr, 0);
-    }
+    if (newglobal >= stb.firstusym && newglobal < stb.stg_avail &&
+        SCOPEG(newglobal) == used->module)
+      NOT_IN_USEONLYP(newglobal, 0);
 
     if (newglobal > NOSYM) {
       /* look for generic with same name */
@@ -1992,6 +1991,7 @@ export_all(void)
   }
   convert_2dollar_signs_to_hyphen(t_nm);
   strcat(t_nm, MOD_SUFFIX);
+  forget_module_files();
   outfile = fopen(t_nm, "w+");
   if (outfile == NULL) {
     error(4, 0, gbl.lineno, "Unable to create MODULE file", t_nm);
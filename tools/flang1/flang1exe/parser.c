@@ -188,6 +188,7 @@ _parser(void)
   NEW(sst, SST, sst_size);
   if (sst == NULL)
     error(7, 4, 0, CNULL, CNULL);
+  BZERO(sst, SST, sst_size);
 
   /* set funcline to a best guess value in case profiling info is
      requested for an unnamed program */
@@ -364,6 +365,7 @@ _parser(void)
         sst = (SST *)sccrelal((char *)sst, ((BIGUINT64)((sst_size) * sizeof(SST))));
         assert(pstack != NULL, "parser:stack ovflw", stktop, 4);
         assert(sst != NULL, "parser:stack ovflw", stktop, 4);
+        BZERO(sst + sst_size - SST_SIZE, SST, SST_SIZE);
       }
       pstack[stktop] = nstate;
       SST_SYMP(&sst[stktop], ctknval);
@@ -166,10 +166,7 @@ semant3(int rednum, SST *top)
    *      <simple stmt> ::= <IO stmt>
    */
   case SIMPLE_STMT12:
-    if (flg.smp || flg.accmp) {
-      ast = begin_call(A_CALL, sym_mkfunc_nodesc("_mp_ecs_nest", DT_NONE), 0);
-      SST_ASTP(LHS, ast);
-    } else if (XBIT(125, 0x1)) {
+    if (flg.smp || flg.accmp || XBIT(125, 0x1)) {
       /*
        * unconditionally call the routine which marks the end
        * of an i/o critical section.  Note that conditional calls
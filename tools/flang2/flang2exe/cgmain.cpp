@@ -1534,6 +1534,7 @@ restartConcur:
   llvm_info.last_instr = NULL;
   llvm_info.curr_instr = NULL;
   Instructions = NULL;
+  llutil_begin_routine_nodes();
   /* Update symbol table before we process any routine arguments, this must be
    * called before ll_abi_for_func_sptr()
    */
@@ -1934,6 +1935,7 @@ restartConcur:
   build_unused_global_define_from_params();
 
 /* header already printed; now print global and static defines */
+  ll_write_time_begin();
   write_ftn_typedefs();
   write_global_and_static_defines();
 
@@ -1956,6 +1958,7 @@ restartConcur:
   ll_write_local_objects(llvm_file(), llvm_info.curr_func);
   /* Emit alloca for local equivalence, c.f. get_local_overlap_var(). */
   write_local_overlap();
+  ll_write_time_end();
 
   if (ENABLE_BLK_OPT)
     optimize_block(llvm_info.last_instr);
@@ -1989,7 +1992,9 @@ restartConcur:
   }
 
   /* print out the instructions */
+  ll_write_time_begin();
   write_instructions(current_module);
+  ll_write_time_end();
 
   finish_routine();
 
@@ -2010,6 +2015,12 @@ restartConcur:
   llvm_info.curr_func = NULL;
 
   assem_end();
+  /* the routine's INSTR_LIST, OPERAND and TMPS nodes are no longer needed */
+  llutil_free_routine_nodes();
+  Instructions = NULL;
+  llvm_info.last_instr = NULL;
+  llvm_info.curr_instr = NULL;
+  csedList = NULL;
   /* we need to set init_once to zero here because for cuda fortran combine with
    * acc - the constructors can be created without one after the other and
    * cg_llvm_end will not get call between those.  If init_once is not reset,
@@ -3645,8 +3656,7 @@ make_instr(LL_InstrName instr_name)
 {
   INSTR_LIST *iptr;
 
-  iptr = (INSTR_LIST *)getitem(LLVM_LONGTERM_AREA, sizeof(INSTR_LIST));
-  memset(iptr, 0, sizeof(INSTR_LIST));
+  iptr = (INSTR_LIST *)llutil_node_alloc(sizeof(INSTR_LIST));
   iptr->i_name = instr_name;
   if (flg.debug || XBIT(120, 0x1000)) {
     switch (instr_name) {
@@ -10308,8 +10318,7 @@ add_to_cselist(int ilix)
       return true;
     }
   }
-  csed = (CSED_ITEM *)getitem(LLVM_LONGTERM_AREA, sizeof(CSED_ITEM));
-  memset(csed, 0, sizeof(CSED_ITEM));
+  csed = (CSED_ITEM *)llutil_node_alloc(sizeof(CSED_ITEM));
   csed->ilix = ilix;
   csed->next = csedList;
   csedList = csed;
@@ -13677,6 +13686,7 @@ cg_llvm_init(void)
 void
 cg_llvm_end(void)
 {
+  ll_write_time_begin();
   write_function_attributes();
   ll_write_metadata(llvm_file(), cpu_llvm_module);
 #ifdef OMP_OFFLOAD_LLVM
@@ -13686,6 +13696,7 @@ cg_llvm_end(void)
     ll_write_metadata(gbl.ompaccfile, gpu_llvm_module);
   }
 #endif
+  ll_write_time_end();
 }
 
 /**
@@ -13700,12 +13711,14 @@ cg_llvm_fnend(void)
   if (!init_once) {
     cg_llvm_init();
   }
+  ll_write_time_begin();
   write_global_and_static_defines();
   write_ftn_typedefs();
   Globals = NULL;
 
   /* Note that this function is called for every routine.  */
   assem_end();
+  ll_write_time_end();
   init_once = false;
   llutil_struct_def_reset();
   ll_reset_module_types(cpu_llvm_module);
@@ -108,10 +108,30 @@ static void insert_argrsrv(ILI *);
 #define mk_prototype (SPTR) mk_prototype_llvm
 
 #define ILTABSZ 5
-#define ILHSHSZ 173
 #define MAXILIS 67108864
 
-static int ilhsh[ILTABSZ][ILHSHSZ];
+/* Shared ILI are found through an open-addressing table of (hash, ili)
+ * pairs kept apart from the ILI area, so that a probe touches the ILI
+ * itself only when the full hash matches.  The size is a power of two and
+ * the table is kept no more than half full; an ili of 0 marks an empty
+ * slot.
+ */
+typedef struct {
+  unsigned hash;
+  int ili;
+} ILHSH;
+
+static struct {
+  ILHSH *base;
+  unsigned size;
+  unsigned cnt;
+  /* statistics for DBGBIT(10, 8) */
+  unsigned long lookups;
+  unsigned long hits;
+  unsigned long probes;
+} ilhsh;
+
+#define ILHSH_INIT_SIZE 1024
 static bool safe_qjsr = false;
 
 #define GARB_UNREACHABLE 0
@@ -147,21 +167,16 @@ inline SPTR sptrGetILI(ILI *p) {
 void
 ili_init(void)
 {
-  int *p, cnt;
-  static int firstcall = 1;
-
   STG_ALLOC(ilib, 2048);
   STG_SET_FREELINK(ilib, ILI, hshlnk);
-  cnt = ILHSHSZ * ILTABSZ;
 
-  if (firstcall) {
-    firstcall = 0;
-  } else {
-    p = (int *)ilhsh;
-    do {
-      *p++ = 0;
-    } while (--cnt > 0);
+  if (ilhsh.base == NULL) {
+    ilhsh.size = ILHSH_INIT_SIZE;
+    NEW(ilhsh.base, ILHSH, ilhsh.size);
   }
+  BZERO(ilhsh.base, ILHSH, ilhsh.size);
+  ilhsh.cnt = 0;
+  ilhsh.lookups = ilhsh.hits = ilhsh.probes = 0;
   /* reserve ili index 1 to be the NULL ili.  done so that a traversal
    * which uses the ILI_VISIT field as a thread can use an ili (#1) to
    * terminate the threaded list
@@ -8745,6 +8760,44 @@ iadd_ovf(INT c1, INT c2, INT *r)
   return false;
 }
 
+/** \brief Hash an ili's opcode and operands */
+static unsigned
+ili_hash(ILI_OP opc, const int *opnd, int noprs)
+{
+  int i;
+  unsigned h = (unsigned)opc * 0x9e3779b1U;
+
+  for (i = 0; i < noprs; i++)
+    h = (h ^ (unsigned)opnd[i]) * 0x9e3779b1U;
+  return h ^ (h >> 16);
+}
+
+/** \brief Rebuild the ili hash table with \p size slots, keeping the
+ * entries that are still in use.
+ */
+static void
+ilhsh_rehash(unsigned size)
+{
+  ILHSH *old = ilhsh.base;
+  unsigned oldsize = ilhsh.size;
+  unsigned i, j;
+
+  NEW(ilhsh.base, ILHSH, size);
+  BZERO(ilhsh.base, ILHSH, size);
+  ilhsh.size = size;
+  ilhsh.cnt = 0;
+  for (i = 0; i < oldsize; i++) {
+    if (old[i].ili == 0)
+      continue;
+    for (j = old[i].hash & (size - 1); ilhsh.base[j].ili;
+         j = (j + 1) & (size - 1))
+      ;
+    ilhsh.base[j] = old[i];
+    ilhsh.cnt++;
+  }
+  FREE(old);
+}
+
 /**
  * \brief enter ili into ILI area by attempting to share
  */
@@ -8752,30 +8805,24 @@ static int
 get_ili(ILI *ilip)
 {
   int i, p;
-  int indx, tab;
+  unsigned h, indx, mask;
   ILI_OP opc = ilip->opc;
-  int val = opc;
   int noprs = ilis[opc].oprs;
 
-  /* compute the hash index for this ILI  */
-
-  for (i = 0; i < noprs; i++)
-    val ^= (ilip->opnd[i] >> (i * 4));
-  indx = val % ILHSHSZ;
-  /*
-   * calculate which hash table to use which is based on the number of
-   * operands
-   */
-
   assert(noprs <= ILTABSZ, "get_ili: noprs > ILTABSZ", opc, ERR_Severe);
-  tab = (noprs == 0) ? 0 : noprs - 1;
-  /* search the hash links for this ILI  */
 
-  for (p = ilhsh[tab][indx]; p != 0; p = ILI_HSHLNK(p)) {
-    if (opc == ILI_OPC(p)) {
+  /* search the hash table for this ILI; stop at the first empty slot */
+  h = ili_hash(opc, ilip->opnd, noprs);
+  mask = ilhsh.size - 1;
+  ilhsh.lookups++;
+  for (indx = h & mask; (p = ilhsh.base[indx].ili) != 0;
+       indx = (indx + 1) & mask) {
+    ilhsh.probes++;
+    if (ilhsh.base[indx].hash == h && opc == ILI_OPC(p)) {
       for (i = 1; i <= noprs; i++)
         if (ilip->opnd[i - 1] != ILI_OPND(p, i))
           goto next;
+      ilhsh.hits++;
       return p; /* F O U N D  */
     }
   next:;
@@ -8810,14 +8857,27 @@ get_ili(ILI *ilip)
   }
 #endif
 
-  ILI_HSHLNK(p) = ilhsh[tab][indx];
-  ilhsh[tab][indx] = p;
+  ilhsh.base[indx].hash = h;
+  ilhsh.base[indx].ili = p;
+  if (++ilhsh.cnt * 2 > ilhsh.size)
+    ilhsh_rehash(ilhsh.size * 2);
   /*
    * Initialize nonzero fields of the ili - (here and in new_ili()).
    */
   return p;
 }
 
+/** \brief Report the ili hash table statistics for this function */
+void
+ili_hash_stats(FILE *f)
+{
+  fprintf(f,
+          "ili hash: %lu lookups, %lu hits, %lu misses, %lu probes, "
+          "%u of %u slots in use\n",
+          ilhsh.lookups, ilhsh.hits, ilhsh.lookups - ilhsh.hits,
+          ilhsh.probes, ilhsh.cnt, ilhsh.size);
+}
+
 /* wrapper of new_ili for external reference. */
 
 int
@@ -8908,7 +8968,7 @@ sort_free_list(int head)
 void
 garbage_collect(void (*mark_function)(int))
 {
-  int i, j, p, q, t;
+  int i, j, q, t;
 
   /* first, go through and mark all the ili that are reachable from
    * the ILT.  Then, call mark_function to mark any ILI that may not
@@ -8928,31 +8988,20 @@ garbage_collect(void (*mark_function)(int))
 
   /* ILI #0, #1 is special */
   ILI_VISIT(0) = ILI_VISIT(1) = GARB_VISITED;
-  /* next, go through the hash chains and delete anything that wasn't
-   * marked reachable, putting the freed ili on the linked list.
+  /* next, go through the hash table and delete anything that wasn't
+   * marked reachable, putting the freed ili on the linked list.  The
+   * survivors are then rehashed so that no probe sequence is broken.
    */
-  for (i = 0; i < ILTABSZ; ++i)
-    for (j = 0; j < ILHSHSZ; ++j) {
-      q = 0;
-      for (p = ilhsh[i][j]; p != 0;) {
-        if (ILI_VISIT(p) == GARB_UNREACHABLE) {
-          /* unreachable */
-          if (q == 0)
-            ilhsh[i][j] = ILI_HSHLNK(p);
-          else
-            ILI_HSHLNK(q) = ILI_HSHLNK(p);
-          t = p;
-          p = ILI_HSHLNK(p);
-          STG_ADD_FREELIST(ilib, t);
-          ILI_OPCP(t, GARB_COLLECTED);
-          ILI_VISIT(t) = GARB_COLLECTED;
-        } else {
-          /* reachable */
-          q = p;
-          p = ILI_HSHLNK(p);
-        }
-      }
+  for (i = 0; i < (int)ilhsh.size; ++i) {
+    t = ilhsh.base[i].ili;
+    if (t != 0 && ILI_VISIT(t) == GARB_UNREACHABLE) {
+      ilhsh.base[i].ili = 0;
+      STG_ADD_FREELIST(ilib, t);
+      ILI_OPCP(t, GARB_COLLECTED);
+      ILI_VISIT(t) = GARB_COLLECTED;
     }
+  }
+  ilhsh_rehash(ilhsh.size);
   /* finally, go through all the ILI.  Those that have been collected
    * should be marked GARB_COLLECTED.  Those that are reachable should
    * be marked GARB_VISITED.  Those marked GARB_UNREACHABLE are
@@ -10542,24 +10591,21 @@ dmpili(void)
   for (i = 1; i < ilib.stg_avail; i++) {
     dump_ili(gbl.dbgfil, i);
   }
-  if (DBGBIT(10, 1))
-    for (i = 0; i < ILTABSZ; i++) {
-      fprintf(gbl.dbgfil, "\n\n***** ILI Hash Table%2d *****\n", i);
-      for (j = 0; j < ILHSHSZ; j++)
-        if ((opn = ilhsh[i][j]) != 0) {
+  if (DBGBIT(10, 1)) {
+    fprintf(gbl.dbgfil, "\n\n***** ILI Hash Table *****\n");
+    tmp = 0;
+    for (j = 0; j < (int)ilhsh.size; j++)
+      if ((opn = ilhsh.base[j].ili) != 0) {
+        fprintf(gbl.dbgfil, " %5d.%-5u", j, opn);
+        if ((++tmp) == 6) {
           tmp = 0;
-          fprintf(gbl.dbgfil, "%3d.", j);
-          for (; opn != 0; opn = ILI_HSHLNK(opn)) {
-            fprintf(gbl.dbgfil, " %5u^", opn);
-            if ((++tmp) == 6) {
-              tmp = 0;
-              fprintf(gbl.dbgfil, "\n    ");
-            }
-          }
-          if (tmp != 0)
-            fprintf(gbl.dbgfil, "\n");
+          fprintf(gbl.dbgfil, "\n");
         }
-    }
+      }
+    if (tmp != 0)
+      fprintf(gbl.dbgfil, "\n");
+    ili_hash_stats(gbl.dbgfil);
+  }
 }
 
 #if DEBUG
@@ -600,6 +600,11 @@ void garbage_collect(void (*mark_function)(int));
  */
 void ili_cleanup(void);
 
+/**
+   \brief Print the ili hash table statistics for the current function
+ */
+void ili_hash_stats(FILE *f);
+
 /**
    \brief ...
  */
@@ -32,35 +32,54 @@ get_llvm_version(void)
   return flg.x[249] ? ((LL_IRVersion)flg.x[249]) : LL_Version_3_2;
 }
 
+/* Module objects live until the module is destroyed, so they are carved out
+   of large blocks rather than malloc'd one at a time. */
+#define LL_MANAGED_BLOCK (64 * 1024)
+#define LL_MANAGED_ALIGN(n) (((n) + 15) & ~(size_t)15)
+#define LL_MANAGED_HDR LL_MANAGED_ALIGN(sizeof(LL_ManagedMallocs))
+
 static void *
-ll_manage_mem(LLVMModuleRef module, void *space)
+ll_manage_malloc(LLVMModuleRef module, size_t malloc_size)
 {
-  struct LL_ManagedMallocs_ *mem =
-      (struct LL_ManagedMallocs_ *)malloc(sizeof(struct LL_ManagedMallocs_));
-  mem->storage = space;
-  mem->next = module->first_malloc;
-  module->first_malloc = mem;
+  LL_ManagedMallocs *blk = module->first_malloc;
+  size_t size = LL_MANAGED_ALIGN(malloc_size);
+  char *space;
+
+  if (blk == NULL || blk->used + size > blk->size) {
+    const size_t bsize =
+        size > LL_MANAGED_BLOCK / 4 ? size : (size_t)LL_MANAGED_BLOCK;
+    LL_ManagedMallocs *nblk =
+        (LL_ManagedMallocs *)malloc(LL_MANAGED_HDR + bsize);
+    nblk->size = bsize;
+    nblk->used = 0;
+    if (blk != NULL && bsize != LL_MANAGED_BLOCK) {
+      /* Oversized request: keep filling the current block afterwards. */
+      nblk->next = blk->next;
+      blk->next = nblk;
+    } else {
+      nblk->next = blk;
+      module->first_malloc = nblk;
+    }
+    blk = nblk;
+  }
+  space = (char *)blk + LL_MANAGED_HDR + blk->used;
+  blk->used += size;
   return space;
 }
 
-static const char *
-ll_manage_strdup(LLVMModuleRef module, const char *str)
-{
-  return (const char *)ll_manage_mem(module, strdup(str));
-}
-
 static void *
 ll_manage_calloc(LLVMModuleRef module, size_t members, size_t member_size)
 {
-  void *space = calloc(members, member_size);
-  return ll_manage_mem(module, space);
+  void *space = ll_manage_malloc(module, members * member_size);
+  memset(space, 0, members * member_size);
+  return space;
 }
 
-static void *
-ll_manage_malloc(LLVMModuleRef module, size_t malloc_size)
+static const char *
+ll_manage_strdup(LLVMModuleRef module, const char *str)
 {
-  void *space = malloc(malloc_size);
-  return ll_manage_mem(module, space);
+  size_t len = strlen(str) + 1;
+  return (const char *)memcpy(ll_manage_malloc(module, len), str, len);
 }
 
 static void
@@ -130,7 +149,6 @@ ll_destroy_function(struct LL_Function_ *function)
 void
 ll_destroy_mem(struct LL_ManagedMallocs_ *current)
 {
-  free(current->storage);
   free(current);
 }
 
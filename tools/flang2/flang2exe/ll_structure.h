@@ -845,9 +845,13 @@ typedef struct LL_Symbols_ {
   unsigned int num_values;
 } LL_Symbols;
 
+/* A block of the bump allocator that owns a module's types, values and
+   strings.  The storage follows the header; blocks are freed with the
+   module. */
 typedef struct LL_ManagedMallocs_ {
-  void *storage;
   struct LL_ManagedMallocs_ *next;
+  size_t size; /**< bytes of storage in this block */
+  size_t used; /**< bytes handed out so far */
 } LL_ManagedMallocs;
 
 typedef struct LL_Instruction_ {
@@ -1410,7 +1414,7 @@ void ll_create_sym(struct LL_Symbols_ *symbol_table, int index,
 void ll_destroy_function(LL_Function *function);
 
 /**
-   \brief ...
+   \brief Free one block of a module's managed storage
  */
 void ll_destroy_mem(struct LL_ManagedMallocs_ *current);
 
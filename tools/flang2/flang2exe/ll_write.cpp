@@ -16,6 +16,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
+#include <time.h>
 
 #ifdef TARGET_LLVM_ARM64
 #include "cgllvm.h"
@@ -653,17 +654,17 @@ ll_write_instruction(FILE *out, LL_Instruction *inst, LL_Module *module, int no_
     break;
   }
   if (!LL_MDREF_IS_NULL(inst->dbg_line_op)) {
-    fprintf(out, ", !dbg !%u", LL_MDREF_value(inst->dbg_line_op));
+    ll_puts(out, ", !dbg !");
+    ll_putu(out, LL_MDREF_value(inst->dbg_line_op));
   }
 #if DEBUG
   if (inst->comment)
     fprintf(out, " ; %s", inst->comment);
 #endif
 
-  fputc('\n', out);
+  ll_putc(out, '\n');
   if (print_branch_target)
     fprintf(out, "%s:\n", inst->operands[2]->data);
-  fflush(out);
 }
 
 /**
@@ -681,7 +682,8 @@ ll_write_object_dbg_references(FILE *out, LL_Module *m, LL_ObjToDbgList *ods)
     return;
   for (llObjtodbgFirst(ods, &i); !llObjtodbgAtEnd(&i); llObjtodbgNext(&i)) {
     LL_MDRef mdnode = llObjtodbgGet(&i);
-    fprintf(out, ", !dbg !%u", LL_MDREF_value(mdnode));
+    ll_puts(out, ", !dbg !");
+    ll_putu(out, LL_MDREF_value(mdnode));
   }
   llObjtodbgFree(ods);
 }
@@ -692,8 +694,10 @@ ll_write_basicblock(FILE *out, LL_Function *function, LL_BasicBlock *block,
 {
   LL_Instruction *inst = block->first;
 
-  if (block->name)
-    fprintf(out, "%s:\n", block->name);
+  if (block->name) {
+    ll_puts(out, block->name);
+    ll_puts(out, ":\n");
+  }
 
   if (block == function->first)
     ll_write_local_objects(out, function);
@@ -818,27 +822,27 @@ ll_write_function(FILE *out, LL_Function *function, LL_Module *module, bool no_r
           function->calling_convention, function->return_type->str);
   fprintf(out, "@%s%s(", prefix, function->name);
   for (i = 0; i < function->num_args; i++) {
-    fputs(function->arguments[i]->type_struct->str, out);
+    ll_puts(out, function->arguments[i]->type_struct->str);
 
     if (function->arguments[i]->flags & VAL_IS_NOALIAS_PARAM) {
-      fputs(" noalias", out);
+      ll_puts(out, " noalias");
     }
 
-    fputc(' ', out);
-    fputs(function->arguments[i]->data, out);
+    ll_putc(out, ' ');
+    ll_puts(out, function->arguments[i]->data);
     if (i + 1 < function->num_args)
-      fputs(", ", out);
+      ll_puts(out, ", ");
   }
-  fputs(") nounwind ", out);
+  ll_puts(out, ") nounwind ");
   if (no_return)
-    fputs("noreturn ", out);
-  fputs("{\n", out);
+    ll_puts(out, "noreturn ");
+  ll_puts(out, "{\n");
 
   while (block) {
     ll_write_basicblock(out, function, block, module, no_return);
     block = block->next;
   }
-  fputs("}\n\n", out);
+  ll_puts(out, "}\n\n");
 }
 
 void
@@ -1508,36 +1512,43 @@ write_mdref(FILE *out, LL_Module *module, LL_MDRef rmdref,
 
   switch (LL_MDREF_kind(mdref)) {
   case MDRef_Node:
-    if (LL_MDREF_value(mdref))
-      fprintf(out, "%s!%u", tag, LL_MDREF_value(mdref));
-    else
-      fprintf(out, "null");
+    if (LL_MDREF_value(mdref)) {
+      ll_puts(out, tag);
+      ll_putc(out, '!');
+      ll_putu(out, LL_MDREF_value(mdref));
+    } else {
+      ll_puts(out, "null");
+    }
     break;
 
   case MDRef_String:
     assert(LL_MDREF_value(mdref) < module->mdstrings_count, "Bad string MDRef",
            LL_MDREF_value(mdref), ERR_Fatal);
-    fprintf(out, "%s%s", tag, module->mdstrings[LL_MDREF_value(mdref)]);
+    ll_puts(out, tag);
+    ll_puts(out, module->mdstrings[LL_MDREF_value(mdref)]);
     break;
 
   case MDRef_Constant:
     assert(LL_MDREF_value(mdref) < module->constants_count,
            "Bad constant MDRef", LL_MDREF_value(mdref), ERR_Fatal);
-    fprintf(out, "%s %s",
-            module->constants[LL_MDREF_value(mdref)]->type_struct->str,
-            module->constants[LL_MDREF_value(mdref)]->data);
+    ll_puts(out, module->constants[LL_MDREF_value(mdref)]->type_struct->str);
+    ll_putc(out, ' ');
+    ll_puts(out, module->constants[LL_MDREF_value(mdref)]->data);
     break;
 
   case MDRef_SmallInt1:
-    fprintf(out, "i1 %u", LL_MDREF_value(mdref));
+    ll_puts(out, "i1 ");
+    ll_putu(out, LL_MDREF_value(mdref));
     break;
 
   case MDRef_SmallInt32:
-    fprintf(out, "i32 %u", LL_MDREF_value(mdref));
+    ll_puts(out, "i32 ");
+    ll_putu(out, LL_MDREF_value(mdref));
     break;
 
   case MDRef_SmallInt64:
-    fprintf(out, "i64 %u", LL_MDREF_value(mdref));
+    ll_puts(out, "i64 ");
+    ll_putu(out, LL_MDREF_value(mdref));
     break;
 
   default:
@@ -1575,6 +1586,14 @@ dwarf_emission_name(int value)
    The formatting is guided by the field type from the MDTemplate, and the
    MDRef types are validated.
  */
+static void
+write_mdfield_name(FILE *out, const char *prefix, const MDTemplate *tmpl)
+{
+  ll_puts(out, prefix);
+  ll_puts(out, tmpl->name);
+  ll_puts(out, ": ");
+}
+
 static int
 write_mdfield(FILE *out, LL_Module *module, int needs_comma, LL_MDRef mdref,
               const MDTemplate *tmpl)
@@ -1591,9 +1610,12 @@ write_mdfield(FILE *out, LL_Module *module, int needs_comma, LL_MDRef mdref,
     if (value) {
       assert(tmpl->type == NodeField || tmpl->type == SignedOrMDField,
              "metadata elem should not be a mdnode", tmpl->type, ERR_Fatal);
-      fprintf(out, "%s%s: !%u", prefix, tmpl->name, value);
+      write_mdfield_name(out, prefix, tmpl);
+      ll_putc(out, '!');
+      ll_putu(out, value);
     } else if (mandatory) {
-      fprintf(out, "%s%s: null", prefix, tmpl->name);
+      write_mdfield_name(out, prefix, tmpl);
+      ll_puts(out, "null");
     } else {
       return false;
     }
@@ -1607,7 +1629,8 @@ write_mdfield(FILE *out, LL_Module *module, int needs_comma, LL_MDRef mdref,
     if (!mandatory && strcmp(module->mdstrings[value], "!\"\"") == 0)
       return false;
     /* The mdstrings[] entry is formatted as !"...". String the leading !. */
-    fprintf(out, "%s%s: %s", prefix, tmpl->name, module->mdstrings[value] + 1);
+    write_mdfield_name(out, prefix, tmpl);
+    ll_puts(out, module->mdstrings[value] + 1);
     break;
 
   case MDRef_Constant:
@@ -1615,9 +1638,10 @@ write_mdfield(FILE *out, LL_Module *module, int needs_comma, LL_MDRef mdref,
            ERR_Fatal);
     switch (tmpl->type) {
     case ValueField:
-      fprintf(out, "%s%s: %s %s", prefix, tmpl->name,
-              module->constants[value]->type_struct->str,
-              module->constants[value]->data);
+      write_mdfield_name(out, prefix, tmpl);
+      ll_puts(out, module->constants[value]->type_struct->str);
+      ll_putc(out, ' ');
+      ll_puts(out, module->constants[value]->data);
       break;
 
 #ifdef HOST_WIN
@@ -1635,8 +1659,8 @@ write_mdfield(FILE *out, LL_Module *module, int needs_comma, LL_MDRef mdref,
           fprintf(out, "%s%s: %llu", prefix, tmpl->name, intval);
         }
       } else {
-        fprintf(out, "%s%s: %s", prefix, tmpl->name,
-                module->constants[value]->data);
+        write_mdfield_name(out, prefix, tmpl);
+        ll_puts(out, module->constants[value]->data);
       }
       break;
 
@@ -1652,7 +1676,8 @@ write_mdfield(FILE *out, LL_Module *module, int needs_comma, LL_MDRef mdref,
       }
       if (!doOutput)
         return false;
-      fprintf(out, "%s%s: %s", prefix, tmpl->name, dv);
+      write_mdfield_name(out, prefix, tmpl);
+      ll_puts(out, dv);
     } break;
 
     default:
@@ -1669,34 +1694,39 @@ write_mdfield(FILE *out, LL_Module *module, int needs_comma, LL_MDRef mdref,
     case UnsignedField:
     case SignedField:
     case SignedOrMDField:
-      fprintf(out, "%s%s: %u", prefix, tmpl->name, value);
+      write_mdfield_name(out, prefix, tmpl);
+      ll_putu(out, value);
       break;
 
     case BoolField:
       assert(value <= 1, "boolean value expected", value, ERR_Fatal);
-      fprintf(out, "%s%s: %s", prefix, tmpl->name, value ? "true" : "false");
+      write_mdfield_name(out, prefix, tmpl);
+      ll_puts(out, value ? "true" : "false");
       break;
 
     case DWTagField:
-      fprintf(out, "%s%s: %s", prefix, tmpl->name,
-              dwarf_tag_name(value & 0xffff));
+      write_mdfield_name(out, prefix, tmpl);
+      ll_puts(out, dwarf_tag_name(value & 0xffff));
       break;
 
     case DWLangField:
-      fprintf(out, "%s%s: %s", prefix, tmpl->name, dwarf_lang_name(value));
+      write_mdfield_name(out, prefix, tmpl);
+      ll_puts(out, dwarf_lang_name(value));
       break;
 
     case DWVirtualityField:
-      fprintf(out, "%s%s: %s", prefix, tmpl->name,
-              dwarf_virtuality_name(value));
+      write_mdfield_name(out, prefix, tmpl);
+      ll_puts(out, dwarf_virtuality_name(value));
       break;
 
     case DWEncodingField:
-      fprintf(out, "%s%s: %s", prefix, tmpl->name, dwarf_encoding_name(value));
+      write_mdfield_name(out, prefix, tmpl);
+      ll_puts(out, dwarf_encoding_name(value));
       break;
 
     case DWEmissionField:
-      fprintf(out, "%s%s: %s", prefix, tmpl->name, dwarf_emission_name(value));
+      write_mdfield_name(out, prefix, tmpl);
+      ll_puts(out, dwarf_emission_name(value));
       break;
 
     default:
@@ -1724,20 +1754,20 @@ write_mdnode_plain(FILE *out, LL_Module *module, const LL_MDNode *node,
   unsigned i;
 
   if (!omit_metadata_type)
-    fprintf(out, "metadata ");
+    ll_puts(out, "metadata ");
 
   if (ll_feature_use_distinct_metadata(&module->ir) && node->is_distinct)
-    fprintf(out, "distinct ");
+    ll_puts(out, "distinct ");
 
-  fprintf(out, "!{ ");
+  ll_puts(out, "!{ ");
   for (i = 0; i < node->num_elems; i++) {
     LL_MDRef mdref = LL_MDREF_INITIALIZER(0, 0);
     mdref = node->elem[i];
     if (i > 0)
-      fprintf(out, ", ");
+      ll_puts(out, ", ");
     write_mdref(out, module, mdref, omit_metadata_type);
   }
-  fprintf(out, " }\n");
+  ll_puts(out, " }\n");
 }
 
 /*
@@ -1755,16 +1785,18 @@ write_mdnode_spec(FILE *out, LL_Module *module, const LL_MDNode *node,
   int needs_comma = false;
 
   if (ll_feature_use_distinct_metadata(&module->ir) && node->is_distinct)
-    fprintf(out, "distinct ");
+    ll_puts(out, "distinct ");
 
   assert(node->num_elems <= num_fields, "metadata node has too many fields.",
          node->num_elems, ERR_Fatal);
 
-  fprintf(out, "!%s(", tmpl->name);
+  ll_putc(out, '!');
+  ll_puts(out, tmpl->name);
+  ll_putc(out, '(');
   for (i = 0; i < node->num_elems; i++)
     if (write_mdfield(out, module, needs_comma, node->elem[i], &tmpl[i + 1]))
       needs_comma = true;
-  fprintf(out, ")\n");
+  ll_puts(out, ")\n");
 }
 
 /**
@@ -1864,7 +1896,9 @@ static MDDispatch mdDispTable[LL_MDClass_MAX] = {
 INLINE static void
 emitRegularPrefix(FILE *out, unsigned mdi)
 {
-  fprintf(out, "!%u = ", mdi);
+  ll_putc(out, '!');
+  ll_putu(out, mdi);
+  ll_puts(out, " = ");
 }
 
 /** Simple helper function */
@@ -2457,6 +2491,7 @@ ll_write_module(FILE *out, LL_Module *module, int generate_no_return_variants, c
   LL_Function *function = module->first;
   int num_functions;
 
+  ll_write_time_begin();
   clear_prototypes();
 
   ll_write_module_header(out, module);
@@ -2575,4 +2610,30 @@ ll_write_module(FILE *out, LL_Module *module, int generate_no_return_variants, c
   }
   write_prototypes(out, module);
   ll_write_metadata(out, module);
+  ll_write_time_end();
+}
+
+/* CPU time spent writing IR text, and the nesting depth of the brackets */
+static clock_t llwrite_time;
+static clock_t llwrite_start;
+static int llwrite_depth;
+
+void
+ll_write_time_begin(void)
+{
+  if (llwrite_depth++ == 0)
+    llwrite_start = clock();
+}
+
+void
+ll_write_time_end(void)
+{
+  if (--llwrite_depth == 0)
+    llwrite_time += clock() - llwrite_start;
+}
+
+long
+ll_write_time_ms(void)
+{
+  return (long)(llwrite_time * 1000 / CLOCKS_PER_SEC);
 }
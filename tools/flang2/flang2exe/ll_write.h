@@ -9,8 +9,70 @@
 #define LL_WRITE_H_
 
 #include <stdio.h>
+#include <string.h>
 #include "ll_structure.h"
 
+/*
+ * Unformatted output for the IR writers.  The .ll file is only ever written
+ * from one thread, so on glibc the per-call stdio locking is skipped, and
+ * integers are converted here rather than through the printf machinery.
+ */
+#if defined(__GLIBC__)
+#define LL_FWRITE fwrite_unlocked
+#define LL_PUTC putc_unlocked
+#else
+#define LL_FWRITE fwrite
+#define LL_PUTC putc
+#endif
+
+/**
+   \brief Write the string \p s to \p out with no trailing newline
+ */
+inline void
+ll_puts(FILE *out, const char *s)
+{
+  LL_FWRITE(s, 1, strlen(s), out);
+}
+
+/**
+   \brief Write the single character \p c to \p out
+ */
+inline void
+ll_putc(FILE *out, int c)
+{
+  LL_PUTC(c, out);
+}
+
+/**
+   \brief Write \p val to \p out in decimal, as "%llu" would
+ */
+inline void
+ll_putu(FILE *out, unsigned long long val)
+{
+  char buf[24];
+  char *p = buf + sizeof(buf);
+
+  do {
+    *--p = '0' + (char)(val % 10);
+    val /= 10;
+  } while (val);
+  LL_FWRITE(p, 1, buf + sizeof(buf) - p, out);
+}
+
+/**
+   \brief Write \p val to \p out in decimal, as "%lld" would
+ */
+inline void
+ll_puti(FILE *out, long long val)
+{
+  if (val < 0) {
+    LL_PUTC('-', out);
+    ll_putu(out, 0ULL - (unsigned long long)val);
+  } else {
+    ll_putu(out, (unsigned long long)val);
+  }
+}
+
 /**
    \brief ...
  */
@@ -92,4 +154,21 @@ void write_mdref(FILE *out, LL_Module *module, LL_MDRef rmdref,
  */
 void ll_build_metadata_device(FILE *out, LLVMModuleRef module);
 
+/**
+   \brief Start charging CPU time to IR writing
+
+   Calls may nest; only the outermost begin/end pair is timed.
+ */
+void ll_write_time_begin(void);
+
+/**
+   \brief Stop charging CPU time to IR writing
+ */
+void ll_write_time_end(void);
+
+/**
+   \brief CPU time spent writing IR for the module so far, in milliseconds
+ */
+long ll_write_time_ms(void);
+
 #endif
@@ -1231,10 +1231,10 @@ write_consts(void)
       DTYPE dtype = DTYPEG(sptr);
       if (DTY(dtype) == TY_CHAR) {
         put_fstr(sptr, XBIT(124, 0x8000));
-        fputc('\n', ASMFIL);
+        ll_putc(ASMFIL, '\n');
       } else if (DTY(dtype) == TY_NCHAR) {
         put_kstr(sptr, XBIT(124, 0x8000));
-        fputc('\n', ASMFIL);
+        ll_putc(ASMFIL, '\n');
       } else if (DTY(dtype) != TY_PTR) {
         const char *tyName = char_type(dtype, sptr);        
         if (OMPACCRTG(sptr)) {
@@ -1245,12 +1245,15 @@ write_consts(void)
             fprintf(ASMFIL, "@%s = global %s ", getsname(sptr),
                     tyName);
           } else {
-            fprintf(ASMFIL, "@%s = internal constant %s ", getsname(sptr),
-                    tyName);
+            ll_putc(ASMFIL, '@');
+            ll_puts(ASMFIL, getsname(sptr));
+            ll_puts(ASMFIL, " = internal constant ");
+            ll_puts(ASMFIL, tyName);
+            ll_putc(ASMFIL, ' ');
           }
           write_constant_value(sptr, 0, CONVAL1G(sptr), CONVAL2G(sptr), false);
         }
-        fputc('\n', ASMFIL);
+        ll_putc(ASMFIL, '\n');
       }
     }
     if (flg.smp || XBIT(34, 0x200 || gbl.usekmpc)) {
@@ -3010,13 +3013,13 @@ put_fstr(SPTR sptr, int add_null)
 #ifdef HOLLG
   if (HOLLG(sptr)) {
     while (len) {
-      fputc(',', ASMFIL);
+      ll_putc(ASMFIL, ',');
       put_string_n("               ", 1, 0);
       --len;
     }
   }
 #endif
-  fputc(']', ASMFIL);
+  ll_putc(ASMFIL, ']');
 }
 
 static void
@@ -3043,11 +3046,12 @@ put_kstr(SPTR sptr, int add_null)
     p += bytes;
     len -= bytes;
 
-    fprintf(ASMFIL, "i16 %d", val);
+    ll_puts(ASMFIL, "i16 ");
+    ll_puti(ASMFIL, val);
     if (len)
-      fprintf(ASMFIL, ",");
+      ll_putc(ASMFIL, ',');
   }
-  fputc(']', ASMFIL);
+  ll_putc(ASMFIL, ']');
 }
 
 /* from scc assem.c : */
@@ -22,6 +22,7 @@
 #include "cgmain.h"
 #include "cg.h"
 #include "llassem.h"
+#include "ll_write.h"
 
 union {
   unsigned short i8;
@@ -106,10 +107,10 @@ put_next_member(char *ptr)
   if (*ptr == ',')
     ptr++;
   while (*ptr != ',' && *ptr != '\0') {
-    fprintf(ASMFIL, "%c", *ptr);
+    ll_putc(ASMFIL, *ptr);
     ptr++;
   }
-  fprintf(ASMFIL, " ");
+  ll_putc(ASMFIL, ' ');
   return ptr;
 }
 
@@ -122,20 +123,20 @@ put_skip(ISZ_T old, ISZ_T New)
     INT i;
     i = amt;
     while (i > 32) {
-      fprintf(ASMFIL, "i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 "
+      ll_puts(ASMFIL, "i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 "
                       "0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 "
                       "0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0");
       i -= 32;
       if (i)
-        fprintf(ASMFIL, ",");
+        ll_putc(ASMFIL, ',');
     }
     if (i) {
       while (1) {
-        fprintf(ASMFIL, "i8 0");
+        ll_puts(ASMFIL, "i8 0");
         i--;
         if (i == 0)
           break;
-        fprintf(ASMFIL, ",");
+        ll_putc(ASMFIL, ',');
       }
     }
   } else {
@@ -705,9 +706,11 @@ put_string_n(char *p, ISZ_T len, int size)
   n = 0;
   while (len--) {
     ch = *p;
-    fprintf(ASMFIL, "%s %u", ptrch, ch & 0xff);
+    ll_puts(ASMFIL, ptrch);
+    ll_putc(ASMFIL, ' ');
+    ll_putu(ASMFIL, ch & 0xff);
     if (len)
-      fprintf(ASMFIL, ",");
+      ll_putc(ASMFIL, ',');
     ++p;
     ++n;
   }
@@ -751,20 +754,20 @@ put_zeroes(ISZ_T len)
   ISZ_T i;
   i = len;
   while (i > 32) {
-    fprintf(ASMFIL, "i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 "
+    ll_puts(ASMFIL, "i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 "
                     "0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 "
                     "0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0");
     i -= 32;
     if (i)
-      fprintf(ASMFIL, ",");
+      ll_putc(ASMFIL, ',');
   }
   if (i) {
     while (1) {
-      fprintf(ASMFIL, "i8 0");
+      ll_puts(ASMFIL, "i8 0");
       i--;
       if (i == 0)
         break;
-      fprintf(ASMFIL, ",");
+      ll_putc(ASMFIL, ',');
     }
   }
 }
@@ -776,11 +779,13 @@ put_zeroes_bytype(ISZ_T len, char *ttype, char *initval)
   i = len;
   if (i) {
     while (1) {
-      fprintf(ASMFIL, "%s %s", ttype, initval);
+      ll_puts(ASMFIL, ttype);
+      ll_putc(ASMFIL, ' ');
+      ll_puts(ASMFIL, initval);
       i--;
       if (i == 0)
         break;
-      fprintf(ASMFIL, ",");
+      ll_putc(ASMFIL, ',');
     }
   }
 }
@@ -790,7 +795,8 @@ put_i8(int val)
 {
   int i;
   i8bit.i8 = (short)val;
-  fprintf(ASMFIL, "i8 %u", i8bit.byte[0] & 0xff);
+  ll_puts(ASMFIL, "i8 ");
+  ll_putu(ASMFIL, i8bit.byte[0] & 0xff);
 }
 
 /* write:  i8 x1, i8 x2 */
@@ -800,9 +806,10 @@ put_i16(int val)
   int i;
   i16bit.i16 = val;
   for (i = 0; i < 2; i++) {
-    fprintf(ASMFIL, "i8 %u", i16bit.byte[i] & 0xff);
+    ll_puts(ASMFIL, "i8 ");
+    ll_putu(ASMFIL, i16bit.byte[i] & 0xff);
     if (i < 1)
-      fprintf(ASMFIL, ",");
+      ll_putc(ASMFIL, ',');
   }
 }
 
@@ -813,16 +820,18 @@ put_i32(int val)
   int i;
   i32bit.i32 = val;
   for (i = 0; i < 4; i++) {
-    fprintf(ASMFIL, "i8 %u", i32bit.byte[i] & 0xff);
+    ll_puts(ASMFIL, "i8 ");
+    ll_putu(ASMFIL, i32bit.byte[i] & 0xff);
     if (i < 3)
-      fprintf(ASMFIL, ", ");
+      ll_puts(ASMFIL, ", ");
   }
 }
 
 void
 put_short(int val)
 {
-  fprintf(ASMFIL, "i16 %u", val);
+  ll_puts(ASMFIL, "i16 ");
+  ll_putu(ASMFIL, (unsigned)val);
 }
 
 static void
@@ -834,13 +843,15 @@ put_int(INT val)
 void
 put_int4(int val)
 {
-  fprintf(ASMFIL, "i32 %u", val);
+  ll_puts(ASMFIL, "i32 ");
+  ll_putu(ASMFIL, (unsigned)val);
 }
 
 static void
 put_int8(INT val)
 {
-  fprintf(ASMFIL, "i64 %lu", (unsigned long)val);
+  ll_puts(ASMFIL, "i64 ");
+  ll_putu(ASMFIL, (unsigned long)val);
 }
 
 /* write:  i8 0x?, i8 0x?, i8 0x?, i8 0x? */
@@ -850,9 +861,10 @@ put_r4(INT val)
   int i;
   i32bit.i32 = val;
   for (i = 0; i < 4; i++) {
-    fprintf(ASMFIL, "i8 %u", i32bit.byte[i] & 0xff);
+    ll_puts(ASMFIL, "i8 ");
+    ll_putu(ASMFIL, i32bit.byte[i] & 0xff);
     if (i < 3)
-      fprintf(ASMFIL, ",");
+      ll_putc(ASMFIL, ',');
   }
 }
 
@@ -176,13 +176,38 @@ llutil_strdup(const char *str)
   return strcpy(p, str);
 }
 
+/* getitem() area used for IR nodes; LLVM_FUNCTION_AREA while a routine is
+ * being translated. */
+static int node_area = LLVM_LONGTERM_AREA;
+
+void *
+llutil_node_alloc(INT size)
+{
+  char *p = (char *)getitem(node_area, size);
+  memset(p, 0, size);
+  return p;
+}
+
+void
+llutil_begin_routine_nodes(void)
+{
+  node_area = LLVM_FUNCTION_AREA;
+}
+
+void
+llutil_free_routine_nodes(void)
+{
+  freearea(LLVM_FUNCTION_AREA);
+  node_area = LLVM_LONGTERM_AREA;
+}
+
 /**
    \brief allocate a new \c TMPS structure
  */
 TMPS *
 make_tmps(void)
 {
-  return (TMPS *)llutil_alloc(sizeof(TMPS));
+  return (TMPS *)llutil_node_alloc(sizeof(TMPS));
 }
 
 void
@@ -1695,7 +1720,7 @@ make_label_op(SPTR sptr)
 OPERAND *
 make_operand(void)
 {
-  OPERAND *op = (OPERAND *)llutil_alloc(sizeof(OPERAND));
+  OPERAND *op = (OPERAND *)llutil_node_alloc(sizeof(OPERAND));
   return op;
 }
 
@@ -1766,7 +1791,7 @@ print_space(int num)
   int i;
 
   for (i = 0; i < num; i++)
-    fputc(' ', LLVMFIL);
+    ll_putc(LLVMFIL, ' ');
 }
 
 void
@@ -1785,9 +1810,8 @@ void
 print_line(char *ln)
 {
   if (ln != NULL)
-    fprintf(LLVMFIL, "%s\n", ln);
-  else
-    fprintf(LLVMFIL, "\n");
+    ll_puts(LLVMFIL, ln);
+  ll_putc(LLVMFIL, '\n');
 }
 
 /**
@@ -1815,7 +1839,7 @@ void
 print_token(const char *tk)
 {
   assert(tk, "print_token(): missing token", 0, ERR_Fatal);
-  fprintf(LLVMFIL, "%s", tk);
+  ll_puts(LLVMFIL, tk);
 }
 
 /**
@@ -1834,7 +1858,7 @@ print_token_tobuf(char *tk, char *buf)
 void
 print_nl(void)
 {
-  fprintf(LLVMFIL, "\n");
+  ll_putc(LLVMFIL, '\n');
 }
 
 void
@@ -1851,9 +1875,8 @@ print_nl_tobuf(char *buf)
 void
 print_dbg_line_no_comma(LL_MDRef md)
 {
-  char buf[32];
-  snprintf(buf, 32, " !dbg !%u", LL_MDREF_value(md));
-  print_token(buf);
+  ll_puts(LLVMFIL, " !dbg !");
+  ll_putu(LLVMFIL, LL_MDREF_value(md));
 }
 
 void
@@ -1888,13 +1911,13 @@ write_vconstant_value(int sptr, LL_Type *type, unsigned long long undef_bitmask)
 
   edtype = CONVAL1G(sptr);
 
-  fputc('<', LLVMFIL);
+  ll_putc(LLVMFIL, '<');
 
   for (i = 0; i < vsize; i++) {
     if (i)
-      fputs(", ", LLVMFIL);
+      ll_puts(LLVMFIL, ", ");
     write_type(vtype);
-    fputc(' ', LLVMFIL);
+    ll_putc(LLVMFIL, ' ');
 
     if (undef_bitmask & 1) {
       print_token("undef");
@@ -1921,7 +1944,7 @@ write_vconstant_value(int sptr, LL_Type *type, unsigned long long undef_bitmask)
       write_constant_value(0, vtype, VCON_CONVAL(edtype + i), 0, false);
     }
   }
-  fputc('>', LLVMFIL);
+  ll_putc(LLVMFIL, '>');
 }
 
 /**
@@ -1957,13 +1980,12 @@ write_constant_value(int sptr, LL_Type *type, INT conval0, INT conval1,
     if (sptr && DTY(DTYPEG(sptr)) == TY_CHAR) {
       int len = type->sub_elements;
       char *p;
-      fprintf(LLVMFIL, "c\"");
+      ll_puts(LLVMFIL, "c\"");
 
       p = stb.n_base + CONVAL1G(sptr);
-      ;
       while (len--)
-        fprintf(LLVMFIL, "%c", *p++);
-      fprintf(LLVMFIL, "\"");
+        ll_putc(LLVMFIL, *p++);
+      ll_putc(LLVMFIL, '"');
       return;
     }
 
@@ -1979,12 +2001,13 @@ write_constant_value(int sptr, LL_Type *type, INT conval0, INT conval1,
         fprintf(LLVMFIL, "{");
       while (elems > 0) {
         if (sptr && DTY(DTYPEG(sptr)) == TY_NCHAR) {
-          fprintf(LLVMFIL, "%s ", ctype);
+          ll_puts(LLVMFIL, ctype);
+          ll_putc(LLVMFIL, ' ');
         }
         write_constant_value(0, type->sub_types[0], conval0, conval1, uns);
         elems--;
         if (elems > 0)
-          fprintf(LLVMFIL, ", ");
+          ll_puts(LLVMFIL, ", ");
       }
       if (sptr && DTY(DTYPEG(sptr)) == TY_NCHAR) {
         fprintf(LLVMFIL, "]");
@@ -2038,10 +2061,13 @@ write_constant_value(int sptr, LL_Type *type, INT conval0, INT conval1,
       num[0] = conval1;
     }
     if (ll_type_bytes(type) <= 4) {
-      fprintf(LLVMFIL, uns ? "%lu" : "%ld", (long)num[1]);
+      if (uns)
+        ll_putu(LLVMFIL, (unsigned long)(long)num[1]);
+      else
+        ll_puti(LLVMFIL, (long)num[1]);
     } else {
       ui64toax(num, b, 22, uns, 10);
-      fprintf(LLVMFIL, "%s", b);
+      ll_puts(LLVMFIL, b);
     }
     return;
 
@@ -2062,7 +2088,7 @@ write_constant_value(int sptr, LL_Type *type, INT conval0, INT conval1,
     else if (num[0] == 0x80000000 && num[1] == 0x00000000)
       sprintf(d, "-0.00000000e+00");
     /* remember to make room for /0 */
-    fprintf(LLVMFIL, "%s", d);
+    ll_puts(LLVMFIL, d);
     return;
 
   case LL_FLOAT:
@@ -2126,10 +2152,10 @@ write_constant_value(int sptr, LL_Type *type, INT conval0, INT conval1,
       num[0] = conval1;
     }
     if (num[0] == 0 && num[1] == 0) {
-      fprintf(LLVMFIL, "null");
+      ll_puts(LLVMFIL, "null");
     } else {
       ui64toax(num, b, 22, uns, 10);
-      fprintf(LLVMFIL, "%s", b);
+      ll_puts(LLVMFIL, b);
     }
     return;
   default:
@@ -16,6 +16,9 @@
 
 /** \brief need a getitem() area that can persist across routine compilation */
 #define LLVM_LONGTERM_AREA 25
+/** \brief getitem() area for one routine's instructions, operands and temps;
+    freed in bulk once the routine has been written out */
+#define LLVM_FUNCTION_AREA 26
 #define BITS_IN_BYTE 8
 
 /** \brief OPERAND flag values */
@@ -1042,6 +1045,24 @@ const char *get_ot_name(unsigned ot);
  */
 const char *llutil_strdup(const char *str);
 
+/**
+   \brief Allocate a zeroed IR node (instruction, operand, temp, ...)
+
+   Between llutil_begin_routine_nodes() and llutil_free_routine_nodes() the
+   node comes from LLVM_FUNCTION_AREA, otherwise from LLVM_LONGTERM_AREA.
+ */
+void *llutil_node_alloc(INT size);
+
+/**
+   \brief Start allocating IR nodes for the routine being translated
+ */
+void llutil_begin_routine_nodes(void);
+
+/**
+   \brief Release all IR nodes allocated for the current routine
+ */
+void llutil_free_routine_nodes(void);
+
 /**
    \brief ...
  */
@@ -31,12 +31,16 @@
 #include "llassem.h"
 #include "cgllvm.h"
 #include "outliner.h"
+#include "ll_write.h"
+#include "phasetime.h"
 #if !defined(TARGET_WIN)
 #include <unistd.h>
 #endif
 #include <time.h>
 #include "ilm.h"
 #include "ili.h"
+#include "ilt.h"
+#include "bih.h"
 #include "upper.h"
 #include "semant.h"
 #include "dwarf2.h"
@@ -64,6 +68,7 @@ extern int errno;
 /* contents of this file:  */
 
 static void reptime(void);
+static void phase_done(const char *);
 static void init(int, char *[]);
 static void reinit(void);
 
@@ -90,6 +95,8 @@ static char *who[] = {"init", "import",   "expand", "", "",
                       "",     "assemble", "xref",   ""};
 #define _N_WHO (sizeof(who) / sizeof(char *))
 static INT xtimes[_N_WHO];
+/* stdio buffer for the .ll file; the IR writers emit many short pieces */
+static char asmbuf[1 << 18];
 static char *cmdline = NULL;
 static char *ccff_filename = NULL;
 #include "ccffinfo.h"
@@ -120,8 +127,6 @@ static int ipa_import_mode = 0;
 #define NO_FLEXLM
 
 #if DEBUG
-#include "bih.h"
-#include "ilt.h"
 /** \brief Check line number, findex  after each various stages to make sure
  * they don't contain 0 as a line number, so that ccff_info don't get
  * linenumber as 0
@@ -184,7 +189,8 @@ process_input(char *argv0, bool *need_cuda_constructor)
     if (malloc_verify() != 1)
       interr("main: malloc_verify failsA", errno, ERR_Fatal);
 #endif
-    reinit();
+  reinit();
+  phasetime_routine_begin();
 
 
 #if DEBUG & sun
@@ -193,6 +199,7 @@ process_input(char *argv0, bool *need_cuda_constructor)
       interr("main: malloc_verify failsB", errno, ERR_Fatal);
 #endif
   xtimes[0] += get_rutime();
+  phase_done("init");
   /* don't increment if it is outlined function because it
    * uses STATICS/BSS from host routine.
    */
@@ -214,6 +221,7 @@ process_input(char *argv0, bool *need_cuda_constructor)
 
   is_constructor = gbl.cuda_constructor;
   xtimes[1] += get_rutime();
+  phase_done("upper");
   DUMP("upper");
 
   if (gbl.cuda_constructor) {
@@ -285,6 +293,7 @@ process_input(char *argv0, bool *need_cuda_constructor)
         TR("F90 EXPANDER begins\n");
 
         expand(); /* expand ILM's into ILI  */
+        phase_done("expand");
         DUMP("expand");
 #if DEBUG
         check_lineno("expand");
@@ -323,12 +332,18 @@ process_input(char *argv0, bool *need_cuda_constructor)
         DUMP("before-schedule");
         schedule();
         xtimes[5] += get_rutime();
+        phase_done("schedule");
         DUMP("schedule");
+#if DEBUG
+        if (DBGBIT(10, 8))
+          ili_hash_stats(gbl.dbgfil);
+#endif
       } /* CUDAG(GBL_CURRFUNC) & CUDA_HOST */
     }
     TR("F90 ASSEMBLER begins\n");
     assemble();
     xtimes[6] += get_rutime();
+    phase_done("assemble");
     upper_save_syminfo();
   }
   if (DBGBIT(5, 4))
@@ -358,9 +373,12 @@ process_input(char *argv0, bool *need_cuda_constructor)
   if (flg.xref) {
     xref(); /* write cross reference map */
     xtimes[7] += get_rutime();
+    phase_done("xref");
   }
   (void)summary(false, 0);
   cg_llvm_fnend();
+  phase_done("fnend");
+  phasetime_routine_end(gbl.currsub ? SYMNAME(gbl.currsub) : "");
   if (llProcessNextTmpfile()) {
     if (ll_reset_parfile())
       return true;
@@ -485,6 +503,15 @@ reptime()
     }
   }
 
+  if (ll_write_time_ms()) {
+    sprintf(buf, "    %-10.10s %15ld millisecs (IR text output)",
+            "ll_write", ll_write_time_ms());
+    if (flg.code || flg.list || flg.xref)
+      list_line(buf);
+    else if (gbl.dbgfil)
+      fprintf(gbl.dbgfil, "%s\n", buf);
+  }
+
   sprintf(buf, "    Total time %15d millisecs", total);
   if (flg.code || flg.list || flg.xref) {
     list_line(buf);
@@ -505,10 +532,27 @@ xbitcheck:
       fprintf(stderr, "%s\n", buf);
     }
   }
+  if (ll_write_time_ms()) {
+    sprintf(buf, "    %-10.10s %15ld millisecs (IR text output)",
+            "ll_write", ll_write_time_ms());
+    fprintf(stderr, "%s\n", buf);
+  }
   sprintf(buf, "    Total time %15d millisecs", total);
   fprintf(stderr, "%s\n", buf);
 }
 
+/* Close a phase in the -ftime-report-json report, sampling the table
+ * sizes first. */
+static void
+phase_done(const char *name)
+{
+  phasetime_table("symbols", stb.stg_avail);
+  phasetime_table("ili", ilib.stg_avail);
+  phasetime_table("ilt", iltb.stg_avail);
+  phasetime_table("bih", bihb.stg_avail);
+  phasetime_phase(name);
+}
+
 /** \brief Dump symbols
  *
  * Wrapper that takes no arguments
@@ -541,6 +585,7 @@ init(int argc, char *argv[])
   char *sourcefile;
   char *listfile;
   char *stboutfile;
+  char *time_report_file = NULL;
   char *cppfile;
   char *tempfile;
   char *asmfile;
@@ -675,9 +720,13 @@ init(int argc, char *argv[])
   flg.linker_directives = (char **)getitem(8, argc * sizeof(char *));
   register_string_list_arg(arg_parser, "linker", flg.linker_directives);
   register_string_arg(arg_parser, "target", &(flg.llvm_target_triple), NULL);
+  /* JSON compile time report */
+  register_string_arg(arg_parser, "ftime-report-json", &time_report_file,
+                      NULL);
 
   /* Run argument parser */
   parse_arguments(arg_parser, argc, argv);
+  phasetime_init(time_report_file, "flang2");
 
   /* Process debug output settings */
   if (was_value_set(arg_parser, &(flg.dbg)) ||
@@ -853,6 +902,7 @@ do_curr_file:
     }
     if ((gbl.asmfil = fopen(asmfile, "w")) == NULL)
       errfatal((error_code_t)9);
+    setvbuf(gbl.asmfil, asmbuf, _IOFBF, sizeof(asmbuf));
   } else /* do this for compilers which write asm code to stdout */
     gbl.asmfil = stdout;
 
@@ -944,6 +994,7 @@ finish()
 {
   int maxfilsev;
 
+  phasetime_fini();
   if (!flg.es) {
     reptime();
     maxfilsev = summary(true, 1);
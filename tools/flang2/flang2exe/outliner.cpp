@@ -41,6 +41,12 @@
 #include <io.h>
 #define ftruncate _chsize
 #endif
+#if defined(__GLIBC__)
+/* Keep the outlined-region ILMs in memory; see ll_open_parfiles(). */
+#define PARFILE_IN_MEMORY 1
+#include <string.h>
+#include <sys/types.h>
+#endif
 #if defined(OMP_OFFLOAD_LLVM) || defined(OMP_OFFLOAD_PGI)
 #include "ompaccel.h"
 #endif
@@ -57,8 +63,19 @@ FILE *par_file2 = NULL;
 FILE *par_curfile = NULL; /* current tempfile for ilm rewrite */
 
 static FILE *savedILMFil = NULL;
+#ifdef PARFILE_IN_MEMORY
+/* growable buffer behind an in-memory par_file stream */
+typedef struct {
+  char *base;
+  size_t size; /* allocated bytes */
+  size_t len;  /* bytes written */
+  size_t pos;  /* current offset */
+} PARBUF;
+static PARBUF parBuf1, parBuf2;
+#else
 static char parFileNm1[MAX_PARFILE_LEN]; /* temp ilms file: pgipar1XXXXXX */
 static char parFileNm2[MAX_PARFILE_LEN]; /* temp ilms file: pgipar2XXXXXX */
+#endif
 static bool hasILMRewrite;               /* if set, tempfile is not empty. */
 static bool isRewritingILM;              /* if set, write ilm to tempfile */
 static int funcCnt = 0;   /* keep track how many outlined region */
@@ -82,6 +99,7 @@ static void allocTaskdup(int);
 
 /* Forward decls */
 static void resetThreadprivate(void);
+static void par_truncate(FILE *);
 
 /* Check shall we eliminate outlined or not */
 static bool eliminate_outlining(ILM_OP opc);
@@ -889,7 +907,7 @@ ll_reset_parfile(void)
     set_ilmfile(par_file2);
     gbl.eof_flag = 0;
     par_curfile = par_file1;
-    ftruncate(fileno(par_file1), 0);
+    par_truncate(par_file1);
     hasILMRewrite = 0;
     (void)fseek(gbl.ilmfil, 0L, 0);
     (void)fseek(par_curfile, 0L, 0);
@@ -898,7 +916,7 @@ ll_reset_parfile(void)
     set_ilmfile(par_file1);
     gbl.eof_flag = 0;
     par_curfile = par_file2;
-    ftruncate(fileno(par_file2), 0);
+    par_truncate(par_file2);
     hasILMRewrite = 0;
     (void)fseek(gbl.ilmfil, 0L, 0);
     (void)fseek(par_curfile, 0L, 0);
@@ -906,8 +924,8 @@ ll_reset_parfile(void)
   case outliner_reset:
     if (orig_ilmfil)
       set_ilmfile(orig_ilmfil);
-    ftruncate(fileno(par_file1), 0);
-    ftruncate(fileno(par_file2), 0);
+    par_truncate(par_file1);
+    par_truncate(par_file2);
     (void)fseek(par_file1, 0L, 0);
     (void)fseek(par_file2, 0L, 0);
     par_curfile = par_file1;
@@ -936,7 +954,7 @@ ll_reset_parfile_(void)
       gbl.ilmfil = par_file2;
       gbl.eof_flag = 0;
       par_curfile = par_file1;
-      ftruncate(fileno(par_file1), 0);
+      par_truncate(par_file1);
       hasILMRewrite = 0;
       (void)fseek(gbl.ilmfil, 0L, 0);
       (void)fseek(par_curfile, 0L, 0);
@@ -945,7 +963,7 @@ ll_reset_parfile_(void)
       gbl.ilmfil = par_file1;
       gbl.eof_flag = 0;
       par_curfile = par_file2;
-      ftruncate(fileno(par_file2), 0);
+      par_truncate(par_file2);
       hasILMRewrite = 0;
       (void)fseek(gbl.ilmfil, 0L, 0);
       (void)fseek(par_curfile, 0L, 0);
@@ -963,8 +981,8 @@ ll_reset_parfile_(void)
   } else {
     if (orig_ilmfil)
       gbl.ilmfil = orig_ilmfil;
-    ftruncate(fileno(par_file1), 0);
-    ftruncate(fileno(par_file2), 0);
+    par_truncate(par_file1);
+    par_truncate(par_file2);
     (void)fseek(par_file1, 0L, 0);
     (void)fseek(par_file2, 0L, 0);
     par_curfile = par_file1;
@@ -1933,9 +1951,121 @@ llRestoreSavedILFil()
     gbl.ilmfil = savedILMFil;
 }
 
+#ifdef PARFILE_IN_MEMORY
+static ssize_t
+parbuf_read(void *cookie, char *buf, size_t size)
+{
+  PARBUF *pb = (PARBUF *)cookie;
+  size_t n = 0;
+
+  if (pb->pos < pb->len) {
+    n = pb->len - pb->pos;
+    if (n > size)
+      n = size;
+    memcpy(buf, pb->base + pb->pos, n);
+    pb->pos += n;
+  }
+  return n;
+}
+
+static ssize_t
+parbuf_write(void *cookie, const char *buf, size_t size)
+{
+  PARBUF *pb = (PARBUF *)cookie;
+  size_t end = pb->pos + size;
+
+  if (end > pb->size) {
+    size_t newsize = pb->size ? pb->size : 1 << 16;
+    while (newsize < end)
+      newsize *= 2;
+    pb->base = (char *)realloc(pb->base, newsize);
+    if (pb->base == NULL)
+      errfatal((error_code_t)7);
+    pb->size = newsize;
+  }
+  if (pb->pos > pb->len)
+    memset(pb->base + pb->len, 0, pb->pos - pb->len);
+  memcpy(pb->base + pb->pos, buf, size);
+  pb->pos = end;
+  if (end > pb->len)
+    pb->len = end;
+  return size;
+}
+
+static int
+parbuf_seek(void *cookie, off64_t *offset, int whence)
+{
+  PARBUF *pb = (PARBUF *)cookie;
+  off64_t base;
+
+  switch (whence) {
+  case SEEK_SET:
+    base = 0;
+    break;
+  case SEEK_CUR:
+    base = pb->pos;
+    break;
+  case SEEK_END:
+    base = pb->len;
+    break;
+  default:
+    return -1;
+  }
+  if (base + *offset < 0)
+    return -1;
+  pb->pos = base + *offset;
+  *offset = pb->pos;
+  return 0;
+}
+
+static int
+parbuf_close(void *cookie)
+{
+  PARBUF *pb = (PARBUF *)cookie;
+
+  free(pb->base);
+  pb->base = NULL;
+  pb->size = pb->len = pb->pos = 0;
+  return 0;
+}
+
+static FILE *
+parbuf_open(PARBUF *pb)
+{
+  cookie_io_functions_t io = {parbuf_read, parbuf_write, parbuf_seek,
+                              parbuf_close};
+  pb->base = NULL;
+  pb->size = pb->len = pb->pos = 0;
+  return fopencookie(pb, "w+", io);
+}
+#endif
+
+/* Discard the contents of a par_file; the caller rewinds it. */
+static void
+par_truncate(FILE *f)
+{
+#ifdef PARFILE_IN_MEMORY
+  PARBUF *pb = f == par_file1 ? &parBuf1 : &parBuf2;
+  /* push out anything still buffered before it is thrown away */
+  fflush(f);
+  pb->len = pb->pos = 0;
+#else
+  ftruncate(fileno(f), 0);
+#endif
+}
+
+/* Open the two streams which hold rewritten ILMs while regions are
+ * outlined.  With glibc they are growable memory buffers behind
+ * fopencookie(), so outlining never touches the filesystem; elsewhere
+ * they are temporary files.
+ */
 void
 ll_open_parfiles()
 {
+#ifdef PARFILE_IN_MEMORY
+  par_file1 = parbuf_open(&parBuf1);
+  par_file2 = parbuf_open(&parBuf2);
+#else
   strcpy(parFileNm1, "pgipar1XXXXXX");
   strcpy(parFileNm2, "pgipar2XXXXXX");
 #if defined(TARGET_WIN)
@@ -1951,6 +2081,7 @@ ll_open_parfiles()
   fd2 = mkstemp(parFileNm2);
   par_file1 = fdopen(fd1, "w+");
   par_file2 = fdopen(fd2, "w+");
+#endif
 #endif
   if (!par_file1)
     errfatal((error_code_t)4);
@@ -1962,10 +2093,17 @@ void
 ll_unlink_parfiles()
 {
   llRestoreSavedILFil();
+#ifdef PARFILE_IN_MEMORY
+  if (par_file1)
+    fclose(par_file1);
+  if (par_file2)
+    fclose(par_file2);
+#else
   if (par_file1)
     unlink(parFileNm1);
   if (par_file2)
     unlink(parFileNm2);
+#endif
   par_file1 = NULL;
   par_file2 = NULL;
 }
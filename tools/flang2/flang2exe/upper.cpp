@@ -40,6 +40,19 @@ static char *line = NULL;
 static int linelen = 0;
 static int pos;
 
+/* The binary ILM record last read by read_line(), which then sets line to
+ * "i"; see lowerilm.c in the front end for the layout */
+static struct {
+  bool rec;         /* line holds a binary ILM record */
+  int ilm, op, n;   /* ILM number, operation index and operand count */
+  int next;         /* next operand to be read */
+  int *val;         /* operand values */
+  char *letter;     /* operand letters */
+  int size, lsize;  /* allocated size of val and letter */
+  int *opmap;       /* operation index -> getoperation() result */
+  int opmapsize;
+} bilm;
+
 static int do_level = 0;
 static int in_array_ctor = 0;
 static int oprnd_cnt = 0;
@@ -1177,38 +1190,99 @@ upper_init(void)
 
 } /* upper_init */
 
+static int lookupoperation(const char *p);
+
+/* read the rest of an ILMB_OPNAME or ILMB_ILM record from 'file' */
+static bool
+read_bilm(FILE *file, int tag)
+{
+  int hdr[3], x;
+  char *name;
+
+  if (tag == ILMB_OPNAME) {
+    if (fread(hdr, sizeof(int), 2, file) != 2 || hdr[0] < 0 || hdr[1] < 0)
+      return false;
+    NEW(name, char, hdr[1] + 1);
+    if (fread(name, 1, hdr[1], file) != (size_t)hdr[1]) {
+      FREE(name);
+      return false;
+    }
+    name[hdr[1]] = '\0';
+    x = bilm.opmapsize;
+    NEED(hdr[0] + 1, bilm.opmap, int, bilm.opmapsize, hdr[0] + 1024);
+    for (; x < bilm.opmapsize; ++x)
+      bilm.opmap[x] = -5;
+    bilm.opmap[hdr[0]] = lookupoperation(name);
+    FREE(name);
+    return true;
+  }
+  if (fread(hdr, sizeof(int), 3, file) != 3 || hdr[1] < 0 ||
+      hdr[1] >= bilm.opmapsize || hdr[2] < 0)
+    return false;
+  bilm.ilm = hdr[0];
+  bilm.op = hdr[1];
+  bilm.n = hdr[2];
+  bilm.next = 0;
+  NEED(bilm.n, bilm.val, int, bilm.size, bilm.n + 32);
+  NEED(bilm.n, bilm.letter, char, bilm.lsize, bilm.n + 32);
+  return fread(bilm.val, sizeof(int), bilm.n, file) == (size_t)bilm.n &&
+         fread(bilm.letter, 1, bilm.n, file) == (size_t)bilm.n;
+} /* read_bilm */
+
 static int
 read_line(void)
 {
-  char *ret;
+  FILE *file;
   int i, ch;
+
+  if (linelen == 0) {
+    linelen = 4096;
+    line = (char *)malloc(linelen * sizeof(char));
+  }
+  file = STB_UPPER() ? gbl.stbfil : gbl.srcfil;
   i = 0;
   pos = 0;
-  while (1) {
-    if (STB_UPPER())
-      ch = fgetc(gbl.stbfil); /* fgetc() returns an int */
-    else
-      ch = fgetc(gbl.srcfil); /* fgetc() returns an int */
-    if (i >= linelen) {
-      if (linelen == 0) {
-        linelen = 4096;
-        line = (char *)malloc(linelen * sizeof(char));
-      } else {
-        linelen = linelen * 2;
-        line = (char*) realloc(line, linelen);
-      }
+  bilm.rec = false;
+  ++ilmlinenum;
+  ch = fgetc(file); /* fgetc() returns an int */
+  while (ch == ILMB_OPNAME || ch == ILMB_ILM) {
+    if (!read_bilm(file, ch)) {
+      fprintf(stderr, "ILM file line %d: truncated binary ILM record\n",
+              ilmlinenum);
+      ++errors;
+      line[0] = '\0';
+      return 1;
     }
-    if (ch == EOF || (char)ch == '\n') {
-      line[i] = '\0';
-      break;
+    if (ch == ILMB_ILM) {
+      bilm.rec = true;
+      line[0] = 'i';
+      line[1] = '\0';
+      return 0;
     }
-    line[i] = (char)ch;
-    ++i;
+    ch = fgetc(file);
   }
-
-  ++ilmlinenum;
-  if (ch == EOF && i == 0)
+  if (ch == EOF) {
+    line[0] = '\0';
     return 1;
+  }
+  if ((char)ch == '\n') {
+    line[0] = '\0';
+    return 0;
+  }
+  line[i++] = (char)ch;
+  /* read the rest of the line a buffer at a time */
+  while (fgets(line + i, linelen - i, file) != NULL) {
+    i += strlen(line + i);
+    if (i > 0 && line[i - 1] == '\n') {
+      line[--i] = '\0';
+      return 0;
+    }
+    if (i < linelen - 1)
+      break; /* end of file without a newline */
+    linelen = linelen * 2;
+    line = (char *)realloc(line, linelen);
+  }
+  line[i] = '\0';
   return 0;
 } /* read_line */
 
@@ -1253,6 +1327,10 @@ checkversion(char *text)
         cudaflags = 0;
         return;
       }
+      /* binary ILM records are new to 1.56; 1.55 files have none */
+      if (v2 == 55 && VersionMinor == 56) {
+        return;
+      }
     }
     fprintf(stderr,
             "ILM file version error\n"
@@ -4106,6 +4184,9 @@ getilm(void)
     return 0;
   }
 
+  if (bilm.rec)
+    return bilm.ilm;
+
   if (line[pos] != 'i') {
     fprintf(stderr,
             "ILM file line %d: expecting ilm number\n"
@@ -4136,29 +4217,39 @@ getoperand(const char *optype, char letter)
     return 0;
   }
 
-  skipwhitespace();
+  if (bilm.rec) {
+    if (bilm.next >= bilm.n || bilm.letter[bilm.next] != letter) {
+      fprintf(stderr, "ILM file line %d: expecting %s operand\n", ilmlinenum,
+              optype);
+      ++errors;
+      return 0;
+    }
+    val = bilm.val[bilm.next++];
+  } else {
+    skipwhitespace();
 
-  if (line[pos] != letter) {
-    fprintf(stderr,
-            "ILM file line %d: expecting %s operand\n"
-            "instead got: %s\n",
-            ilmlinenum, optype, line + pos);
-    ++errors;
-    return 0;
-  }
+    if (line[pos] != letter) {
+      fprintf(stderr,
+              "ILM file line %d: expecting %s operand\n"
+              "instead got: %s\n",
+              ilmlinenum, optype, line + pos);
+      ++errors;
+      return 0;
+    }
 
-  ++pos;
-  val = 0;
-  neg = 1;
-  if (line[pos] == '-') {
-    ++pos;
-    neg = -1;
-  }
-  while (line[pos] >= '0' && line[pos] <= '9') {
-    val = val * 10 + (line[pos] - '0');
     ++pos;
+    val = 0;
+    neg = 1;
+    if (line[pos] == '-') {
+      ++pos;
+      neg = -1;
+    }
+    while (line[pos] >= '0' && line[pos] <= '9') {
+      val = val * 10 + (line[pos] - '0');
+      ++pos;
+    }
+    val *= neg;
   }
-  val *= neg;
   switch (letter) {
   case chsym:
     if (val == 0)
@@ -4200,25 +4291,14 @@ getoperand(const char *optype, char letter)
   return 0;
 } /* getoperand */
 
+/* look up operation name p; return its index in info[], -1 for the end of
+ * a statement, -2 for an unimplemented operation, or -5 if unknown */
 static int
-getoperation(void)
+lookupoperation(const char *p)
 {
-  char ch;
-  char *p;
-  int len;
   int hi, lo;
 
-  if (endilmfile) {
-    fprintf(stderr, "ILM file: looking past end-of-file for operation\n");
-    ++errors;
-    return 0;
-  }
-
-  skipwhitespace();
-
   /* end of statement? */
-  p = line + pos;
-
   if (strncmp(p, "---", 3) == 0) {
     /* yes, simply return */
     return -1;
@@ -4230,15 +4310,6 @@ getoperation(void)
     return -2;
   }
 
-  ch = line[pos];
-  len = 0;
-  while ((ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z') ||
-         (ch >= '0' && ch <= '9') || (ch == '_')) {
-    ++pos;
-    ++len;
-    ch = line[pos];
-  }
-  line[pos] = '\0';
   /* binary search */
   hi = NUMOPERATIONS - 1;
   lo = 0;
@@ -4247,7 +4318,6 @@ getoperation(void)
     mid = (hi + lo) / 2;
     compare = strcmp(p, info[mid].name);
     if (compare == 0) {
-      line[pos] = ch;
       return mid;
     }
     if (compare < 0) {
@@ -4256,12 +4326,60 @@ getoperation(void)
       lo = mid + 1;
     }
   }
-  line[pos] = ch;
   fprintf(stderr, "ILM file line %d: unknown operation: %s\n", ilmlinenum, p);
-  ++errors;
   return -5;
+} /* lookupoperation */
+
+static int
+getoperation(void)
+{
+  char ch;
+  char *p;
+  int op;
+
+  if (endilmfile) {
+    fprintf(stderr, "ILM file: looking past end-of-file for operation\n");
+    ++errors;
+    return 0;
+  }
+
+  if (bilm.rec) {
+    op = bilm.opmap[bilm.op];
+    if (op == -5)
+      ++errors; /* reported when the name was read */
+    return op;
+  }
+
+  skipwhitespace();
+
+  p = line + pos;
+  if (strncmp(p, "--", 2) == 0)
+    return lookupoperation(p);
+
+  ch = line[pos];
+  while ((ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z') ||
+         (ch >= '0' && ch <= '9') || (ch == '_')) {
+    ++pos;
+    ch = line[pos];
+  }
+  line[pos] = '\0';
+  op = lookupoperation(p);
+  line[pos] = ch;
+  if (op == -5)
+    ++errors;
+  return op;
 } /* getoperation */
 
+/* return the letter of the next operand of the ILM, or '\0' at its end */
+static char
+nextoperand(void)
+{
+  if (bilm.rec)
+    return bilm.next < bilm.n ? bilm.letter[bilm.next] : '\0';
+  skipwhitespace();
+  return line[pos];
+} /* nextoperand */
+
 /* read one line from the ILM file */
 static void
 read_ilm(void)
@@ -4336,46 +4454,37 @@ read_ilm(void)
         ad1ilm(opnd);
         break;
       case pilms:
-        skipwhitespace();
-        while (line[pos] == chilm) {
+        while (nextoperand() == chilm) {
           ++origilmavl;
           opnd = getoperand("ilm", chilm);
           Trace((" %c%d", chilm, opnd));
           ad1ilm(opnd);
-          skipwhitespace();
         }
         break;
       case pargs:
-        skipwhitespace();
-        while (line[pos] == chilm) {
+        while (nextoperand() == chilm) {
           ++origilmavl;
           opnd = getoperand("ilm", chilm);
           Trace((" %c%d", chilm, opnd));
           ad1ilm(opnd);
-          skipwhitespace();
           opnd = getoperand("datatype", chdtype);
           /* ignore the datatype */
-          skipwhitespace();
         }
         break;
       case psyms:
-        skipwhitespace();
-        while (line[pos] == chsym) {
+        while (nextoperand() == chsym) {
           ++origilmavl;
           opnd = getoperand("symbol", chsym);
           Trace((" %c%d", chsym, opnd));
           ad1ilm(opnd);
-          skipwhitespace();
         }
         break;
       case pnums:
-        skipwhitespace();
-        while (line[pos] == chnum) {
+        while (nextoperand() == chnum) {
           ++origilmavl;
           opnd = getoperand("number", chnum);
           Trace((" %c%d", chnum, opnd));
           ad1ilm(opnd);
-          skipwhitespace();
         }
         break;
       default:
@@ -136,13 +136,21 @@
  *              pass elemental field for subprogram when emitting ST_ENTRY.
  *
  *              For ST_PROC, receive IS_PROC_PTR_IFACE flag.
+ *
+ * 21.1         -- 1.56
+ *              All of 1.55 +
+ *              read the ILMs as binary records (ILMB_OPNAME, ILMB_ILM).
  */
 
 #include "gbldefs.h"
 #include "semant.h"
 
 #define VersionMajor 1
-#define VersionMinor 55
+#define VersionMinor 56
+
+/* tags of the binary records in the ILM section; see read_line() */
+#define ILMB_OPNAME 1
+#define ILMB_ILM 2
 
 /**
    \brief ...
@@ -0,0 +1,253 @@
+/*
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+ * See https://llvm.org/LICENSE.txt for license information.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+/** \file
+ * \brief Per-phase compile time report, written as JSON.
+ *
+ * Routine records are written as each routine completes, so the report
+ * costs a fixed amount of memory however many routines the file holds.
+ * The layout is
+ *
+ *     { "compiler": ..., "routines": [ {routine}, ... ],
+ *       "wall_ms": ..., "cpu_ms": ..., "maxrss_kb": ...,
+ *       "phases": {...}, "tables": {...} }
+ *
+ * where each routine carries its own wall_ms, cpu_ms, maxrss_kb, phases
+ * and tables, and each phase is { "wall_ms", "cpu_ms", "maxrss_kb",
+ * "calls" }.
+ */
+
+#include "phasetime.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#ifndef HOST_WIN
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif
+
+#define PT_MAXPHASE 24
+#define PT_MAXTABLE 8
+
+typedef struct {
+  const char *name;
+  double wall, cpu; /* milliseconds */
+  long rss;         /* peak resident set size in KB at the end */
+  int calls;
+} PT_PHASE;
+
+typedef struct {
+  PT_PHASE phase[PT_MAXPHASE];
+  int nphase;
+  long table[PT_MAXTABLE];
+  double wall, cpu;
+  long rss;
+} PT_REC;
+
+static struct {
+  FILE *fil;
+  int nrou;
+  double wall0, cpu0;         /* at phasetime_init() */
+  double wall_last, cpu_last; /* at the previous mark */
+  const char *table_name[PT_MAXTABLE];
+  int ntable;
+  int in_routine;
+  PT_REC total, rou;
+} pt;
+
+static void
+pt_sample(double *wall, double *cpu, long *rss)
+{
+#ifndef HOST_WIN
+  struct timeval tv;
+  struct rusage ru;
+
+  gettimeofday(&tv, NULL);
+  *wall = tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+  getrusage(RUSAGE_SELF, &ru);
+  *cpu = (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000.0 +
+         (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1000.0;
+  *rss = ru.ru_maxrss;
+#else
+  *cpu = *wall = clock() * 1000.0 / CLOCKS_PER_SEC;
+  *rss = 0;
+#endif
+}
+
+static void
+pt_charge(PT_REC *rec, const char *name, double wall, double cpu, long rss)
+{
+  PT_PHASE *ph;
+  int i;
+
+  for (i = 0; i < rec->nphase; ++i) {
+    if (strcmp(rec->phase[i].name, name) == 0)
+      break;
+  }
+  if (i == rec->nphase) {
+    if (i == PT_MAXPHASE) {
+      /* fold the excess into the last slot */
+      i = PT_MAXPHASE - 1;
+      rec->phase[i].name = "other";
+    } else {
+      memset(&rec->phase[i], 0, sizeof(PT_PHASE));
+      rec->phase[i].name = name;
+      ++rec->nphase;
+    }
+  }
+  ph = &rec->phase[i];
+  ph->wall += wall;
+  ph->cpu += cpu;
+  ph->calls++;
+  if (rss > ph->rss)
+    ph->rss = rss;
+  rec->wall += wall;
+  rec->cpu += cpu;
+  if (rss > rec->rss)
+    rec->rss = rss;
+}
+
+static void
+pt_put_name(const char *s)
+{
+  putc('"', pt.fil);
+  for (; *s; ++s) {
+    if (*s == '"' || *s == '\\')
+      fprintf(pt.fil, "\\%c", *s);
+    else if ((unsigned char)*s < ' ')
+      fprintf(pt.fil, "\\u%04x", *s);
+    else
+      putc(*s, pt.fil);
+  }
+  putc('"', pt.fil);
+}
+
+static void
+pt_put_rec(const PT_REC *rec, const char *indent)
+{
+  int i;
+
+  fprintf(pt.fil, "%s\"wall_ms\": %.3f, \"cpu_ms\": %.3f, \"maxrss_kb\": %ld,\n",
+          indent, rec->wall, rec->cpu, rec->rss);
+  fprintf(pt.fil, "%s\"phases\": {", indent);
+  for (i = 0; i < rec->nphase; ++i) {
+    const PT_PHASE *ph = &rec->phase[i];
+    fprintf(pt.fil, "%s\n%s  ", i ? "," : "", indent);
+    pt_put_name(ph->name);
+    fprintf(pt.fil,
+            ": {\"wall_ms\": %.3f, \"cpu_ms\": %.3f, \"maxrss_kb\": %ld, "
+            "\"calls\": %d}",
+            ph->wall, ph->cpu, ph->rss, ph->calls);
+  }
+  fprintf(pt.fil, "},\n%s\"tables\": {", indent);
+  for (i = 0; i < pt.ntable; ++i) {
+    fprintf(pt.fil, "%s", i ? ", " : "");
+    pt_put_name(pt.table_name[i]);
+    fprintf(pt.fil, ": %ld", rec->table[i]);
+  }
+  fprintf(pt.fil, "}");
+}
+
+void
+phasetime_init(const char *filename, const char *compiler)
+{
+  long rss;
+
+  if (filename == NULL || pt.fil != NULL)
+    return;
+  pt.fil = fopen(filename, "w");
+  if (pt.fil == NULL) {
+    fprintf(stderr, "%s: cannot open time report file %s\n", compiler,
+            filename);
+    return;
+  }
+  pt_sample(&pt.wall0, &pt.cpu0, &rss);
+  pt.wall_last = pt.wall0;
+  pt.cpu_last = pt.cpu0;
+  fprintf(pt.fil, "{\n  \"compiler\": ");
+  pt_put_name(compiler);
+  fprintf(pt.fil, ",\n  \"routines\": [");
+}
+
+void
+phasetime_phase(const char *name)
+{
+  double wall, cpu;
+  long rss;
+
+  if (pt.fil == NULL)
+    return;
+  pt_sample(&wall, &cpu, &rss);
+  pt_charge(&pt.total, name, wall - pt.wall_last, cpu - pt.cpu_last, rss);
+  if (pt.in_routine)
+    pt_charge(&pt.rou, name, wall - pt.wall_last, cpu - pt.cpu_last, rss);
+  pt.wall_last = wall;
+  pt.cpu_last = cpu;
+}
+
+void
+phasetime_table(const char *name, long size)
+{
+  int i;
+
+  if (pt.fil == NULL)
+    return;
+  for (i = 0; i < pt.ntable; ++i) {
+    if (strcmp(pt.table_name[i], name) == 0)
+      break;
+  }
+  if (i == pt.ntable) {
+    if (i == PT_MAXTABLE)
+      return;
+    pt.table_name[pt.ntable++] = name;
+  }
+  if (size > pt.total.table[i])
+    pt.total.table[i] = size;
+  if (pt.in_routine && size > pt.rou.table[i])
+    pt.rou.table[i] = size;
+}
+
+void
+phasetime_routine_begin(void)
+{
+  if (pt.fil == NULL)
+    return;
+  memset(&pt.rou, 0, sizeof(pt.rou));
+  pt.in_routine = 1;
+}
+
+void
+phasetime_routine_end(const char *name)
+{
+  if (pt.fil == NULL || !pt.in_routine)
+    return;
+  fprintf(pt.fil, "%s\n    {\"name\": ", pt.nrou ? "," : "");
+  pt_put_name(name ? name : "");
+  fprintf(pt.fil, ",\n");
+  pt_put_rec(&pt.rou, "     ");
+  fprintf(pt.fil, "}");
+  ++pt.nrou;
+  pt.in_routine = 0;
+}
+
+void
+phasetime_fini(void)
+{
+  double wall, cpu;
+
+  if (pt.fil == NULL)
+    return;
+  pt_sample(&wall, &cpu, &pt.total.rss);
+  /* report the whole run, including time outside any marked phase */
+  pt.total.wall = wall - pt.wall0;
+  pt.total.cpu = cpu - pt.cpu0;
+  fprintf(pt.fil, "\n  ],\n");
+  pt_put_rec(&pt.total, "  ");
+  fprintf(pt.fil, "\n}\n");
+  fclose(pt.fil);
+  pt.fil = NULL;
+}
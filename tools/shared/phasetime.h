@@ -0,0 +1,55 @@
+/*
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+ * See https://llvm.org/LICENSE.txt for license information.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+#ifndef PHASETIME_H_
+#define PHASETIME_H_
+
+/** \file
+ * \brief Per-phase compile time report, written as JSON.
+ *
+ * The driver marks the end of each phase with phasetime_phase(); the
+ * wall and CPU time since the previous mark, and the peak resident set
+ * size, are charged to that phase both for the whole compilation and for
+ * the routine currently being compiled (between phasetime_routine_begin()
+ * and phasetime_routine_end()).  Table sizes are recorded as peaks with
+ * phasetime_table().  Nothing is measured unless phasetime_init() was
+ * given a file name.
+ */
+
+/**
+   \brief Start timing; the report is written to \p filename by
+   phasetime_fini().  A NULL \p filename leaves the report disabled.
+ */
+void phasetime_init(const char *filename, const char *compiler);
+
+/**
+   \brief Charge the time since the previous mark to phase \p name.
+ */
+void phasetime_phase(const char *name);
+
+/**
+   \brief Record \p size entries in table \p name if it is a new peak.
+ */
+void phasetime_table(const char *name, long size);
+
+/**
+   \brief Start collecting per-routine figures.
+ */
+void phasetime_routine_begin(void);
+
+/**
+   \brief Write the figures collected since phasetime_routine_begin()
+   for routine \p name.
+ */
+void phasetime_routine_end(const char *name);
+
+/**
+   \brief Write the compilation totals and close the report.
+ */
+void phasetime_fini(void);
+
+#endif // PHASETIME_H_